@@ -22,6 +22,16 @@ set xtics scale 0
 set output o_file 
 set ytics nomirror
 set terminal png size 1600,1200
-set title system(sprintf("head -1 \"%s\"",i_file))
 set xtics   ("NULL" 0, "COMPOUND" 1, "ILLEGAL" 2, "ACCESS" 3, "CLOSE" 4, "COMMIT" 5, "CREATE" 6, "DELEGPURGE" 7, "DELEGRETURN" 8, "GETATTR" 9, "GETFH" 10, "LINK" 11, "LOCK" 12, "LOCKT" 13, "LOCKU" 14, "LOOKUP" 15, "LOOKUPP" 16, "NVERIFY" 17, "OPEN" 18, "OPENATTR" 19, "OPEN_CONFIRM" 20, "OPEN_DOWNGRADE" 21, "PUTFH" 22, "PUTPUBFH" 23, "PUTROOTFH" 24, "READ" 25, "READDIR" 26, "READLINK" 27, "REMOVE" 28, "RENAME" 29, "RENEW" 30, "RESTOREFH" 31, "SAVEFH" 32, "SECINFO" 33, "SETATTR" 34, "SETCLIENTID" 35, "SETCLIENTID_CONFIRM" 36, "VERIFY" 37, "WRITE" 38, "RELEASE_LOCKOWNER" 39, "GET_DIR_DELEGATION" 40) rotate
-plot i_file every ::1 using 3 with boxes title "Requests per nfs-operation", i_file every::1 using :3:2 with labels notitle offset 0,0.5
+# i_file is either breakdown_<session>.dat or CSV written by output=PATH option,
+# session (and protocol) select rows of the CSV
+if(exists("session")) {
+    if(!exists("protocol")) { protocol = "NFS v4.0" }
+    row(column) = (strcol(1) eq session && strcol(2) eq protocol) ? column : 1/0
+    set datafile separator ","
+    set title session
+    plot i_file every ::1 using (row($3)):6 with boxes title "Requests per nfs-operation", i_file every ::1 using (row($3)):6:5 with labels notitle offset 0,0.5
+} else {
+    set title system(sprintf("head -1 \"%s\"",i_file))
+    plot i_file every ::1 using 3 with boxes title "Requests per nfs-operation", i_file every::1 using :3:2 with labels notitle offset 0,0.5
+}
@@ -29,6 +29,7 @@ OPTIONS:
    -a      Set path to the analyzer.
    -d      Directory contained i_files-files. Pattern: <analyzer>(.)*.dat
    -f      Use specific file as i_files-file.
+   -c      Use CSV file written by breakdown output=PATH option, graph per session.
    -p      Pattern used for file search.
    -r      Recursive search.
    -v      Verbose.
@@ -45,7 +46,7 @@ analyzer=
 directories=()
 i_files=()
 
-while getopts “ha:d:f:p:rv” option; do
+while getopts “ha:c:d:f:p:rv” option; do
     case "$option" in
         h)
             usage
@@ -65,6 +66,9 @@ while getopts “ha:d:f:p:rv” option; do
         f)
             i_files+=("$OPTARG")
             ;;
+        c)
+            csv_file="$OPTARG"
+            ;;
         p)
             pattern="$OPTARG"
             ;;
@@ -87,23 +91,35 @@ for directory in "${directories[@]}"; do
     done
 done
 
-if [[ -z "$analyzer" ]] || [[ -z "$i_files" ]] ; then
+if [[ -z "$analyzer" ]] || [[ -z "$i_files" && -z "$csv_file" ]] ; then
     usage
     exit 1
 fi
 
-OIFS="${IFS}"
-IFS=$'\n'
-for i_file in ${i_files[@]} ; do
-    o_file="${i_file/%$i_ext/$o_ext}"
-    gnuplot -e "i_file='$i_file';o_file='$o_file'" "$analyzer$e_ext" &>/dev/null
+plot()
+{
+    gnuplot -e "$1" "$analyzer$e_ext" &>/dev/null
     result=$?
     if [[ ! -z "$verbose" ]] ; then
-        echo "gnuplot -e \"i_file='$i_file';o_file='$o_file'\" $analyzer$e_ext"
+        echo "gnuplot -e \"$1\" $analyzer$e_ext"
         if [[ ! $result == 0 ]] ; then
-            echo "fail during $i_file processing (return: $result)" 1>&2
+            echo "fail during $2 processing (return: $result)" 1>&2
             exit 1
         fi
     fi
+}
+
+OIFS="${IFS}"
+IFS=$'\n'
+for i_file in ${i_files[@]} ; do
+    o_file="${i_file/%$i_ext/$o_ext}"
+    plot "i_file='$i_file';o_file='$o_file'" "$i_file"
 done
+
+if [[ ! -z "$csv_file" ]] ; then
+    for session in $(tail -n +2 "$csv_file" | cut -d , -f 1 | sort -u) ; do
+        o_file="$(dirname "$csv_file")/breakdown_${session//[^A-Za-z0-9._-]/_}$o_ext"
+        plot "i_file='$csv_file';session='$session';o_file='$o_file'" "$session"
+    done
+fi
 IFS="${OIFS}"
@@ -19,6 +19,13 @@
     along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
 */
 //------------------------------------------------------------------------------
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include <api/plugin_api.h>
 
 #include "cifsv1breakdownanalyzer.h"
@@ -35,6 +42,16 @@ using namespace NST::breakdown;
 class Analyzer : public CIFSBreakdownAnalyzer, public CIFSv2BreakdownAnalyzer, public NFSv3BreakdownAnalyzer, public NFSv4BreakdownAnalyzer, public NFSv41BreakdownAnalyzer
 {
 public:
+    Analyzer(SessionsFile* file, Dimensions rollups)
+        : CIFSBreakdownAnalyzer(std::cout, file, rollups)
+        , CIFSv2BreakdownAnalyzer(std::cout, file, rollups)
+        , NFSv3BreakdownAnalyzer(std::cout, file, rollups)
+        , NFSv4BreakdownAnalyzer(std::cout, file, rollups)
+        , NFSv41BreakdownAnalyzer(std::cout, file, rollups)
+        , sessions_file(file)
+    {
+    }
+
     void flush_statistics() override final
     {
         CIFSBreakdownAnalyzer::flush_statistics();
@@ -42,18 +59,84 @@ public:
         NFSv3BreakdownAnalyzer::flush_statistics();
         NFSv4BreakdownAnalyzer::flush_statistics();
         NFSv41BreakdownAnalyzer::flush_statistics();
+        if(sessions_file)
+        {
+            sessions_file->close();
+        }
     }
+
+    void on_unix_signal(int signo) override final
+    {
+        CIFSBreakdownAnalyzer::on_unix_signal(signo);
+        CIFSv2BreakdownAnalyzer::on_unix_signal(signo);
+        NFSv3BreakdownAnalyzer::on_unix_signal(signo);
+        NFSv4BreakdownAnalyzer::on_unix_signal(signo);
+        NFSv41BreakdownAnalyzer::on_unix_signal(signo);
+    }
+
+private:
+    std::unique_ptr<SessionsFile> sessions_file; // shared by protocols, nullptr if .dat per session are written
 };
 
+//! Procedures and commands are accounted by their headers, only NFSv4.x operations are decoded
+static AnalyzerSubscription subscription()
+{
+    AnalyzerSubscription subscription;
+    subscription.nfs3.reset();
+    subscription.smbv1.reset();
+    subscription.smbv2.reset();
+    subscription.nfs4.reset(ProcEnumNFS4::NFS_NULL).reset(ProcEnumNFS4::COMPOUND);
+    subscription.nfs41.reset(ProcEnumNFS41::NFS_NULL).reset(ProcEnumNFS41::COMPOUND);
+    subscription.bodies = false;
+    return subscription;
+}
+
 extern "C" {
 const char* usage()
 {
-    return "No options";
+    return "output - Path to CSV file with rows of all sessions instead of breakdown_<session>.dat files\n"
+           "rollup - Statistics of sessions aggregated by hosts: client, server or both (default), f.e. rollup=client:server";
 }
 
-IAnalyzer* create(const char*)
+IAnalyzer* create(const char* opts)
 {
-    return new Analyzer();
+    std::string output;
+    Dimensions  rollups;
+
+    enum
+    {
+        OUTPUT_SUBOPT_INDEX = 0,
+        ROLLUP_SUBOPT_INDEX
+    };
+    char        outputSubOptName[] = "output";
+    char        rollupSubOptName[] = "rollup";
+    char* const tokens[] =
+        {
+            outputSubOptName,
+            rollupSubOptName,
+            NULL};
+    std::size_t       optsLen = strlen(opts);
+    std::vector<char> optsBuf{opts, opts + optsLen + 2};
+    char*             optionp = &optsBuf[0];
+    char*             valuep;
+    int               optIndex;
+    while((optIndex = getsubopt(&optionp, tokens, &valuep)) >= 0)
+    {
+        switch(optIndex)
+        {
+        case OUTPUT_SUBOPT_INDEX:
+            if(valuep == nullptr || *valuep == '\0')
+            {
+                throw std::runtime_error{"Path is required for 'output' suboption"};
+            }
+            output = valuep;
+            break;
+        case ROLLUP_SUBOPT_INDEX:
+            rollups = valuep ? parse_dimensions(valuep) : Dimensions{}.set();
+            break;
+        }
+    }
+    return new Analyzer{output.empty() ? nullptr : new SessionsFile{output}, rollups};
 }
 
 void destroy(IAnalyzer* instance)
@@ -61,7 +144,13 @@ void destroy(IAnalyzer* instance)
     delete instance;
 }
 
-NST_PLUGIN_ENTRY_POINTS(&usage, &create, &destroy, nullptr)
+const AnalyzerRequirements* requirements()
+{
+    static const AnalyzerRequirements requirements{false, subscription()};
+    return &requirements;
+}
+
+NST_PLUGIN_ENTRY_POINTS(&usage, &create, &destroy, &requirements)
 
 } //extern "C"
 //------------------------------------------------------------------------------
@@ -47,8 +47,16 @@ uint64_t BreakdownCounter::get_total_count() const
     });
 }
 
-const Latencies BreakdownCounter::operator[](int index) const
+const Latencies& BreakdownCounter::operator[](int index) const
 {
     return latencies[index];
 }
+
+void BreakdownCounter::merge(const BreakdownCounter& other)
+{
+    for(size_t i = 0; i < latencies.size() && i < other.latencies.size(); ++i)
+    {
+        latencies[i].merge(other.latencies[i]);
+    }
+}
 //------------------------------------------------------------------------------
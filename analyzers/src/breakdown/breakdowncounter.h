@@ -40,7 +40,7 @@ public:
      * \param index - command number
      * \return statistics
      */
-    const NST::breakdown::Latencies operator[](int index) const;
+    const NST::breakdown::Latencies& operator[](int index) const;
 
     /*!
      * \brief operator [] returns statistics by index (command number)
@@ -55,6 +55,12 @@ public:
      */
     uint64_t get_total_count() const;
 
+    /*!
+     * \brief merge adds statistics of other counter with the same amount of commands
+     * \param other - counter, f.e. of other session
+     */
+    void merge(const BreakdownCounter& other);
+
 private:
     void                                   operator=(const BreakdownCounter&) = delete;
     std::vector<NST::breakdown::Latencies> latencies;
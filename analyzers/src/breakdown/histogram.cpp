@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Log-linear histogram of latencies
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cmath>
+
+#include "histogram.h"
+//------------------------------------------------------------------------------
+using namespace NST::breakdown;
+//------------------------------------------------------------------------------
+void Histogram::merge(const Histogram& other)
+{
+    if(other.counts.empty())
+    {
+        return;
+    }
+    if(counts.empty())
+    {
+        counts = other.counts;
+    }
+    else
+    {
+        for(unsigned i = 0; i < buckets; ++i)
+        {
+            counts[i] += other.counts[i];
+        }
+    }
+    total += other.total;
+}
+
+uint64_t Histogram::percentile(double p) const
+{
+    if(total == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(std::ceil(total * p / 100.0));
+    if(rank == 0) rank = 1;
+    if(rank > total) rank = total;
+
+    uint64_t passed{0};
+    for(unsigned i = 0; i < buckets; ++i)
+    {
+        passed += counts[i];
+        if(passed >= rank)
+        {
+            return highest(i);
+        }
+    }
+    return highest(buckets - 1);
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Log-linear histogram of latencies
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+//------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace breakdown
+{
+/*!
+ * \brief Histogram counts latencies in log-linear buckets of nanoseconds
+ * Values below 2^sub_bits are counted exactly, each next power of 2 is split
+ * to 2^sub_bits buckets, so relative error of percentiles is below 1/2^sub_bits.
+ * Memory of buckets is allocated by first add() and it doesn't grow.
+ */
+class Histogram
+{
+public:
+    static constexpr unsigned sub_bits{5};
+    static constexpr unsigned max_bits{38}; //!< Values from 2^38 ns (~275 s) are counted in the last bucket
+    static constexpr unsigned buckets{(max_bits - sub_bits + 1) << sub_bits};
+
+    /*! Adds value of latency
+     * \param ns - latency in nanoseconds
+     */
+    inline void add(uint64_t ns)
+    {
+        if(counts.empty())
+        {
+            counts.resize(buckets, 0);
+        }
+        ++counts[bucket(ns)];
+        ++total;
+    }
+
+    /*! Adds counts of other histogram
+     * \param other - histogram, f.e. of other session or thread
+     */
+    void merge(const Histogram& other);
+
+    /*! Gets percentile
+     * \param p - percentile in range (0, 100]
+     * \return the highest value of bucket with percentile, 0 if histogram is empty
+     */
+    uint64_t percentile(double p) const;
+
+    uint64_t get_count() const { return total; }
+
+    //! Resets counts, memory of buckets is kept for reuse
+    inline void clear()
+    {
+        std::fill(counts.begin(), counts.end(), 0);
+        total = 0;
+    }
+
+    static inline unsigned bucket(uint64_t ns)
+    {
+        if(ns < (1U << sub_bits))
+        {
+            return ns;
+        }
+        const unsigned exponent = 63 - __builtin_clzll(ns);
+        if(exponent >= max_bits)
+        {
+            return buckets - 1;
+        }
+        const unsigned shift = exponent - sub_bits;
+        return ((shift + 1) << sub_bits) | ((ns >> shift) & ((1U << sub_bits) - 1));
+    }
+
+    //! Gets the highest value counted in bucket
+    static inline uint64_t highest(unsigned bucket)
+    {
+        if(bucket < (1U << sub_bits))
+        {
+            return bucket;
+        }
+        if(bucket == buckets - 1)
+        {
+            return UINT64_MAX;
+        }
+        const unsigned shift = (bucket >> sub_bits) - 1;
+        const uint64_t lowest{uint64_t((1U << sub_bits) | (bucket & ((1U << sub_bits) - 1))) << shift};
+        return lowest + (uint64_t{1} << shift) - 1;
+    }
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t              total{0};
+};
+
+} // namespace breakdown
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif //HISTOGRAM_H
+//------------------------------------------------------------------------------
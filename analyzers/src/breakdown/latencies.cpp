@@ -27,22 +27,28 @@ using namespace NST::breakdown;
 //------------------------------------------------------------------------------
 
 Latencies::Latencies()
-    : count{0}
+    : min{0}
+    , max{0}
+    , count{0}
     , avg{0}
     , m2{0}
 {
-    timerclear(&min);
-    timerclear(&max);
 }
 
-void Latencies::add(const timeval& t)
+void Latencies::add(uint64_t ns)
 {
-    long double x     = to_sec(t);
+    long double x     = to_sec(ns);
     long double delta = x - avg;
     avg += delta / (++count);
     m2 += delta * (x - avg);
 
-    set_range(t);
+    set_range(ns);
+    histogram.add(ns);
+}
+
+void Latencies::add(const timeval& t)
+{
+    add(to_nsec(t));
 }
 
 uint64_t Latencies::get_count() const
@@ -64,34 +70,77 @@ long double Latencies::get_st_dev() const
     return sqrt(m2 / (count - 1));
 }
 
-const timeval& Latencies::get_min() const
+uint64_t Latencies::get_min() const
 {
     return min;
 }
 
-const timeval& Latencies::get_max() const
+uint64_t Latencies::get_max() const
 {
     return max;
 }
 
-void Latencies::set_range(const timeval& t)
+uint64_t Latencies::get_percentile(double p) const
+{
+    const uint64_t value{histogram.percentile(p)};
+    return value < max ? value : max;
+}
+
+void Latencies::merge(const Latencies& other)
+{
+    if(other.count == 0)
+    {
+        return;
+    }
+    if(count == 0)
+    {
+        min = other.min;
+        max = other.max;
+    }
+    else
+    {
+        set_range(other.min);
+        set_range(other.max);
+    }
+
+    // parallel algorithm of Chan et al. for mean and sum of squares of differences
+    const long double total = count + other.count;
+    const long double delta = other.avg - avg;
+    avg += delta * other.count / total;
+    m2 += other.m2 + delta * delta * count * other.count / total;
+    count += other.count;
+
+    histogram.merge(other.histogram);
+}
+
+void Latencies::set_range(uint64_t ns)
 {
-    if(timercmp(&t, &min, <))
+    if(ns < min || min == 0)
     {
-        min = t;
+        min = ns;
     }
-    if(min.tv_sec == 0 && min.tv_usec == 0)
+    if(ns > max)
     {
-        min = t;
+        max = ns;
     }
-    if(timercmp(&t, &max, >))
+}
+
+uint64_t NST::breakdown::to_nsec(const timeval& val)
+{
+    if(val.tv_sec < 0 || val.tv_usec < 0)
     {
-        max = t;
+        return 0;
     }
+    return static_cast<uint64_t>(val.tv_sec) * 1000000000ULL + static_cast<uint64_t>(val.tv_usec) * 1000ULL;
 }
 
 double NST::breakdown::to_sec(const timeval& val)
 {
     return static_cast<double>(val.tv_sec) + static_cast<double>(val.tv_usec) / 1000000.0;
 }
+
+double NST::breakdown::to_sec(uint64_t ns)
+{
+    return static_cast<double>(ns / 1000000000ULL) + static_cast<double>(ns % 1000000000ULL) / 1000000000.0;
+}
 //------------------------------------------------------------------------------
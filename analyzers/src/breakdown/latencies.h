@@ -25,6 +25,8 @@
 #include <cstdint>
 
 #include <sys/time.h>
+
+#include "histogram.h"
 //------------------------------------------------------------------------------
 namespace NST
 {
@@ -38,6 +40,11 @@ class Latencies
 public:
     Latencies();
 
+    /*! Adds value of latency
+     * \param ns - timeout in nanoseconds
+     */
+    void add(uint64_t ns);
+
     /*! Adds value of latency
      * \param t - timeout
      */
@@ -63,29 +70,51 @@ public:
 
     /*!
      * \brief get_min Gets minimal value of latencies
-     * \return minimal latency
+     * \return minimal latency in nanoseconds
      */
-    const timeval& get_min() const;
+    uint64_t get_min() const;
 
     /*!
      * \brief get_min Gets maximal value of latencies
-     * \return maximal latency
+     * \return maximal latency in nanoseconds
+     */
+    uint64_t get_max() const;
+
+    /*!
+     * \brief get_percentile Gets percentile of latencies
+     * \param p - percentile in range (0, 100], f.e. 99.9
+     * \return upper bound of latency in nanoseconds, it doesn't exceed maximal latency
+     */
+    uint64_t get_percentile(double p) const;
+
+    /*!
+     * \brief merge Adds latencies of other instance, f.e. of other session
+     * \param other - latencies
      */
-    const timeval& get_max() const;
+    void merge(const Latencies& other);
 
 private:
     void operator=(const Latencies&) = delete;
 
-    void set_range(const timeval& t);
+    void set_range(uint64_t ns);
 
-    timeval min;
-    timeval max;
+    uint64_t min;
+    uint64_t max;
 
     uint64_t    count;
     long double avg;
     long double m2;
+
+    Histogram histogram;
 };
 
+/*!
+ * \brief to_nsec Converts timeval to nanoseconds
+ * \param val - time struct
+ * \return nanoseconds, 0 for negative time
+ */
+uint64_t to_nsec(const timeval& val);
+
 /*!
  * \brief to_sec Converts timeval to double
  * \param val - time struct
@@ -93,6 +122,13 @@ private:
  */
 double to_sec(const timeval& val);
 
+/*!
+ * \brief to_sec Converts nanoseconds to double
+ * \param ns - nanoseconds
+ * \return converted value
+ */
+double to_sec(uint64_t ns);
+
 } // namespace breakdown
 } // namespace NST
 //------------------------------------------------------------------------------
@@ -19,6 +19,8 @@
     along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
 */
 //------------------------------------------------------------------------------
+#include <csignal>
+
 #include "nfsv41breakdownanalyzer.h"
 #include "nfsv41commands.h"
 #include "statisticscompositor.h"
@@ -27,17 +29,25 @@ using namespace NST::breakdown;
 //------------------------------------------------------------------------------
 static const size_t space_for_cmd_name = 22;
 static const size_t count_of_compounds = 2;
+
+void NFSv41BreakdownAnalyzer::on_unix_signal(int signo)
+{
+    if(signo == SIGUSR1)
+    {
+        representer.flush_windows(compound_stats, &stats);
+    }
+}
 //------------------------------------------------------------------------------
-NFSv41BreakdownAnalyzer::NFSv41BreakdownAnalyzer(std::ostream& o)
-    : compound_stats(count_of_compounds)
-    , stats(NFSv41Commands().commands_count())
-    , representer(o, new NFSv41Commands(), space_for_cmd_name, count_of_compounds)
+NFSv41BreakdownAnalyzer::NFSv41BreakdownAnalyzer(std::ostream& o, SessionsFile* sessions_file, Dimensions rollups)
+    : compound_stats(count_of_compounds, rollups)
+    , stats(NFSv41Commands().commands_count(), rollups)
+    , representer(o, new NFSv41Commands(), space_for_cmd_name, count_of_compounds, sessions_file)
 {
 }
 
-void NFSv41BreakdownAnalyzer::compound41(const RPCProcedure* proc, const NFS41::COMPOUND4args*, const NFS41::COMPOUND4res*)
+void NFSv41BreakdownAnalyzer::headerNFSv41(const HeaderEvent* event)
 {
-    compound_stats.account(proc, NFS_V41);
+    compound_stats.account(event, event->procedure);
 }
 
 void NFSv41BreakdownAnalyzer::access41(const RPCProcedure* proc, const NFS41::ACCESS4args*, const NFS41::ACCESS4res* res)
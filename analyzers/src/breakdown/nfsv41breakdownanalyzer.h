@@ -40,11 +40,9 @@ class NFSv41BreakdownAnalyzer : virtual public IAnalyzer
     Statistics       stats;          //!< Statistics
     NFSv4Representer representer;    //!< Class for statistics representation
 public:
-    NFSv41BreakdownAnalyzer(std::ostream& o = std::cout);
-    // NFSv4.1 procedures
-    void compound41(const RPCProcedure* proc,
-                    const struct NFS41::COMPOUND4args*,
-                    const struct NFS41::COMPOUND4res*) override final;
+    NFSv41BreakdownAnalyzer(std::ostream& o = std::cout, SessionsFile* sessions_file = nullptr, Dimensions rollups = Dimensions{});
+    // NFSv4.1 procedures accounted by headers
+    void headerNFSv41(const HeaderEvent* event) override final;
     // NFSv4.1 operations
     void access41(const RPCProcedure* proc,
                   const struct NFS41::ACCESS4args*,
@@ -212,6 +210,9 @@ public:
                    const struct NFS41::ILLEGAL4res* res) override final;
 
     void flush_statistics() override;
+
+    //! Prints recent windows on SIGUSR1
+    void on_unix_signal(int signo) override;
 };
 
 } // namespace protocols
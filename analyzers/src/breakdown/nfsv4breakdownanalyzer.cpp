@@ -20,6 +20,7 @@
 */
 //------------------------------------------------------------------------------
 #include <assert.h>
+#include <csignal>
 
 #include "nfsv4breakdownanalyzer.h"
 #include "nfsv4commands.h"
@@ -29,22 +30,25 @@ using namespace NST::breakdown;
 //------------------------------------------------------------------------------
 static const size_t space_for_cmd_name = 22;
 static const size_t count_of_compounds = 2;
-//------------------------------------------------------------------------------
-NFSv4BreakdownAnalyzer::NFSv4BreakdownAnalyzer(std::ostream& o)
-    : compound_stats(count_of_compounds)
-    , stats(NFSv4Commands().commands_count())
-    , representer(o, new NFSv4Commands(), space_for_cmd_name, count_of_compounds)
+
+void NFSv4BreakdownAnalyzer::on_unix_signal(int signo)
 {
+    if(signo == SIGUSR1)
+    {
+        representer.flush_windows(compound_stats, &stats);
+    }
 }
-
-void NFSv4BreakdownAnalyzer::null4(const RPCProcedure* proc, const NFS4::NULL4args*, const NFS4::NULL4res*)
+//------------------------------------------------------------------------------
+NFSv4BreakdownAnalyzer::NFSv4BreakdownAnalyzer(std::ostream& o, SessionsFile* sessions_file, Dimensions rollups)
+    : compound_stats(count_of_compounds, rollups)
+    , stats(NFSv4Commands().commands_count(), rollups)
+    , representer(o, new NFSv4Commands(), space_for_cmd_name, count_of_compounds, sessions_file)
 {
-    compound_stats.account(proc, ProcEnumNFS4::NFSProcedure::NFS_NULL);
 }
 
-void NFSv4BreakdownAnalyzer::compound4(const RPCProcedure* proc, const NFS4::COMPOUND4args*, const NFS4::COMPOUND4res*)
+void NFSv4BreakdownAnalyzer::headerNFSv40(const HeaderEvent* event)
 {
-    compound_stats.account(proc, ProcEnumNFS4::NFSProcedure::COMPOUND);
+    compound_stats.account(event, event->procedure);
 }
 
 void NFSv4BreakdownAnalyzer::access40(const RPCProcedure* proc, const NFS4::ACCESS4args*, const NFS4::ACCESS4res* res)
@@ -42,16 +42,11 @@ private:
     Statistics       stats;          //!< Statistics
     NFSv4Representer representer;    //!< stream to output
 public:
-    NFSv4BreakdownAnalyzer(std::ostream& o = std::cout);
+    NFSv4BreakdownAnalyzer(std::ostream& o = std::cout, SessionsFile* sessions_file = nullptr, Dimensions rollups = Dimensions{});
 
-    // NFS4.0 procedures
+    // NFS4.0 procedures accounted by headers
 
-    void null4(const RPCProcedure* proc,
-               const struct NFS4::NULL4args*,
-               const struct NFS4::NULL4res*) override final;
-    void compound4(const RPCProcedure* proc,
-                   const struct NFS4::COMPOUND4args*,
-                   const struct NFS4::COMPOUND4res*) override final;
+    void headerNFSv40(const HeaderEvent* event) override final;
 
     // NFS4.0 operations
 
@@ -166,6 +161,9 @@ public:
     void illegal40(const RPCProcedure*             proc,
                    const struct NFS4::ILLEGAL4res* res) override final;
     void flush_statistics() override;
+
+    //! Prints recent windows on SIGUSR1
+    void on_unix_signal(int signo) override;
 };
 
 } // namespace breakdown
@@ -23,8 +23,8 @@
 //------------------------------------------------------------------------------
 using namespace NST::breakdown;
 //------------------------------------------------------------------------------
-NFSv4Representer::NFSv4Representer(std::ostream& o, CommandRepresenter* cmdRep, size_t space_for_cmd_name, size_t count_of_compounds)
-    : Representer(o, cmdRep, space_for_cmd_name)
+NFSv4Representer::NFSv4Representer(std::ostream& o, CommandRepresenter* cmdRep, size_t space_for_cmd_name, size_t count_of_compounds, SessionsFile* sessions_file)
+    : Representer(o, cmdRep, space_for_cmd_name, sessions_file)
     , count_of_compounds(count_of_compounds)
 {
 }
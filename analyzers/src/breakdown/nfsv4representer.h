@@ -37,7 +37,7 @@ class NFSv4Representer : public Representer
     const size_t count_of_compounds;
 
 public:
-    NFSv4Representer(std::ostream& o, CommandRepresenter* cmdRep, size_t space_for_cmd_name, size_t count_of_compounds);
+    NFSv4Representer(std::ostream& o, CommandRepresenter* cmdRep, size_t space_for_cmd_name, size_t count_of_compounds, SessionsFile* sessions_file = nullptr);
     void onProcedureInfoPrinted(std::ostream& o, const BreakdownCounter& breakdown, unsigned procedure) const override final;
 };
 
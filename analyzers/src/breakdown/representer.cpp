@@ -19,18 +19,35 @@
     along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
 */
 //------------------------------------------------------------------------------
+#include <cinttypes>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #include "representer.h"
 //------------------------------------------------------------------------------
 using namespace NST::breakdown;
 //------------------------------------------------------------------------------
-NST::breakdown::Representer::Representer(std::ostream& o, NST::breakdown::CommandRepresenter* cmd_representer, size_t space_for_cmd_name)
+namespace
+{
+// printed after StDev, maximum is printed as Max
+const struct
+{
+    const char* name;
+    double      value;
+} percentiles[] = {{"P50", 50}, {"P90", 90}, {"P99", 99}, {"P99.9", 99.9}};
+
+// sessions formatted by one thread at least, so small outputs aren't split
+const size_t sessions_per_thread = 256;
+}
+//------------------------------------------------------------------------------
+NST::breakdown::Representer::Representer(std::ostream& o, NST::breakdown::CommandRepresenter* cmd_representer, size_t space_for_cmd_name, SessionsFile* sessions_file)
     : out(o)
     , cmd_representer(cmd_representer)
     , space_for_cmd_name(space_for_cmd_name)
+    , sessions_file(sessions_file)
 {
 }
 
@@ -62,13 +79,38 @@ void Representer::flush_statistics(const Statistics& statistics)
 
         out << "Per connection info: " << std::endl;
 
+        std::vector<Session> sessions;
         statistics.for_each_session([&](const Session& session) {
             std::stringstream ssession;
             print_session(ssession, session);
             print_per_session(statistics, session, ssession.str());
-            std::ofstream file("breakdown_" + ssession.str() + ".dat", std::ios::out | std::ios::trunc);
-            store_per_session(file, statistics, session, ssession.str());
+            if(sessions_file)
+            {
+                sessions.push_back(session);
+            }
+            else
+            {
+                std::ofstream file("breakdown_" + ssession.str() + ".dat", std::ios::out | std::ios::trunc);
+                store_per_session(file, statistics, session, ssession.str());
+            }
         });
+
+        if(sessions_file)
+        {
+            store_sessions(statistics, sessions);
+        }
+
+        for(size_t d = 0; d < dimensions_count; ++d)
+        {
+            if(statistics.dimensions[d])
+            {
+                const Dimension dimension = static_cast<Dimension>(d);
+                out << "Per " << dimension_name(dimension) << " info: " << std::endl;
+                statistics.for_each_host(dimension, [&](const Host& host) {
+                    print_per_host(statistics, dimension, host);
+                });
+            }
+        }
     }
     else
     {
@@ -76,6 +118,125 @@ void Representer::flush_statistics(const Statistics& statistics)
     }
 }
 
+void Representer::flush_windows(const Statistics& statistics, const Statistics* operations)
+{
+    out << "###  Breakdown analyzer  ###" << std::endl
+        << cmd_representer->protocol_name() << " protocol, recent windows" << std::endl;
+
+    for(size_t window = 0; window < windows_count; ++window)
+    {
+        out << "Last " << window_spans[window].name << ':' << std::endl;
+        print_window(statistics, window, 0);
+        if(operations)
+        {
+            print_window(*operations, window, statistics.proc_types_count);
+        }
+
+        statistics.for_each_session_in_window(window, [&](const Session& session, const WindowCounter& total) {
+            out << "Session: ";
+            print_session(out, session);
+            out << " Count: " << total.count;
+            out.precision(6);
+            out << std::fixed
+                << " Avg: " << total.get_avg()
+                << " Max: " << total.max / 1e9
+                << std::endl;
+        });
+    }
+}
+
+void Representer::print_window(const Statistics& statistics, size_t window, size_t first_procedure) const
+{
+    statistics.for_each_procedure_in_window(window, [&](const WindowCounter& total, const Histogram& histogram, size_t procedure) {
+        if(procedure < first_procedure || total.count == 0)
+        {
+            return;
+        }
+        out.width(22);
+        out << std::left
+            << cmd_representer->command_name(procedure);
+        out.width(6);
+        out << " Count:";
+        out.width(5);
+        out << std::right
+            << total.count;
+        out.precision(6);
+        out << std::fixed
+            << " Avg: " << total.get_avg()
+            << " Max: " << total.max / 1e9;
+        for(const auto& p : percentiles)
+        {
+            const uint64_t value{histogram.percentile(p.value)};
+            out << ' ' << p.name << ": " << (value < total.max ? value : total.max) / 1e9;
+        }
+        out << std::endl;
+    });
+}
+
+void Representer::store_sessions(const Statistics& statistics, const std::vector<Session>& sessions) const
+{
+    // sessions are formatted by parts in parallel and written in their order
+    size_t threads = std::thread::hardware_concurrency();
+    if(threads == 0 || threads > sessions.size() / sessions_per_thread)
+    {
+        threads = sessions.size() / sessions_per_thread + 1;
+    }
+
+    std::vector<std::string> parts(threads);
+    auto                     format = [&](size_t part) {
+        const size_t end = sessions.size() * (part + 1) / threads;
+        for(size_t i = sessions.size() * part / threads; i < end; ++i)
+        {
+            format_session(parts[part], statistics, sessions[i]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for(size_t part = 1; part < threads; ++part)
+    {
+        workers.emplace_back(format, part);
+    }
+    format(0);
+    for(auto& w : workers)
+    {
+        w.join();
+    }
+
+    for(const auto& rows : parts)
+    {
+        sessions_file->append(rows);
+    }
+}
+
+void Representer::format_session(std::string& rows, const Statistics& statistics, const Session& session) const
+{
+    std::stringstream ssession;
+    print_session(ssession, session);
+    const std::string prefix = ssession.str() + ',' + cmd_representer->protocol_name() + ',';
+
+    char row[512];
+    statistics.for_each_procedure_in_session(session, [&](const BreakdownCounter& breakdown, size_t procedure) {
+        const Latencies& latencies    = breakdown[procedure];
+        const uint64_t   s_total_proc = breakdown.get_total_count();
+        int              len          = std::snprintf(row, sizeof(row), "%zu,%s,%" PRIu64 ",%.2f,%.9f,%.9f,%.9Lf,%.9Lf",
+                                     procedure,
+                                     cmd_representer->command_name(procedure),
+                                     latencies.get_count(),
+                                     s_total_proc ? latencies.get_count() * 100.0 / s_total_proc : 0.0,
+                                     to_sec(latencies.get_min()),
+                                     to_sec(latencies.get_max()),
+                                     latencies.get_avg(),
+                                     latencies.get_st_dev());
+        for(const auto& p : percentiles)
+        {
+            len += std::snprintf(row + len, sizeof(row) - len, ",%.9f", to_sec(latencies.get_percentile(p.value)));
+        }
+        rows += prefix;
+        rows.append(row, len);
+        rows += '\n';
+    });
+}
+
 void Representer::store_per_session(std::ostream& file, const Statistics& statistics, const Session& session, const std::string& ssession) const
 {
     //TODO: does it make sense to join store_per_session & print_per_session?
@@ -89,8 +250,12 @@ void Representer::store_per_session(std::ostream& file, const Statistics& statis
         file << ' ' << to_sec(breakdown[procedure].get_min())
              << ' ' << to_sec(breakdown[procedure].get_max())
              << ' ' << breakdown[procedure].get_avg()
-             << ' ' << breakdown[procedure].get_st_dev()
-             << std::endl;
+             << ' ' << breakdown[procedure].get_st_dev();
+        for(const auto& p : percentiles)
+        {
+            file << ' ' << breakdown[procedure].get_percentile(p.value) / 1e9;
+        }
+        file << std::endl;
     });
 }
 
@@ -99,40 +264,59 @@ void Representer::print_per_session(const Statistics& statistics, const Session&
     out << "Session: " << ssession << std::endl;
 
     statistics.for_each_procedure_in_session(session, [&](const BreakdownCounter& breakdown, size_t procedure) {
-        uint64_t s_total_proc = breakdown.get_total_count();
-        onProcedureInfoPrinted(out, breakdown, procedure);
-        out.width(22);
-        out << std::left
-            << cmd_representer->command_name(procedure);
-        out.width(6);
-        out << " Count:";
-        out.width(5);
-        out << std::right
-            << breakdown[procedure].get_count()
-            << ' ';
-        out.precision(2);
-        out << '(';
-        out.width(6);
-        out << std::fixed
-            << (s_total_proc ? (static_cast<long double>(breakdown[procedure].get_count()) * 100 / s_total_proc) : 0);
-        out << "%) Min: ";
-        out.precision(3);
-        out << std::fixed
-            << to_sec(breakdown[procedure].get_min())
-            << " Max: "
-            << std::fixed
-            << to_sec(breakdown[procedure].get_max())
-            << " Avg: "
-            << std::fixed
-            << breakdown[procedure].get_avg();
-        out.precision(8);
-        out << " StDev: "
-            << std::fixed
-            << breakdown[procedure].get_st_dev()
-            << std::endl;
+        print_procedure(breakdown, procedure);
     });
 }
 
+void Representer::print_per_host(const Statistics& statistics, Dimension dimension, const Host& host) const
+{
+    out << "Host: " << host << std::endl;
+
+    statistics.for_each_procedure_in_host(dimension, host, [&](const BreakdownCounter& breakdown, size_t procedure) {
+        print_procedure(breakdown, procedure);
+    });
+}
+
+void Representer::print_procedure(const BreakdownCounter& breakdown, size_t procedure) const
+{
+    uint64_t s_total_proc = breakdown.get_total_count();
+    onProcedureInfoPrinted(out, breakdown, procedure);
+    out.width(22);
+    out << std::left
+        << cmd_representer->command_name(procedure);
+    out.width(6);
+    out << " Count:";
+    out.width(5);
+    out << std::right
+        << breakdown[procedure].get_count()
+        << ' ';
+    out.precision(2);
+    out << '(';
+    out.width(6);
+    out << std::fixed
+        << (s_total_proc ? (static_cast<long double>(breakdown[procedure].get_count()) * 100 / s_total_proc) : 0);
+    out << "%) Min: ";
+    out.precision(3);
+    out << std::fixed
+        << to_sec(breakdown[procedure].get_min())
+        << " Max: "
+        << std::fixed
+        << to_sec(breakdown[procedure].get_max())
+        << " Avg: "
+        << std::fixed
+        << breakdown[procedure].get_avg();
+    out.precision(8);
+    out << " StDev: "
+        << std::fixed
+        << breakdown[procedure].get_st_dev();
+    out.precision(6);
+    for(const auto& p : percentiles)
+    {
+        out << ' ' << p.name << ": " << breakdown[procedure].get_percentile(p.value) / 1e9;
+    }
+    out << std::endl;
+}
+
 void Representer::onProcedureInfoPrinted(std::ostream& o, const BreakdownCounter& breakdown, unsigned procedure) const
 {
     if(procedure == 0)
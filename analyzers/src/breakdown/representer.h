@@ -24,9 +24,12 @@
 //------------------------------------------------------------------------------
 #include <memory>
 #include <ostream>
+#include <string>
+#include <vector>
 
 #include "breakdowncounter.h"
 #include "commandrepresenter.h"
+#include "sessionsfile.h"
 #include "statistics.h"
 //------------------------------------------------------------------------------
 namespace NST
@@ -40,6 +43,7 @@ class Representer
     std::ostream&                       out;
     std::unique_ptr<CommandRepresenter> cmd_representer;
     size_t                              space_for_cmd_name;
+    SessionsFile*                       sessions_file;
 
     void store_per_session(std::ostream&      file,
                            const Statistics&  statistics,
@@ -48,6 +52,16 @@ class Representer
 
     void print_per_session(const Statistics& statistics, const Session& session, const std::string& ssession) const;
 
+    void print_per_host(const Statistics& statistics, Dimension dimension, const Host& host) const;
+
+    void print_procedure(const BreakdownCounter& breakdown, size_t procedure) const;
+
+    void print_window(const Statistics& statistics, size_t window, size_t first_procedure) const;
+
+    void store_sessions(const Statistics& statistics, const std::vector<Session>& sessions) const;
+
+    void format_session(std::string& rows, const Statistics& statistics, const Session& session) const;
+
 protected:
     /**
      * @brief handler of one procedure output event
@@ -63,14 +77,22 @@ public:
      * @param o - output stream
      * @param cmd_representer - command representer
      * @param space_for_cmd_name - spaces amount in output table (column's wifth)
+     * @param sessions_file - file for rows of all sessions instead of .dat file per session
      */
-    Representer(std::ostream& o, CommandRepresenter* cmd_representer, size_t space_for_cmd_name = 12);
+    Representer(std::ostream& o, CommandRepresenter* cmd_representer, size_t space_for_cmd_name = 12, SessionsFile* sessions_file = nullptr);
 
     /*!
      * \brief flush_statistics outs statistics on screen
      * \param statistics - statistics data
      */
     void flush_statistics(const Statistics& statistics);
+
+    /*!
+     * \brief flush_windows outs statistics of recent windows on screen while capture goes on
+     * \param statistics - statistics data
+     * \param operations - statistics of NFSv4.x operations, they follow procedures of statistics
+     */
+    void flush_windows(const Statistics& statistics, const Statistics* operations = nullptr);
 };
 
 } // namespace breakdown
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Rollups of statistics of sessions by their hosts
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+
+#include "rollups.h"
+//------------------------------------------------------------------------------
+using namespace NST::breakdown;
+//------------------------------------------------------------------------------
+namespace
+{
+const char* const names[dimensions_count] = {"client", "server"};
+}
+
+const char* NST::breakdown::dimension_name(Dimension dimension)
+{
+    return names[static_cast<size_t>(dimension)];
+}
+
+Dimensions NST::breakdown::parse_dimensions(const std::string& list)
+{
+    Dimensions         dimensions;
+    std::istringstream input{list};
+    std::string        name;
+    while(std::getline(input, name, ':'))
+    {
+        size_t d = 0;
+        while(d < dimensions_count && name != names[d])
+        {
+            ++d;
+        }
+        if(d == dimensions_count)
+        {
+            throw std::runtime_error{"Unknown dimension of rollup: " + name};
+        }
+        dimensions.set(d);
+    }
+    return dimensions;
+}
+
+Host::Host(const Session& session, Dimension dimension)
+    : ip_type{session.ip_type}
+    , addr{}
+{
+    const size_t side = dimension == Dimension::Client ? Session::Source : Session::Destination;
+    if(ip_type == Session::IPType::v4)
+    {
+        std::memcpy(addr, &session.ip.v4.addr[side], sizeof(session.ip.v4.addr[side]));
+    }
+    else
+    {
+        std::memcpy(addr, session.ip.v6.addr[side], sizeof(session.ip.v6.addr[side]));
+    }
+}
+
+bool Host::operator==(const Host& other) const
+{
+    return ip_type == other.ip_type && std::memcmp(addr, other.addr, sizeof(addr)) == 0;
+}
+
+std::ostream& NST::breakdown::operator<<(std::ostream& out, const Host& host)
+{
+    char buffer[INET6_ADDRSTRLEN];
+    out << inet_ntop(host.ip_type == Session::IPType::v4 ? AF_INET : AF_INET6, host.addr, buffer, sizeof(buffer));
+    return out;
+}
+
+uint32_t RollupTable::resolve(const Host& host, size_t count)
+{
+    auto i = indexes.find(host);
+    if(i != indexes.end())
+    {
+        return i->second;
+    }
+    entries.push_back(Entry{host, BreakdownCounter{count}});
+    indexes.emplace(host, entries.size() - 1);
+    return entries.size() - 1;
+}
+
+const RollupTable::Entry* RollupTable::find(const Host& host) const
+{
+    auto i = indexes.find(host);
+    return i != indexes.end() ? &entries[i->second] : nullptr;
+}
+
+size_t RollupTable::Hash::operator()(const Host& host) const
+{
+    uint64_t words[2];
+    std::memcpy(words, host.addr, sizeof(words));
+    return (words[0] ^ (words[1] * 11400714819323198485ull)) * 11400714819323198485ull ^ host.ip_type;
+}
+//------------------------------------------------------------------------------
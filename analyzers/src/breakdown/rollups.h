@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Rollups of statistics of sessions by their hosts
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef ROLLUPS_H
+#define ROLLUPS_H
+//------------------------------------------------------------------------------
+#include <bitset>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <api/plugin_api.h>
+
+#include "breakdowncounter.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace breakdown
+{
+/*!
+ * \brief Dimension of rollup, sessions are aggregated by their hosts
+ */
+enum class Dimension
+{
+    Client = 0, //!< Source of session
+    Server = 1  //!< Destination of session
+};
+
+const size_t dimensions_count = 2;
+
+using Dimensions = std::bitset<dimensions_count>;
+
+/*!
+ * \brief dimension_name Gets name of dimension, f.e. "client"
+ */
+const char* dimension_name(Dimension dimension);
+
+/*!
+ * \brief parse_dimensions Parses list of dimensions separated by ':'
+ * \param list - f.e. "client:server"
+ * \return dimensions, throws std::runtime_error on unknown name
+ */
+Dimensions parse_dimensions(const std::string& list);
+
+/*!
+ * \brief Host is address of one side of session
+ */
+struct Host
+{
+    Session::IPType ip_type;
+    uint8_t         addr[16]; //!< IPv4 or IPv6 address in network byte order
+
+    Host(const Session& session, Dimension dimension);
+
+    bool operator==(const Host& other) const;
+};
+
+std::ostream& operator<<(std::ostream& out, const Host& host);
+
+/*!
+ * \brief RollupTable keeps statistics of hosts in order of their appearance
+ * Host is looked up once per session, then statistics are updated by index.
+ */
+class RollupTable
+{
+public:
+    struct Entry
+    {
+        Host             host;
+        BreakdownCounter counter;
+    };
+
+    /*!
+     * \brief resolve Looks up or adds statistics of host
+     * \param host - host
+     * \param count - amount of types of procedures
+     * \return index of statistics, it doesn't change
+     */
+    uint32_t resolve(const Host& host, size_t count);
+
+    /*!
+     * \brief find Looks up statistics of host
+     * \return statistics or nullptr if host is unknown
+     */
+    const Entry* find(const Host& host) const;
+
+    Entry& operator[](uint32_t index) { return entries[index]; }
+    bool   empty() const { return entries.empty(); }
+    std::vector<Entry>::const_iterator begin() const { return entries.begin(); }
+    std::vector<Entry>::const_iterator end() const { return entries.end(); }
+private:
+    struct Hash
+    {
+        size_t operator()(const Host& host) const;
+    };
+
+    std::unordered_map<Host, uint32_t, Hash> indexes;
+    std::vector<Entry>                       entries;
+};
+
+} // namespace breakdown
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // ROLLUPS_H
+//------------------------------------------------------------------------------
@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Buffered CSV file of statistics of all sessions
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <cerrno>
+#include <system_error>
+
+#include "sessionsfile.h"
+//------------------------------------------------------------------------------
+using namespace NST::breakdown;
+//------------------------------------------------------------------------------
+static const size_t buffer_size = 4 * 1024 * 1024;
+//------------------------------------------------------------------------------
+constexpr const char* SessionsFile::header;
+
+SessionsFile::SessionsFile(const std::string& path)
+    : file{std::fopen(path.c_str(), "w")}
+    , path{path}
+{
+    if(file == nullptr)
+    {
+        throw std::system_error{errno, std::system_category(), "Error in opening breakdown output: " + path};
+    }
+    std::setvbuf(file, nullptr, _IOFBF, buffer_size);
+    append(header);
+}
+
+SessionsFile::~SessionsFile()
+{
+    if(file != nullptr)
+    {
+        std::fclose(file);
+    }
+}
+
+void SessionsFile::append(const std::string& rows)
+{
+    if(std::fwrite(rows.data(), 1, rows.size(), file) != rows.size())
+    {
+        throw std::system_error{errno, std::system_category(), "Error in writing breakdown output: " + path};
+    }
+}
+
+void SessionsFile::close()
+{
+    if(file == nullptr)
+    {
+        return;
+    }
+    // the last chunk of rows is written from the buffer here
+    const bool flushed{std::fflush(file) == 0};
+    const int  error{errno};
+    const bool closed{std::fclose(file) == 0};
+    file = nullptr;
+    if(!flushed || !closed)
+    {
+        throw std::system_error{flushed ? errno : error, std::system_category(), "Error in writing breakdown output: " + path};
+    }
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Buffered CSV file of statistics of all sessions
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef SESSIONSFILE_H
+#define SESSIONSFILE_H
+//------------------------------------------------------------------------------
+#include <cstdio>
+#include <string>
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace breakdown
+{
+/*!
+ * \brief SessionsFile keeps rows of all sessions of all protocols in one CSV file
+ * It replaces breakdown_<session>.dat files, which are too many with
+ * thousands of connections. Rows are written through a large buffer.
+ */
+class SessionsFile
+{
+public:
+    static constexpr const char* header{"session,protocol,index,procedure,count,percent,min,max,avg,stdev,p50,p90,p99,p99.9\n"};
+
+    /*!
+     * \brief Creates or truncates file and writes header of columns
+     * \param path - path to file
+     */
+    explicit SessionsFile(const std::string& path);
+    ~SessionsFile();
+    SessionsFile(const SessionsFile&) = delete;
+    SessionsFile& operator=(const SessionsFile&) = delete;
+
+    /*!
+     * \brief append Writes formatted rows
+     * \param rows - lines of CSV
+     */
+    void append(const std::string& rows);
+
+    /*!
+     * \brief close Writes buffered rows and closes file, errors of disk are reported
+     * It is called once after all rows are appended, the destructor only releases the file.
+     */
+    void close();
+
+private:
+    std::FILE*  file;
+    std::string path;
+};
+
+} // namespace breakdown
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // SESSIONSFILE_H
+//------------------------------------------------------------------------------
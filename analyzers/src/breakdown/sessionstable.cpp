@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Hash table of statistics of sessions keyed by their ids
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include "sessionstable.h"
+//------------------------------------------------------------------------------
+using namespace NST::breakdown;
+//------------------------------------------------------------------------------
+SessionsTable::SessionsTable()
+    : slots(16, 0)
+    , shift{60}
+{
+}
+
+const SessionsTable::Entry* SessionsTable::find(const Session& session) const
+{
+    const uint32_t index = slots[slot(session.id)];
+    return index ? &entries[index - 1] : nullptr;
+}
+
+SessionsTable::Entry* SessionsTable::find(const Session& session)
+{
+    const uint32_t index = slots[slot(session.id)];
+    return index ? &entries[index - 1] : nullptr;
+}
+
+SessionsTable::Entry& SessionsTable::emplace(const Session& session, size_t count)
+{
+    if((entries.size() + 1) * 2 > slots.size()) // keep load factor at most 1/2
+    {
+        grow();
+    }
+    entries.push_back(Entry{session, BreakdownCounter{count}, make_windows(WindowCounter{}), {}});
+    slots[slot(session.id)] = entries.size();
+    return entries.back();
+}
+
+size_t SessionsTable::slot(uint32_t id) const
+{
+    const size_t mask = slots.size() - 1;
+
+    // Fibonacci hashing spreads sequential ids over the table
+    size_t i = (id * 11400714819323198485ull) >> shift;
+    while(slots[i] && entries[slots[i] - 1].session.id != id)
+    {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void SessionsTable::grow()
+{
+    slots.assign(slots.size() * 2, 0);
+    --shift;
+    for(size_t i = 0; i < entries.size(); ++i)
+    {
+        slots[slot(entries[i].session.id)] = i + 1;
+    }
+}
+//------------------------------------------------------------------------------
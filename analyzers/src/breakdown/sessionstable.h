@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Hash table of statistics of sessions keyed by their ids
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef SESSIONSTABLE_H
+#define SESSIONSTABLE_H
+//------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+#include <api/plugin_api.h>
+
+#include "breakdowncounter.h"
+#include "rollups.h"
+#include "windows.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace breakdown
+{
+/*!
+ * \brief SessionsTable keeps statistics of sessions in order of their appearance
+ * Sessions are looked up by Session::id in open addressing table of indexes,
+ * so lookup of known session doesn't allocate memory.
+ */
+class SessionsTable
+{
+public:
+    struct Entry
+    {
+        Session                            session;
+        BreakdownCounter                   counter;
+        std::vector<Window<WindowCounter>> recent; //!< Rolling windows of session
+        uint32_t                           rollups[dimensions_count]; //!< Indexes of statistics of hosts of session
+    };
+
+    SessionsTable();
+
+    /*!
+     * \brief find Looks up statistics of session
+     * \param session - session
+     * \return statistics or nullptr if session is unknown
+     */
+    const Entry* find(const Session& session) const;
+    Entry* find(const Session& session);
+
+    /*!
+     * \brief emplace Adds statistics of new session, it must be unknown
+     * \param session - session
+     * \param count - amount of types of procedures
+     * \return statistics of session
+     */
+    Entry& emplace(const Session& session, size_t count);
+
+    bool empty() const { return entries.empty(); }
+    std::vector<Entry>::const_iterator begin() const { return entries.begin(); }
+    std::vector<Entry>::const_iterator end() const { return entries.end(); }
+private:
+    //! Returns slot of the id or free slot where the id should be placed
+    size_t slot(uint32_t id) const;
+    void   grow();
+
+    std::vector<uint32_t> slots; //!< Index of entry + 1, 0 marks free slot
+    std::vector<Entry>    entries;
+    unsigned              shift;
+};
+
+} // namespace breakdown
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // SESSIONSTABLE_H
+//------------------------------------------------------------------------------
@@ -23,20 +23,22 @@
 //------------------------------------------------------------------------------
 using namespace NST::breakdown;
 //------------------------------------------------------------------------------
-bool Less::operator()(const Session& a, const Session& b) const
+Statistics::Statistics(size_t proc_types_count, Dimensions dimensions)
+    : proc_types_count(proc_types_count)
+    , dimensions(dimensions)
+    , counter(proc_types_count)
+    , recent(make_windows(ProceduresSlice{proc_types_count}))
 {
-    return ((std::uint16_t)(a.ip_type) < (std::uint16_t)(b.ip_type)) || // compare versions of IP address
-           (ntohs(a.port[0]) < ntohs(b.port[0])) ||                     // compare Source(client) ports
-           (ntohs(a.port[1]) < ntohs(b.port[1])) ||                     // compare Destination(server) ports
-
-           ((a.ip_type == Session::IPType::v4) ? // compare IPv4
-                ((ntohl(a.ip.v4.addr[0]) < ntohl(b.ip.v4.addr[0])) || (ntohl(a.ip.v4.addr[1]) < ntohl(b.ip.v4.addr[1])))
-                                               : (memcmp(&a.ip.v6, &b.ip.v6, sizeof(a.ip.v6)) < 0));
 }
 
-Statistics::Statistics(size_t proc_types_count)
-    : proc_types_count(proc_types_count)
-    , counter(proc_types_count)
+Statistics::Statistics(const Statistics& other)
+    : proc_types_count(other.proc_types_count)
+    , dimensions(other.dimensions)
+    , counter(other.counter)
+    , per_session_statistics(other.per_session_statistics)
+    , rollups(other.rollups)
+    , recent(other.recent)
+    , last_time(other.last_time)
 {
 }
 
@@ -50,23 +52,45 @@ void Statistics::for_each_procedure(std::function<void(const BreakdownCounter&,
 
 void Statistics::for_each_session(std::function<void(const Session&)> on_session) const
 {
-    for(auto& it : per_session_statistics)
+    for(const auto& entry : per_session_statistics)
     {
-        on_session(it.first);
+        on_session(entry.session);
     }
 }
 
 void Statistics::for_each_procedure_in_session(const Session& session, std::function<void(const BreakdownCounter&, size_t)> on_procedure) const
 {
-    if(per_session_statistics.find(session) == per_session_statistics.end())
+    const SessionsTable::Entry* current = per_session_statistics.find(session);
+    if(current == nullptr)
     {
         return;
     }
 
-    const BreakdownCounter& current = per_session_statistics.at(session);
     for(size_t procedure = 0; procedure < proc_types_count; ++procedure)
     {
-        on_procedure(current, procedure);
+        on_procedure(current->counter, procedure);
+    }
+}
+
+void Statistics::for_each_host(Dimension dimension, std::function<void(const Host&)> on_host) const
+{
+    for(const auto& entry : rollups[static_cast<size_t>(dimension)])
+    {
+        on_host(entry.host);
+    }
+}
+
+void Statistics::for_each_procedure_in_host(Dimension dimension, const Host& host, std::function<void(const BreakdownCounter&, size_t)> on_procedure) const
+{
+    const RollupTable::Entry* current = rollups[static_cast<size_t>(dimension)].find(host);
+    if(current == nullptr)
+    {
+        return;
+    }
+
+    for(size_t procedure = 0; procedure < proc_types_count; ++procedure)
+    {
+        on_procedure(current->counter, procedure);
     }
 }
 
@@ -75,21 +99,95 @@ bool Statistics::has_session() const
     return !per_session_statistics.empty();
 }
 
-void Statistics::account(const int cmd_index, const Session& session, const timeval latency)
+void Statistics::for_each_procedure_in_window(size_t window, std::function<void(const WindowCounter&, const Histogram&, size_t)> on_procedure) const
 {
+    std::vector<WindowCounter> counters(proc_types_count);
+    std::vector<Histogram>     histograms(proc_types_count);
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        recent[window].for_each_slice(last_time, [&](const ProceduresSlice& slice) {
+            for(size_t procedure = 0; procedure < proc_types_count; ++procedure)
+            {
+                counters[procedure].merge(slice.counters[procedure]);
+                histograms[procedure].merge(slice.histograms[procedure]);
+            }
+        });
+    }
+
+    for(size_t procedure = 0; procedure < proc_types_count; ++procedure)
+    {
+        on_procedure(counters[procedure], histograms[procedure], procedure);
+    }
+}
+
+void Statistics::for_each_session_in_window(size_t window, std::function<void(const Session&, const WindowCounter&)> on_session) const
+{
+    std::vector<std::pair<Session, WindowCounter>> active;
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        for(const auto& entry : per_session_statistics)
+        {
+            WindowCounter total;
+            entry.recent[window].for_each_slice(last_time, [&](const WindowCounter& slice) {
+                total.merge(slice);
+            });
+            if(total.count != 0)
+            {
+                active.emplace_back(entry.session, total);
+            }
+        }
+    }
+
+    for(const auto& a : active)
+    {
+        on_session(a.first, a.second);
+    }
+}
+
+void Statistics::account(const int cmd_index, const Session& session, const int64_t time, const uint64_t latency)
+{
+    std::lock_guard<std::mutex> guard{lock};
+
     counter[cmd_index].add(latency);
 
-    auto i = per_session_statistics.find(session);
-    if(i == per_session_statistics.end())
+    SessionsTable::Entry* current = per_session_statistics.find(session);
+    if(current == nullptr)
     {
-        auto session_res = per_session_statistics.emplace(session, BreakdownCounter{proc_types_count});
-        if(session_res.second == false)
+        current = &per_session_statistics.emplace(session, proc_types_count);
+        for(size_t d = 0; d < dimensions_count; ++d)
         {
-            return;
+            if(dimensions[d])
+            {
+                current->rollups[d] = rollups[d].resolve(Host{session, static_cast<Dimension>(d)}, proc_types_count);
+            }
         }
-        i = session_res.first;
     }
 
-    (i->second)[cmd_index].add(latency);
+    // rollups are updated with session, so they are ready without merging of sessions
+    current->counter[cmd_index].add(latency);
+    for(size_t d = 0; d < dimensions_count; ++d)
+    {
+        if(dimensions[d])
+        {
+            rollups[d][current->rollups[d]].counter[cmd_index].add(latency);
+        }
+    }
+
+    if(time > last_time)
+    {
+        last_time = time;
+    }
+    for(size_t window = 0; window < windows_count; ++window)
+    {
+        if(ProceduresSlice* slice = recent[window].slice(time))
+        {
+            slice->counters[cmd_index].add(latency);
+            slice->histograms[cmd_index].add(latency);
+        }
+        if(WindowCounter* slice = current->recent[window].slice(time))
+        {
+            slice->add(latency);
+        }
+    }
 }
 //------------------------------------------------------------------------------
@@ -22,38 +22,42 @@
 #ifndef STATISTICS_H
 #define STATISTICS_H
 //------------------------------------------------------------------------------
+#include <array>
 #include <functional>
-#include <map>
+#include <mutex>
 
 #include <api/plugin_api.h>
 
 #include "breakdowncounter.h"
+#include "sessionstable.h"
+#include "windows.h"
 //------------------------------------------------------------------------------
 namespace NST
 {
 namespace breakdown
 {
-/*! \brief Comparator for sessions
- */
-struct Less
-{
-    bool operator()(const Session& a, const Session& b) const;
-};
-
 /*! \brief All statistics data's container
  */
 struct Statistics
 {
-    using PerSessionStatistics = std::map<Session, BreakdownCounter, Less>;
+    using PerSessionStatistics = SessionsTable;
     using ProceduresCount      = std::vector<int>;
 
-    const size_t proc_types_count; //!< Count of types of procedures
+    const size_t     proc_types_count; //!< Count of types of procedures
+    const Dimensions dimensions;       //!< Enabled rollups of sessions
 
     /**
      * @brief Constructor
      * @param proc_types_count - amount of types of procedures
+     * @param dimensions - rollups of sessions which are updated with sessions
+     */
+    Statistics(size_t proc_types_count, Dimensions dimensions = Dimensions{});
+
+    /**
+     * @brief Copy constructor, it must not be called while statistics are accounted
+     * @param other - statistics
      */
-    Statistics(size_t proc_types_count);
+    Statistics(const Statistics& other);
 
     /**
      * @brief iterates by procedures
@@ -62,7 +66,7 @@ struct Statistics
     virtual void for_each_procedure(std::function<void(const BreakdownCounter&, size_t)> on_procedure) const;
 
     /**
-     * @brief iterates by sessions
+     * @brief iterates by sessions in order of their appearance
      * @param on_session - callback
      */
     virtual void for_each_session(std::function<void(const Session&)> on_session) const;
@@ -74,11 +78,40 @@ struct Statistics
      */
     virtual void for_each_procedure_in_session(const Session& session, std::function<void(const BreakdownCounter&, size_t)> on_procedure) const;
 
+    /**
+     * @brief iterates by hosts of enabled dimension in order of their appearance
+     * @param dimension - dimension of rollup
+     * @param on_host - callback
+     */
+    virtual void for_each_host(Dimension dimension, std::function<void(const Host&)> on_host) const;
+
+    /**
+     * @brief iterates by procedure in rollup of specific host
+     * @param dimension - dimension of rollup
+     * @param host - specific host
+     * @param on_procedure - callback
+     */
+    virtual void for_each_procedure_in_host(Dimension dimension, const Host& host, std::function<void(const BreakdownCounter&, size_t)> on_procedure) const;
+
     /**
      * @brief checks is sessions are present
      */
     virtual bool has_session() const;
 
+    /**
+     * @brief iterates by procedures within recent window, it may be called while statistics are accounted
+     * @param window - index of window in window_spans
+     * @param on_procedure - callback
+     */
+    void for_each_procedure_in_window(size_t window, std::function<void(const WindowCounter&, const Histogram&, size_t)> on_procedure) const;
+
+    /**
+     * @brief iterates by sessions active within recent window, it may be called while statistics are accounted
+     * @param window - index of window in window_spans
+     * @param on_session - callback
+     */
+    void for_each_session_in_window(size_t window, std::function<void(const Session&, const WindowCounter&)> on_session) const;
+
     /**
      * Saves statistics on commands receive
      * @param proc - command
@@ -88,21 +121,25 @@ struct Statistics
     template <typename Cmd, typename Code>
     void account(const Cmd* proc, Code cmd_code)
     {
-        timeval        latency{0, 0};
         const int      cmd_index = static_cast<int>(cmd_code);
         const Session& session   = *proc->session;
 
-        // diff between 'reply' and 'call' timestamps
-        timersub(proc->rtimestamp, proc->ctimestamp, &latency);
+        // diff between 'reply' and 'call' timestamps in nanoseconds
+        const uint64_t latency = proc->reply_time > proc->call_time ? proc->reply_time - proc->call_time : 0;
 
-        account(cmd_index, session, latency);
+        account(cmd_index, session, proc->reply_time, latency);
     }
 
 protected:
-    void account(const int cmd_index, const Session& session, const timeval latency);
+    void account(const int cmd_index, const Session& session, const int64_t time, const uint64_t latency);
 
     BreakdownCounter     counter;                //!< Statistics for all sessions
     PerSessionStatistics per_session_statistics; //!< Statistics for each session
+    std::array<RollupTable, dimensions_count> rollups; //!< Statistics for each host of enabled dimensions
+
+    std::vector<Window<ProceduresSlice>> recent;       //!< Rolling windows for all sessions
+    int64_t                              last_time{0}; //!< Latest timestamp of reply, windows end at it
+    mutable std::mutex                   lock;         //!< Guards statistics against queries of windows
 };
 
 } // namespace breakdown
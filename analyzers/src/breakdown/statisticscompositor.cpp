@@ -30,12 +30,17 @@ StatisticsCompositor::StatisticsCompositor(Statistics& procedures_stats, Statist
     , procedures_stats(procedures_stats)
 {
     procedures_stats.for_each_session([&](const Session& session) {
-        auto i = per_session_statistics.find(session);
-        if(i == per_session_statistics.end())
+        if(per_session_statistics.find(session) == nullptr)
         {
-            per_session_statistics.emplace(session, BreakdownCounter{proc_types_count});
+            per_session_statistics.emplace(session, proc_types_count);
         }
     });
+    for(size_t d = 0; d < dimensions_count; ++d)
+    {
+        procedures_stats.for_each_host(static_cast<Dimension>(d), [&](const Host& host) {
+            rollups[d].resolve(host, proc_types_count);
+        });
+    }
 }
 
 void StatisticsCompositor::for_each_procedure(std::function<void(const BreakdownCounter&, size_t)> on_procedure) const
@@ -68,10 +73,37 @@ void StatisticsCompositor::for_each_procedure_in_session(const Session& session,
         }
     }
 
-    const BreakdownCounter& current = per_session_statistics.at(session);
+    const SessionsTable::Entry* current = per_session_statistics.find(session);
+    assert(current != nullptr);
+    for(size_t procedure = procedures_stats.proc_types_count; procedure < proc_types_count; ++procedure)
+    {
+        on_procedure(current->counter, procedure);
+    }
+}
+
+void StatisticsCompositor::for_each_procedure_in_host(Dimension dimension, const Host& host, std::function<void(const BreakdownCounter&, size_t)> on_procedure) const
+{
+    bool has_procedures_in_host = false;
+
+    procedures_stats.for_each_procedure_in_host(dimension, host, [&](const BreakdownCounter& breakdown, size_t proc) {
+        on_procedure(breakdown, proc);
+        has_procedures_in_host = true;
+    });
+
+    if(!has_procedures_in_host)
+    {
+        BreakdownCounter empty(procedures_stats.proc_types_count);
+        for(size_t procedure = 0; procedure < procedures_stats.proc_types_count; ++procedure)
+        {
+            on_procedure(empty, procedure);
+        }
+    }
+
+    const RollupTable::Entry* current = rollups[static_cast<size_t>(dimension)].find(host);
+    assert(current != nullptr);
     for(size_t procedure = procedures_stats.proc_types_count; procedure < proc_types_count; ++procedure)
     {
-        on_procedure(current, procedure);
+        on_procedure(current->counter, procedure);
     }
 }
 
@@ -40,6 +40,7 @@ public:
     StatisticsCompositor(Statistics& procedures_stats, Statistics& operations_stats);
     void for_each_procedure(std::function<void(const BreakdownCounter&, size_t)> on_procedure) const override;
     void for_each_procedure_in_session(const Session& session, std::function<void(const BreakdownCounter&, size_t)> on_procedure) const override;
+    void for_each_procedure_in_host(Dimension dimension, const Host& host, std::function<void(const BreakdownCounter&, size_t)> on_procedure) const override;
     bool has_session() const override;
 };
 
@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Rolling windows of recent statistics
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include "windows.h"
+//------------------------------------------------------------------------------
+using namespace NST::breakdown;
+//------------------------------------------------------------------------------
+const WindowSpan NST::breakdown::window_spans[windows_count] = {
+    {"1s", 100000000LL, 10},
+    {"10s", 1000000000LL, 10},
+    {"60s", 5000000000LL, 12},
+    {"15m", 60000000000LL, 15},
+};
+
+ProceduresSlice::ProceduresSlice(size_t proc_types_count)
+    : counters(proc_types_count)
+    , histograms(proc_types_count)
+{
+}
+
+void ProceduresSlice::clear()
+{
+    for(auto& c : counters)
+    {
+        c.clear();
+    }
+    for(auto& h : histograms)
+    {
+        h.clear();
+    }
+}
+//------------------------------------------------------------------------------
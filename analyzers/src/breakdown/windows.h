@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Rolling windows of recent statistics
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef WINDOWS_H
+#define WINDOWS_H
+//------------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "histogram.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace breakdown
+{
+/*!
+ * \brief WindowSpan describes rolling window as a ring of slices
+ */
+struct WindowSpan
+{
+    const char* name;   //!< Length of window, f.e. "10s"
+    int64_t     slice;  //!< Length of slice in nanoseconds
+    unsigned    slices; //!< Amount of slices in the ring
+};
+
+static const size_t windows_count = 4;
+
+//! 1s, 10s, 60s and 15m windows
+extern const WindowSpan window_spans[windows_count];
+
+/*!
+ * \brief WindowCounter counts operations and their latencies within slice of window
+ */
+struct WindowCounter
+{
+    uint64_t count{0};
+    uint64_t latency{0}; //!< Sum of latencies in nanoseconds
+    uint64_t max{0};     //!< Maximal latency in nanoseconds
+
+    inline void add(uint64_t ns)
+    {
+        ++count;
+        latency += ns;
+        if(ns > max) max = ns;
+    }
+
+    inline void merge(const WindowCounter& other)
+    {
+        count += other.count;
+        latency += other.latency;
+        if(other.max > max) max = other.max;
+    }
+
+    inline void clear() { *this = WindowCounter{}; }
+
+    //! Average latency in seconds
+    inline double get_avg() const { return count ? latency / 1e9 / count : 0; }
+};
+
+/*!
+ * \brief ProceduresSlice keeps counters and latency histograms of procedures within slice of window
+ */
+struct ProceduresSlice
+{
+    explicit ProceduresSlice(size_t proc_types_count);
+
+    void clear();
+
+    std::vector<WindowCounter> counters;
+    std::vector<Histogram>     histograms;
+};
+
+/*!
+ * \brief Window is a ring of slices of recent statistics
+ * Slices are numbered by timestamps of packets. Slice of new number replaces
+ * the oldest one in the ring, so the window is rotated without timers.
+ */
+template <typename Slice>
+class Window
+{
+public:
+    Window(const WindowSpan& s, const Slice& empty)
+        : span(&s)
+        , slices(s.slices, empty)
+        , numbers(s.slices, -1)
+    {
+    }
+
+    /*!
+     * \brief slice Gets slice of time, the oldest slice is cleared and reused for new one
+     * \param time - timestamp in nanoseconds since Epoch
+     * \return slice or nullptr if slice of time has already been replaced by later one
+     */
+    Slice* slice(int64_t time)
+    {
+        const int64_t number = time / span->slice;
+        const size_t  i      = static_cast<size_t>(number % span->slices);
+        if(numbers[i] != number)
+        {
+            if(numbers[i] > number)
+            {
+                return nullptr;
+            }
+            slices[i].clear();
+            numbers[i] = number;
+        }
+        return &slices[i];
+    }
+
+    /*!
+     * \brief for_each_slice iterates by slices of window which ends at time
+     * \param time - end of window in nanoseconds since Epoch
+     * \param on_slice - callback
+     */
+    template <typename Callback>
+    void for_each_slice(int64_t time, Callback on_slice) const
+    {
+        const int64_t last = time / span->slice;
+        for(size_t i = 0; i < slices.size(); ++i)
+        {
+            if(numbers[i] <= last && numbers[i] > last - span->slices)
+            {
+                on_slice(slices[i]);
+            }
+        }
+    }
+
+private:
+    const WindowSpan*    span;
+    std::vector<Slice>   slices;
+    std::vector<int64_t> numbers; //!< Numbers of slices, -1 for unused one
+};
+
+/*!
+ * \brief make_windows Creates windows of all spans
+ * \param empty - empty slice
+ * \return windows in order of window_spans
+ */
+template <typename Slice>
+std::vector<Window<Slice>> make_windows(const Slice& empty)
+{
+    std::vector<Window<Slice>> windows;
+    windows.reserve(windows_count);
+    for(const auto& span : window_spans)
+    {
+        windows.emplace_back(span, empty);
+    }
+    return windows;
+}
+
+} // namespace breakdown
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // WINDOWS_H
+//------------------------------------------------------------------------------
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Analyzer which exports all operations to columnar files
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <api/plugin_api.h> // include plugin development definitions
+#include <zlib.h>
+
+#include "columns_writer.h"
+//------------------------------------------------------------------------------
+static constexpr const char* DefaultPath{"nfstrace-columns"};
+static constexpr uint32_t    DefaultBlockRows{65536};
+static constexpr int         DefaultLevel{Z_BEST_SPEED};
+//------------------------------------------------------------------------------
+/*! Writes records to columns.
+ * It is asynchronous analyzer, so records are encoded and compressed
+ * by its own thread and parser threads only copy batches of records.
+ */
+class ColumnsAnalyzer : public IAnalyzer
+{
+public:
+    ColumnsAnalyzer(const std::string& path, uint32_t block_rows, int level)
+        : writer{path, block_rows, level}
+    {
+    }
+
+    void records(const OpRecord* batch, std::size_t count) override final
+    {
+        for(const OpRecord* r = batch; r != batch + count; ++r)
+        {
+            writer.append(*r);
+        }
+    }
+
+    void flush_statistics() override final
+    {
+        writer.flush();
+        std::cout << "### Columns analyzer ###" << std::endl
+                  << "Exported operations: " << writer.rows() << std::endl;
+    }
+
+private:
+    columns::ColumnsWriter writer;
+};
+
+extern "C" {
+
+const char* usage()
+{
+    return "path - Directory of columns (default is nfstrace-columns), its files are rewritten\n"
+           "rows - Amount of rows in each compressed block (default is 65536)\n"
+           "level - Compression level of zlib 1..9 (default is 1)";
+}
+
+IAnalyzer* create(const char* opts)
+{
+    std::string path{DefaultPath};
+    uint32_t    rows{DefaultBlockRows};
+    int         level{DefaultLevel};
+
+    enum
+    {
+        PATH_SUBOPT_INDEX = 0,
+        ROWS_SUBOPT_INDEX,
+        LEVEL_SUBOPT_INDEX
+    };
+    char        pathSubOptName[]  = "path";
+    char        rowsSubOptName[]  = "rows";
+    char        levelSubOptName[] = "level";
+    char* const tokens[] =
+        {
+            pathSubOptName,
+            rowsSubOptName,
+            levelSubOptName,
+            NULL};
+    std::size_t       optsLen = strlen(opts);
+    std::vector<char> optsBuf{opts, opts + optsLen + 2};
+    char*             optionp = &optsBuf[0];
+    char*             valuep;
+    int               optIndex;
+    while((optIndex = getsubopt(&optionp, tokens, &valuep)) >= 0)
+    {
+        try
+        {
+            switch(optIndex)
+            {
+            case PATH_SUBOPT_INDEX:
+                path = valuep;
+                break;
+            case ROWS_SUBOPT_INDEX:
+                rows = std::stoul(valuep);
+                break;
+            case LEVEL_SUBOPT_INDEX:
+                level = std::stoi(valuep);
+                break;
+            }
+        }
+        catch(std::logic_error& e)
+        {
+            throw std::runtime_error{std::string{"Invalid value provided for '"} + tokens[optIndex] + "' suboption"};
+        }
+    }
+    if(rows == 0 || level < Z_BEST_SPEED || level > Z_BEST_COMPRESSION)
+    {
+        throw std::runtime_error{"Invalid amount of rows or compression level"};
+    }
+    return new ColumnsAnalyzer{path, rows, level};
+}
+
+void destroy(IAnalyzer* instance)
+{
+    delete instance;
+}
+
+const AnalyzerRequirements* requirements()
+{
+    // every operation is exported, so parser threads wait for the writer instead of dropping records
+    AnalyzerSubscription records{false};
+    records.records = true;
+    static const AnalyzerRequirements requirements{false, records, AnalyzerThreading::Asynchronous, AnalyzerOverflow::Block};
+    return &requirements;
+}
+
+NST_PLUGIN_ENTRY_POINTS(&usage, &create, &destroy, &requirements)
+
+} //extern "C"
+//------------------------------------------------------------------------------
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Layout of columnar export of operation records
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef COLUMNS_FORMAT_H
+#define COLUMNS_FORMAT_H
+//------------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <string>
+//------------------------------------------------------------------------------
+/*! Export is a directory with files:
+ *  columns.meta     - text "key value" lines: version, rows, blocks, block_rows
+ *  sessions.dict    - uint64_t hashes of sessions, value of session column is index in it
+ *  procedures.dict  - text lines "index protocol procedure name", procedure column refers to them
+ *  <column>.col     - zlib-compressed blocks of column values one after another
+ *  <column>.idx     - BlockIndex for each block of <column>.col
+ * Rows are split to blocks, each block of a column is decoded independently.
+ */
+namespace columns
+{
+constexpr unsigned version{1};
+
+//! Columns of export, values of all of them are unsigned 64-bit integers
+enum Column : unsigned
+{
+    CallTime = 0, //!< Nanoseconds since Epoch, stored as zigzag delta to previous row of block
+    Latency,      //!< Nanoseconds between call and reply
+    Session,      //!< Index in sessions.dict
+    Procedure,    //!< Index in procedures.dict
+    Operation,    //!< NFSv4.x operation carrying I/O
+    Status,
+    Id,
+    CallSize,
+    ReplySize,
+    FileHandle, //!< Hash of file handle, stored as fixed 8 bytes
+    Offset,
+    Count,
+    count
+};
+
+inline const char* name(Column c)
+{
+    static const char* const names[Column::count] = {
+        "call_time", "latency", "session", "procedure", "operation", "status",
+        "id", "call_size", "reply_size", "fh", "offset", "count"};
+    return names[c];
+}
+
+//! Entry of <column>.idx, min and max allow to skip blocks without reading them
+struct BlockIndex
+{
+    uint64_t offset; //!< Offset of compressed block in <column>.col
+    uint32_t size;   //!< Size of compressed block
+    uint32_t raw;    //!< Size of encoded block before compression
+    uint32_t rows;   //!< Amount of values in the block
+    uint32_t reserved;
+    uint64_t min; //!< Minimal value of column in the block
+    uint64_t max; //!< Maximal value of column in the block
+} __attribute__((__packed__));
+
+static_assert(sizeof(BlockIndex) == 40, "BlockIndex is stored in files");
+
+inline void put_varint(std::string& out, uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+//! Reads varint, returns nullptr if it exceeds end
+inline const uint8_t* get_varint(const uint8_t* it, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for(unsigned shift = 0; it != end && shift < 64; shift += 7)
+    {
+        const uint8_t byte{*it++};
+        value |= uint64_t{byte & 0x7fU} << shift;
+        if(!(byte & 0x80))
+        {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+inline uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace columns
+//------------------------------------------------------------------------------
+#endif // COLUMNS_FORMAT_H
+//------------------------------------------------------------------------------
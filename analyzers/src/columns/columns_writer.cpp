@@ -0,0 +1,291 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Writer of columnar export of operation records
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <zlib.h>
+
+#include <api/plugin_api.h>
+
+#include "columns_writer.h"
+//------------------------------------------------------------------------------
+namespace columns
+{
+//! Name of procedure for procedures.dict
+static const char* procedure_name(Protocol protocol, uint32_t procedure)
+{
+    switch(protocol)
+    {
+    case Protocol::NFSv3:
+        return print_nfs3_procedures(static_cast<ProcEnumNFS3::NFSProcedure>(procedure));
+    case Protocol::NFSv40:
+        return print_nfs4_procedures(static_cast<ProcEnumNFS4::NFSProcedure>(procedure));
+    case Protocol::NFSv41:
+        return print_nfs41_procedures(static_cast<ProcEnumNFS41::NFSProcedure>(procedure));
+    case Protocol::SMBv1:
+        return print_cifs1_procedures(static_cast<SMBv1::SMBv1Commands>(procedure));
+    case Protocol::SMBv2:
+        return print_cifs2_procedures(static_cast<SMBv2::SMBv2Commands>(procedure));
+    }
+    return "UNKNOWN";
+}
+
+ColumnsWriter::ColumnsWriter(const std::string& d, uint32_t rows, int l)
+    : directory{d}
+    , block_rows{rows ? rows : 1}
+    , level{l}
+{
+    if(mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST)
+    {
+        throw std::system_error{errno, std::system_category(), {"Error in creating directory: " + directory}};
+    }
+
+    for(unsigned i = 0; i < Column::count; ++i)
+    {
+        const std::string path{directory + '/' + name(Column(i))};
+        File&             file = files[i];
+        file.data.open(path + ".col", std::ios::binary | std::ios::trunc);
+        file.index.open(path + ".idx", std::ios::binary | std::ios::trunc);
+        if(!file.data || !file.index)
+        {
+            throw std::runtime_error{"Error in creating column: " + path};
+        }
+        file.block.reserve(block_rows * 4);
+    }
+    sessions_dict.open(directory + "/sessions.dict", std::ios::binary | std::ios::trunc);
+    procedures_dict.open(directory + "/procedures.dict", std::ios::trunc);
+    checkpoint();
+}
+
+ColumnsWriter::~ColumnsWriter()
+{
+    try
+    {
+        flush();
+    }
+    catch(std::runtime_error& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void ColumnsWriter::append(const NST::API::OpRecord& record)
+{
+    if(block_size == 0)
+    {
+        previous = 0; // each block is decoded independently
+        for(File& file : files)
+        {
+            file.min = UINT64_MAX;
+            file.max = 0;
+        }
+    }
+
+    const uint64_t call_time{record.call_time};
+    const uint64_t reply_time{record.reply_time};
+
+    put(Column::CallTime, call_time);
+    put(Column::Latency, reply_time > call_time ? reply_time - call_time : 0);
+    put(Column::Session, session(record.session));
+    put(Column::Procedure, procedure(record.protocol, record.procedure));
+    put(Column::Operation, record.operation);
+    put(Column::Status, record.status);
+    put(Column::Id, record.id);
+    put(Column::CallSize, record.call_size);
+    put(Column::ReplySize, record.reply_size);
+    put_fixed(Column::FileHandle, record.fh);
+    put(Column::Offset, record.offset);
+    put(Column::Count, record.count);
+
+    ++total;
+    if(++block_size == block_rows)
+    {
+        write_block();
+        if(blocks % checkpoint_blocks == 0)
+        {
+            checkpoint();
+        }
+    }
+}
+
+void ColumnsWriter::flush()
+{
+    write_block();
+    checkpoint();
+}
+
+void ColumnsWriter::write_block()
+{
+    if(block_size == 0)
+    {
+        return;
+    }
+
+    for(File& file : files)
+    {
+        uLongf size{compressBound(file.block.size())};
+        compressed.resize(size);
+        if(compress2(reinterpret_cast<Bytef*>(&compressed[0]), &size,
+                     reinterpret_cast<const Bytef*>(file.block.data()), file.block.size(), level) != Z_OK)
+        {
+            throw std::runtime_error{"Error in compression of block of " + directory};
+        }
+
+        BlockIndex index;
+        index.offset   = file.offset;
+        index.size     = size;
+        index.raw      = file.block.size();
+        index.rows     = block_size;
+        index.reserved = 0;
+        index.min      = file.min;
+        index.max      = file.max;
+
+        file.data.write(compressed.data(), size);
+        file.index.write(reinterpret_cast<const char*>(&index), sizeof(index));
+        if(!file.data || !file.index)
+        {
+            throw std::runtime_error{"Error in writing block of " + directory};
+        }
+        file.offset += size;
+        file.block.clear();
+    }
+
+    ++blocks;
+    block_size = 0;
+    append_dictionaries();
+}
+
+void ColumnsWriter::put(Column column, uint64_t value)
+{
+    File& file = files[column];
+    if(value < file.min) file.min = value;
+    if(value > file.max) file.max = value;
+
+    if(column == Column::CallTime) // min and max are absolute, records of several parser threads aren't ordered
+    {
+        const uint64_t delta{zigzag(static_cast<int64_t>(value - previous))};
+        previous = value;
+        value    = delta;
+    }
+    put_varint(file.block, value);
+}
+
+void ColumnsWriter::put_fixed(Column column, uint64_t value)
+{
+    File& file = files[column];
+    if(value < file.min) file.min = value;
+    if(value > file.max) file.max = value;
+
+    for(unsigned i = 0; i < sizeof(value); ++i) // little-endian
+    {
+        file.block.push_back(static_cast<char>(value >> (i * 8)));
+    }
+}
+
+uint32_t ColumnsWriter::session(uint64_t hash)
+{
+    auto i = session_indexes.emplace(hash, sessions.size());
+    if(i.second)
+    {
+        sessions.push_back(hash);
+    }
+    return i.first->second;
+}
+
+uint32_t ColumnsWriter::procedure(Protocol protocol, uint32_t procedure)
+{
+    const uint64_t key{uint64_t(protocol) << 32 | procedure};
+    auto           i = procedure_indexes.emplace(key, procedures.size());
+    if(i.second)
+    {
+        procedures.push_back(key);
+    }
+    return i.first->second;
+}
+
+//! Appends entries added since previous block, dictionaries only grow
+void ColumnsWriter::append_dictionaries()
+{
+    sessions_dict.write(reinterpret_cast<const char*>(sessions.data() + written_sessions),
+                        (sessions.size() - written_sessions) * sizeof(uint64_t));
+    written_sessions = sessions.size();
+
+    for(; written_procedures < procedures.size(); ++written_procedures)
+    {
+        const Protocol protocol{static_cast<Protocol>(procedures[written_procedures] >> 32)};
+        const uint32_t procedure{static_cast<uint32_t>(procedures[written_procedures])};
+        procedures_dict << written_procedures << ' ' << unsigned(protocol) << ' ' << procedure << ' '
+                        << procedure_name(protocol, procedure) << '\n';
+    }
+
+    if(!sessions_dict || !procedures_dict)
+    {
+        throw std::runtime_error{"Error in writing dictionaries of " + directory};
+    }
+}
+
+//! Flushes columns and dictionaries, then meta makes their blocks visible to readers
+/*! Meta is written to a temporary file and renamed over the previous one,
+ * so readers see either of them complete.
+ */
+void ColumnsWriter::checkpoint()
+{
+    for(File& file : files)
+    {
+        file.data.flush();
+        file.index.flush();
+        if(!file.data || !file.index)
+        {
+            throw std::runtime_error{"Error in writing block of " + directory};
+        }
+    }
+    sessions_dict.flush();
+    procedures_dict.flush();
+
+    if(!sessions_dict || !procedures_dict)
+    {
+        throw std::runtime_error{"Error in writing dictionaries of " + directory};
+    }
+
+    const std::string path{directory + "/columns.meta"};
+    std::ofstream     meta{path + ".tmp", std::ios::trunc};
+    meta << "version " << version << '\n'
+         << "rows " << total - block_size << '\n'
+         << "blocks " << blocks << '\n'
+         << "block_rows " << block_rows << '\n';
+    meta.close();
+    if(!meta)
+    {
+        throw std::runtime_error{"Error in writing meta of " + directory};
+    }
+    if(std::rename((path + ".tmp").c_str(), path.c_str()) != 0)
+    {
+        throw std::system_error{errno, std::system_category(), "Error in renaming meta of " + directory};
+    }
+}
+
+} // namespace columns
+//------------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Writer of columnar export of operation records
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef COLUMNS_WRITER_H
+#define COLUMNS_WRITER_H
+//------------------------------------------------------------------------------
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <api/op_record.h>
+
+#include "columns_format.h"
+//------------------------------------------------------------------------------
+namespace columns
+{
+/*! Encodes records to blocks of columns and appends compressed blocks to files.
+ * New entries of dictionaries are appended after each block. Streams are
+ * flushed and meta is rewritten at checkpoints, every checkpoint_blocks
+ * blocks and by flush(), so files written before crash of nfstrace remain
+ * readable up to the last checkpoint.
+ */
+class ColumnsWriter
+{
+public:
+    static constexpr uint32_t checkpoint_blocks{16}; //!< Blocks between checkpoints
+
+    /*! Creates directory of export, files of previous export are truncated
+     * \param directory - path to directory of export
+     * \param block_rows - amount of rows in each block
+     * \param level - zlib compression level
+     */
+    ColumnsWriter(const std::string& directory, uint32_t block_rows, int level);
+    ~ColumnsWriter();
+    ColumnsWriter(const ColumnsWriter&) = delete;
+    ColumnsWriter& operator=(const ColumnsWriter&) = delete;
+
+    void append(const NST::API::OpRecord& record);
+
+    //! Writes incomplete block and makes checkpoint
+    void flush();
+
+    uint64_t rows() const { return total; }
+private:
+    struct File
+    {
+        std::ofstream data;
+        std::ofstream index;
+        std::string   block; // encoded values of current block
+        uint64_t      offset{0};
+        uint64_t      min;
+        uint64_t      max;
+    };
+
+    void put(Column column, uint64_t value);
+    void put_fixed(Column column, uint64_t value);
+    uint32_t session(uint64_t hash);
+    uint32_t procedure(NST::API::Protocol protocol, uint32_t procedure);
+    void write_block();
+    void append_dictionaries();
+    void checkpoint();
+
+    const std::string directory;
+    const uint32_t    block_rows;
+    const int         level;
+
+    File          files[Column::count];
+    std::ofstream sessions_dict;
+    std::ofstream procedures_dict;
+    std::string   compressed;
+    uint32_t    block_size{0}; // rows in current block
+    uint32_t    blocks{0};
+    uint64_t    total{0};
+    uint64_t    previous{0}; // call time of previous row of block
+
+    std::unordered_map<uint64_t, uint32_t> session_indexes;
+    std::vector<uint64_t>                  sessions;
+    std::unordered_map<uint64_t, uint32_t> procedure_indexes;
+    std::vector<uint64_t>                  procedures; // protocol << 32 | procedure
+    std::size_t                            written_sessions{0};   // entries of sessions.dict
+    std::size_t                            written_procedures{0}; // entries of procedures.dict
+};
+
+} // namespace columns
+//------------------------------------------------------------------------------
+#endif // COLUMNS_WRITER_H
+//------------------------------------------------------------------------------
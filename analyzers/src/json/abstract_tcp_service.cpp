@@ -19,47 +19,45 @@
     along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
 */
 //------------------------------------------------------------------------------
+#include <cerrno>
 #include <cstring>
-#include <functional>
 #include <system_error>
 
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "abstract_tcp_service.h"
 #include "utils/log.h"
 //------------------------------------------------------------------------------
 
-AbstractTcpService::AbstractTcpService(std::size_t workersAmount, int port, const std::string& host, int backlog)
+AbstractTcpService::AbstractTcpService(std::size_t loopsAmount, int port, const std::string& host,
+                                       std::size_t maxServingDurationMs, int backlog,
+                                       std::size_t keepAliveTimeoutMs, std::size_t maxConnections)
     : _port{port}
     , _host{host}
     , _backlog{backlog}
+    , _maxServingDurationMs{maxServingDurationMs}
+    , _keepAliveTimeoutMs{keepAliveTimeoutMs}
+    , _maxConnections{maxConnections}
     , _isRunning{true}
-    , _threadPool{workersAmount}
-    , _listenerThread{}
-    , _serverSocket{0}
-    , _tasksQueue{}
-    , _tasksQueueMutex{}
-    , _tasksQueueCond{}
+    , _connectionsAmount{0}
+    , _loops{loopsAmount}
+    , _serverSocket{-1}
 {
 }
 
 AbstractTcpService::~AbstractTcpService()
 {
-    // Disposing tasks which are still in queue
-    while(!_tasksQueue.empty())
-    {
-        delete _tasksQueue.front();
-        _tasksQueue.pop();
-    }
 }
 
 void AbstractTcpService::start()
 {
     _isRunning = true;
-    // Setting up server TCP-socket
-    _serverSocket = socket(PF_INET, SOCK_STREAM, 0);
+    // Setting up non-blocking server TCP-socket, it is shared by event loops
+    _serverSocket = socket(PF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
     if(_serverSocket < 0)
     {
         throw std::system_error{errno, std::system_category(), "Opening server socket error"};
@@ -81,126 +79,319 @@ void AbstractTcpService::start()
     {
         throw std::system_error{errno, std::system_category(), "Converting socket to listening state error"};
     }
-    // Creating threads for thread-pool
-    for(auto& thr : _threadPool)
+    // Creating threads of event loops
+    for(auto& thr : _loops)
     {
-        thr = std::thread{&AbstractTcpService::runWorker, this};
+        thr = std::thread{&AbstractTcpService::runLoop, this};
     }
-    _listenerThread = std::thread{&AbstractTcpService::runListener, this};
 }
 
 void AbstractTcpService::stop()
 {
-    {
-        // Waking up all awaiting threads
-        std::unique_lock<std::mutex> lock{_tasksQueueMutex};
-        _isRunning = false;
-        _tasksQueueCond.notify_all();
-    }
-    // Joining to thread-pool threads and disposing them
-    for(auto& thr : _threadPool)
+    // Event loops check the flag at least once per ClockTimeoutMs
+    _isRunning = false;
+    for(auto& thr : _loops)
     {
         thr.join();
     }
-    // Joining to listener thread and closing server socket
-    _listenerThread.join();
     close(_serverSocket);
 }
 
-void AbstractTcpService::runWorker()
+void AbstractTcpService::runLoop()
 {
-    while(true)
+    int epoll = epoll_create1(0);
+    if(epoll < 0)
+    {
+        std::system_error e{errno, std::system_category(), "Creating epoll instance error"};
+        LOG("ERROR: %s", e.what());
+        return;
+    }
+    struct epoll_event serverEvent;
+    memset(&serverEvent, 0, sizeof serverEvent);
+    serverEvent.events = EPOLLIN;
+#ifdef EPOLLEXCLUSIVE
+    // Only one of event loops is woken up by incoming connection
+    serverEvent.events |= EPOLLEXCLUSIVE;
+#endif
+    serverEvent.data.ptr = nullptr;
+    if(epoll_ctl(epoll, EPOLL_CTL_ADD, _serverSocket, &serverEvent) != 0)
     {
-        std::unique_ptr<AbstractTask> pendingTask;
+        std::system_error e{errno, std::system_category(), "Adding server socket to epoll instance error"};
+        LOG("ERROR: %s", e.what());
+        close(epoll);
+        return;
+    }
+
+    Connections        connections;
+    struct epoll_event events[MaxEvents];
+    while(_isRunning.load())
+    {
+        int eventsCount = epoll_wait(epoll, events, MaxEvents, ClockTimeoutMs);
+        if(eventsCount < 0)
         {
-            std::unique_lock<std::mutex> lock{_tasksQueueMutex};
-            while(!pendingTask)
+            // epoll_wait(2) is interrupted by signals if drop privileges option is used on Linux
+            if(errno == EINTR)
             {
-                if(!_isRunning.load())
-                {
-                    return;
-                }
-                if(!_tasksQueue.empty())
-                {
-                    pendingTask.reset(_tasksQueue.front());
-                    _tasksQueue.pop();
-                }
-                else
+                continue;
+            }
+            std::system_error e{errno, std::system_category(), "Awaiting for events of sockets error"};
+            LOG("ERROR: %s", e.what());
+            break;
+        }
+        for(int i = 0; i < eventsCount; ++i)
+        {
+            Connection* connection = static_cast<Connection*>(events[i].data.ptr);
+            if(connection == nullptr)
+            {
+                acceptConnections(epoll, connections);
+                continue;
+            }
+            if((events[i].events & (EPOLLERR | EPOLLHUP)) || !serve(epoll, *connection, events[i].events & EPOLLIN))
+            {
+                connections.erase(connection->socket);
+                --_connectionsAmount;
+            }
+        }
+        // Closing idle and too slow connections
+        const Clock::time_point now = Clock::now();
+        for(auto i = connections.begin(); i != connections.end();)
+        {
+            if(i->second->deadline < now)
+            {
+                if(!i->second->input.empty() || !i->second->output.empty())
                 {
-                    _tasksQueueCond.wait(lock);
+                    LOG("WARNING: A client is too slow - closing connection");
                 }
+                i = connections.erase(i);
+                --_connectionsAmount;
+            }
+            else
+            {
+                ++i;
             }
         }
-        pendingTask->execute();
     }
+    _connectionsAmount -= connections.size();
+    connections.clear();
+    close(epoll);
 }
 
-void AbstractTcpService::runListener()
+void AbstractTcpService::acceptConnections(int epoll, Connections& connections)
 {
-    while(_isRunning.load())
+    while(true)
     {
-        // Accepting incoming connection on socket
-        struct timespec acceptDuration;
-        fillDuration(acceptDuration);
-        fd_set readDescriptorsSet;
-        FD_ZERO(&readDescriptorsSet);
-        FD_SET(_serverSocket, &readDescriptorsSet);
-        int descriptorsCount = pselect(_serverSocket + 1, &readDescriptorsSet, NULL, NULL, &acceptDuration, NULL);
-        if(descriptorsCount == 0)
-        {
-            // Timeout expired
+        int pendingSocketDescriptor = accept4(_serverSocket, NULL, NULL, SOCK_NONBLOCK);
+        if(pendingSocketDescriptor < 0)
+        {
+            if(errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            if(errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                std::system_error e{errno, std::system_category(), "Accepting incoming connection on server socket error"};
+                LOG("ERROR: %s", e.what());
+            }
+            return;
+        }
+        std::unique_ptr<Connection> connection{new Connection{pendingSocketDescriptor}};
+        if(_connectionsAmount.load() >= _maxConnections)
+        {
+            LOG("WARNING: TCP-service connections limit has been reached");
             continue;
         }
-        else if(descriptorsCount < 0)
+        connection->deadline = Clock::now() + std::chrono::milliseconds{_keepAliveTimeoutMs};
+
+        struct epoll_event event;
+        memset(&event, 0, sizeof event);
+        event.events   = EPOLLIN | EPOLLRDHUP;
+        event.data.ptr = connection.get();
+        if(epoll_ctl(epoll, EPOLL_CTL_ADD, pendingSocketDescriptor, &event) != 0)
         {
-            std::system_error e{errno, std::system_category(), "Awaiting for incoming connection on server socket error"};
+            std::system_error e{errno, std::system_category(), "Adding connection to epoll instance error"};
             LOG("ERROR: %s", e.what());
-#ifdef __gnu_linux__
-            // Several first pselect(2) calls cause "Interrupted system call" error (errno == EINTR)
-            // if drop privileges option is used on Linux (see https://access.redhat.com/solutions/165483)
-            if(errno == EINTR)
+            continue;
+        }
+        ++_connectionsAmount;
+        connections.emplace(pendingSocketDescriptor, std::move(connection));
+    }
+}
+
+bool AbstractTcpService::serve(int epoll, Connection& connection, bool readable)
+{
+    while(readable && !connection.peerClosed)
+    {
+        char    buffer[ReadBufferSize];
+        ssize_t bytesReceived = recv(connection.socket, buffer, sizeof(buffer), 0);
+        if(bytesReceived > 0)
+        {
+            if(connection.input.empty() && connection.output.empty())
             {
-                continue;
+                // Request is started, it should be served in time
+                connection.deadline = Clock::now() + std::chrono::milliseconds{_maxServingDurationMs};
+            }
+            connection.input.append(buffer, bytesReceived);
+            if(connection.input.size() > MaxRequestSize)
+            {
+                LOG("WARNING: Request of client is too large - closing connection");
+                return false;
             }
-#endif
-            throw e;
         }
-        // Extracting and returning pending connection
-        int pendingSocketDescriptor = accept(_serverSocket, NULL, NULL);
-        if(pendingSocketDescriptor < 0)
+        else if(bytesReceived == 0)
         {
-            std::system_error e{errno, std::system_category(), "Accepting incoming connection on server socket error"};
-            LOG("ERROR: %s", e.what());
-            throw e;
+            // Client has shut down sending (f.e. shutdown(SHUT_WR)), received requests are answered before closing
+            connection.peerClosed = true;
+            connection.writing    = false; // socket is watched for sending only from now, see flush()
+            break;
+        }
+        else if(errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
         }
-        // Create and enqueue task
-        std::unique_ptr<AbstractTask> newTask{createTask(pendingSocketDescriptor)};
+        else if(errno != EINTR)
+        {
+            std::system_error e{errno, std::system_category(), "Receiving data from client error"};
+            LOG("WARNING: %s", e.what());
+            return false;
+        }
+    }
+    try
+    {
+        return flush(epoll, connection);
+    }
+    catch(const std::exception& e)
+    {
+        LOG("ERROR: Serving of client has failed: %s", e.what());
+        return false;
+    }
+}
+
+bool AbstractTcpService::flush(int epoll, Connection& connection)
+{
+    while(true)
+    {
+        Output& output = connection.output;
+        while(!output.empty())
         {
-            std::unique_lock<std::mutex> lock(_tasksQueueMutex);
-            if(_tasksQueue.size() < MaxTasksQueueSize)
+            // Buffers are gathered by one call, f.e. header and shared body of response
+            struct iovec iovecs[MaxIovecs];
+            int          iovecsCount = 0;
+            for(auto i = output._buffers.begin(); i != output._buffers.end() && iovecsCount < MaxIovecs; ++i, ++iovecsCount)
             {
-                _tasksQueue.push(newTask.get());
-                newTask.release();
-                _tasksQueueCond.notify_one();
+                const std::size_t offset     = iovecsCount == 0 ? output._sent : 0;
+                iovecs[iovecsCount].iov_base = const_cast<char*>((*i)->data()) + offset;
+                iovecs[iovecsCount].iov_len  = (*i)->size() - offset;
             }
-            else
+            struct msghdr message;
+            memset(&message, 0, sizeof message);
+            message.msg_iov    = iovecs;
+            message.msg_iovlen = iovecsCount;
+            ssize_t bytesSent  = sendmsg(connection.socket, &message, MSG_NOSIGNAL);
+            if(bytesSent >= 0)
+            {
+                std::size_t bytes = bytesSent;
+                while(!output.empty() && output._buffers.front()->size() - output._sent <= bytes)
+                {
+                    bytes -= output._buffers.front()->size() - output._sent;
+                    output._buffers.pop_front();
+                    output._sent = 0;
+                }
+                output._sent += bytes;
+                continue;
+            }
+            if(errno == EINTR)
             {
-                LOG("ERROR: TCP-service tasks queue overload has been detected")
+                continue;
             }
+            if(errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                std::system_error e{errno, std::system_category(), "Sending data to client error"};
+                LOG("WARNING: %s", e.what());
+                return false;
+            }
+            if(!connection.writing)
+            {
+                // Rest of response is sent when socket is ready
+                // Reading of closed socket is always ready, so it isn't watched then
+                struct epoll_event event;
+                memset(&event, 0, sizeof event);
+                event.events   = connection.peerClosed ? EPOLLOUT : EPOLLIN | EPOLLOUT | EPOLLRDHUP;
+                event.data.ptr = &connection;
+                if(epoll_ctl(epoll, EPOLL_CTL_MOD, connection.socket, &event) != 0)
+                {
+                    throw std::system_error{errno, std::system_category(), "Awaiting for sending data availability on socket error"};
+                }
+                connection.writing = true;
+            }
+            return true;
+        }
+        if(connection.writing)
+        {
+            struct epoll_event event;
+            memset(&event, 0, sizeof event);
+            event.events   = EPOLLIN | EPOLLRDHUP;
+            event.data.ptr = &connection;
+            if(epoll_ctl(epoll, EPOLL_CTL_MOD, connection.socket, &event) != 0)
+            {
+                throw std::system_error{errno, std::system_category(), "Awaiting for receiving data on socket error"};
+            }
+            connection.writing = false;
+        }
+        if(!connection.keepAlive)
+        {
+            return false;
+        }
+        if(connection.input.empty())
+        {
+            connection.deadline = Clock::now() + std::chrono::milliseconds{_keepAliveTimeoutMs};
+            return !connection.peerClosed;
+        }
+        std::size_t requestSize = processRequest(connection.input, connection.output, connection.keepAlive);
+        if(requestSize == 0)
+        {
+            // Request is incomplete, its rest never comes if client has shut down sending
+            return !connection.peerClosed;
+        }
+        connection.input.erase(0, requestSize);
+        if(!connection.input.empty())
+        {
+            // Next request is pipelined, it should be served in time too
+            connection.deadline = Clock::now() + std::chrono::milliseconds{_maxServingDurationMs};
         }
     }
 }
 
 //------------------------------------------------------------------------------
 
-AbstractTcpService::AbstractTask::AbstractTask(int socket)
-    : _socket{socket}
+AbstractTcpService::Connection::Connection(int socket)
+    : socket{socket}
+    , input{}
+    , output{}
+    , keepAlive{true}
+    , writing{false}
+    , peerClosed{false}
+    , deadline{}
 {
 }
 
-AbstractTcpService::AbstractTask::~AbstractTask()
+AbstractTcpService::Connection::~Connection()
+{
+    close(socket);
+}
+
+//------------------------------------------------------------------------------
+
+void AbstractTcpService::Output::append(Buffer buffer)
+{
+    if(!buffer->empty())
+    {
+        _buffers.push_back(std::move(buffer));
+    }
+}
+
+void AbstractTcpService::Output::append(const std::string& data)
 {
-    close(_socket);
+    append(std::make_shared<const std::string>(data));
 }
 
 //------------------------------------------------------------------------------
@@ -23,33 +23,43 @@
 #define ABSTRACT_TCP_SERVICE_H
 //------------------------------------------------------------------------------
 #include <atomic>
-#include <mutex>
-#include <queue>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
-#include <condition_variable>
 
 #include "ip_endpoint.h"
 //------------------------------------------------------------------------------
 //! TCP-service
 /*!
- * Abstract task for TCP-service
+ * Connections are served by a few event loops on epoll(7) with non-blocking
+ * I/O, so one thread serves many persistent connections of clients.
  */
 class AbstractTcpService
 {
 public:
-    static constexpr int DefaultBacklog = 15;
+    static constexpr int         DefaultBacklog            = 15;
+    static constexpr std::size_t DefaultKeepAliveTimeoutMs = 5000U;
+    static constexpr std::size_t DefaultMaxConnections     = 1024U;
 
     AbstractTcpService() = delete;
     //! Constructs TCP-service
     /*!
-     * \param workersAmount Amount of workers in thread-pool
+     * \param loopsAmount Amount of event loop threads
      * \param port Port to bind to
      * \param host Hostname/IP-address to listen
+     * \param maxServingDurationMs Max duration of receiving of request and sending of response
      * \param backlog Listen backlog - see listen(2)
+     * \param keepAliveTimeoutMs Max duration of idle persistent connection
+     * \param maxConnections Max amount of connections, the rest are closed after accept(2)
      */
-    AbstractTcpService(std::size_t workersAmount, int port, const std::string& host = IpEndpoint::WildcardAddress,
-                       int backlog = DefaultBacklog);
+    AbstractTcpService(std::size_t loopsAmount, int port, const std::string& host = IpEndpoint::WildcardAddress,
+                       std::size_t maxServingDurationMs = 500U, int backlog = DefaultBacklog,
+                       std::size_t keepAliveTimeoutMs = DefaultKeepAliveTimeoutMs,
+                       std::size_t maxConnections     = DefaultMaxConnections);
     //! Destructs stopped TCP-service
     /*!
      * \note Destruction of non-stopped TCP-service causes undefined behaviour
@@ -61,12 +71,6 @@ public:
     {
         return _isRunning.load();
     }
-    //! Fills 'struct timespec' value using clock timeout
-    inline static void fillDuration(struct timespec& ts)
-    {
-        ts.tv_sec  = ClockTimeoutMs / 1000;
-        ts.tv_nsec = ClockTimeoutMs % 1000 * 1000000;
-    }
 
     //! Starts TCP-service
     virtual void start();
@@ -74,56 +78,89 @@ public:
     virtual void stop();
 
 protected:
-    //! Asbtract TCP-service task
-    class AbstractTask
+    //! Immutable buffer of data, it may be shared by many responses
+    using Buffer = std::shared_ptr<const std::string>;
+
+    //! Data to send to client
+    /*!
+     * Shared buffers are sent as they are, so one pre-rendered response
+     * is sent to many clients without copying.
+     */
+    class Output
     {
     public:
-        //! Constructs TCP-service task
-        /*!
-         * \param socket Socket for I/O
-         */
-        AbstractTask(int socket);
-        AbstractTask() = delete;
-        //! Destructs TCP-service task and closes I/O socket
-        virtual ~AbstractTask();
-
-        //! Returns a socket for I/O
-        inline int socket() const
+        //! Appends shared buffer, it is held until it is sent
+        void append(Buffer buffer);
+        //! Appends copy of data
+        void append(const std::string& data);
+
+        inline bool empty() const
         {
-            return _socket;
+            return _buffers.empty();
         }
 
-        //! Task execution pure virtual method to override
-        virtual void execute() = 0;
-
     private:
-        int _socket;
+        friend class AbstractTcpService;
+
+        std::deque<Buffer> _buffers;
+        std::size_t        _sent{0}; //!< Amount of sent bytes of the first buffer
     };
 
-    virtual AbstractTask* createTask(int socket) = 0;
+    //! Processes request received from client
+    /*!
+     * \param input Data received from client, it begins with a request
+     * \param output Data to append response to
+     * \param keepAlive Connection is closed after response is sent if it is set to FALSE
+     * \return Amount of bytes of processed request or 0 if request is incomplete
+     */
+    virtual std::size_t processRequest(const std::string& input, Output& output, bool& keepAlive) = 0;
 
 private:
+    using Clock      = std::chrono::steady_clock;
     using ThreadPool = std::vector<std::thread>;
 
-    static constexpr int         ClockTimeoutMs    = 100;
-    static constexpr std::size_t ReadBufferSize    = 1024;
-    static constexpr std::size_t WriteBufferSize   = 4096;
-    static constexpr std::size_t HeaderPartSize    = 1024;
-    static constexpr int         MaxTasksQueueSize = 128;
-
-    void runWorker();
-    void runListener();
-
-    const int                 _port;
-    const std::string         _host;
-    const int                 _backlog;
-    std::atomic_bool          _isRunning;
-    ThreadPool                _threadPool;
-    std::thread               _listenerThread;
-    int                       _serverSocket;
-    std::queue<AbstractTask*> _tasksQueue;
-    std::mutex                _tasksQueueMutex;
-    std::condition_variable   _tasksQueueCond;
+    //! Non-blocking connection of client
+    struct Connection
+    {
+        explicit Connection(int socket);
+        ~Connection();
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+
+        int               socket;
+        std::string       input;
+        Output            output;
+        bool              keepAlive;  //!< FALSE if connection is closed after output is sent
+        bool              writing;    //!< TRUE if EPOLLOUT is awaited
+        bool              peerClosed; //!< TRUE if client has shut down sending, received requests are still served
+        Clock::time_point deadline;   //!< Connection is closed if it isn't served up to this moment
+    };
+
+    using Connections = std::unordered_map<int, std::unique_ptr<Connection>>;
+
+    static constexpr int         ClockTimeoutMs = 100;
+    static constexpr int         MaxEvents      = 64;
+    static constexpr std::size_t ReadBufferSize = 4096;
+    static constexpr std::size_t MaxRequestSize = 8192;
+    static constexpr int         MaxIovecs      = 16;
+
+    void runLoop();
+    void acceptConnections(int epoll, Connections& connections);
+    //! Reads, processes and writes data of connection, returns FALSE if it should be closed
+    bool serve(int epoll, Connection& connection, bool readable);
+    //! Processes received requests and sends responses while socket accepts data
+    bool flush(int epoll, Connection& connection);
+
+    const int           _port;
+    const std::string   _host;
+    const int           _backlog;
+    const std::size_t   _maxServingDurationMs;
+    const std::size_t   _keepAliveTimeoutMs;
+    const std::size_t   _maxConnections;
+    std::atomic_bool    _isRunning;
+    std::atomic<size_t> _connectionsAmount;
+    ThreadPool          _loops;
+    int                 _serverSocket;
 };
 //------------------------------------------------------------------------------
 #endif //ABSTRACT_TCP_SERVICE_H
@@ -22,11 +22,13 @@
 #include "json_analyzer.h"
 //------------------------------------------------------------------------------
 
-JsonAnalyzer::JsonAnalyzer(std::size_t workersAmount, int port, const std::string& host, std::size_t maxServingDurationMs, int backlog)
-    : _jsonTcpService{*this, workersAmount, port, host, maxServingDurationMs, backlog}
-    , _nfsV3Stat{}
-    , _nfsV40Stat{}
-    , _nfsV41Stat{}
+JsonAnalyzer::JsonAnalyzer(std::size_t workersAmount, int port, const std::string& host, std::size_t maxServingDurationMs, int backlog,
+                           std::size_t keepAliveTimeoutMs, std::size_t maxConnections, std::size_t snapshotIntervalMs, std::size_t historySize,
+                           std::size_t topSize, uint32_t halfLifeS, std::size_t metricsIntervalMs, std::size_t metricsHosts)
+    : _jsonTcpService{*this, workersAmount, port, host, maxServingDurationMs, backlog, keepAliveTimeoutMs, maxConnections, snapshotIntervalMs, historySize, topSize, metricsIntervalMs}
+    , _counters{NfsV41Stat::end}
+    , _metrics{metricsHosts}
+    , _hitters{HeavyHitters::DefaultCapacity, halfLifeS}
 {
     _jsonTcpService.start();
 }
@@ -36,6 +38,17 @@ JsonAnalyzer::~JsonAnalyzer()
     _jsonTcpService.stop();
 }
 
+void JsonAnalyzer::headers(const HeaderEvent* events, std::size_t count)
+{
+    _metrics.account(events, count);
+    _hitters.account(events, count);
+}
+
+void JsonAnalyzer::records(const OpRecord* records, std::size_t count)
+{
+    _hitters.account(records, count);
+}
+
 // NFS3
 // Procedures:
 
@@ -43,154 +56,154 @@ void JsonAnalyzer::null(const RPCProcedure* /*proc*/,
                         const struct NFS3::NULL3args* /*args*/,
                         const struct NFS3::NULL3res* /*res*/)
 {
-    _nfsV3Stat.nullProcsAmount++;
+    _counters.add(NfsV3Stat::nullProcsAmount);
 }
 
 void JsonAnalyzer::getattr3(const RPCProcedure* /*proc*/,
                             const struct NFS3::GETATTR3args* /*args*/,
                             const struct NFS3::GETATTR3res* /*res*/)
 {
-    _nfsV3Stat.getattrProcsAmount++;
+    _counters.add(NfsV3Stat::getattrProcsAmount);
 }
 
 void JsonAnalyzer::setattr3(const RPCProcedure* /*proc*/,
                             const struct NFS3::SETATTR3args* /*args*/,
                             const struct NFS3::SETATTR3res* /*res*/)
 {
-    _nfsV3Stat.setattrProcsAmount++;
+    _counters.add(NfsV3Stat::setattrProcsAmount);
 }
 
 void JsonAnalyzer::lookup3(const RPCProcedure* /*proc*/,
                            const struct NFS3::LOOKUP3args* /*args*/,
                            const struct NFS3::LOOKUP3res* /*res*/)
 {
-    _nfsV3Stat.lookupProcsAmount++;
+    _counters.add(NfsV3Stat::lookupProcsAmount);
 }
 
 void JsonAnalyzer::access3(const RPCProcedure* /*proc*/,
                            const struct NFS3::ACCESS3args* /*args*/,
                            const struct NFS3::ACCESS3res* /*res*/)
 {
-    _nfsV3Stat.accessProcsAmount++;
+    _counters.add(NfsV3Stat::accessProcsAmount);
 }
 
 void JsonAnalyzer::readlink3(const RPCProcedure* /*proc*/,
                              const struct NFS3::READLINK3args* /*args*/,
                              const struct NFS3::READLINK3res* /*res*/)
 {
-    _nfsV3Stat.readlinkProcsAmount++;
+    _counters.add(NfsV3Stat::readlinkProcsAmount);
 }
 
 void JsonAnalyzer::read3(const RPCProcedure* /*proc*/,
                          const struct NFS3::READ3args* /*args*/,
                          const struct NFS3::READ3res* /*res*/)
 {
-    _nfsV3Stat.readProcsAmount++;
+    _counters.add(NfsV3Stat::readProcsAmount);
 }
 
 void JsonAnalyzer::write3(const RPCProcedure* /*proc*/,
                           const struct NFS3::WRITE3args* /*args*/,
                           const struct NFS3::WRITE3res* /*res*/)
 {
-    _nfsV3Stat.writeProcsAmount++;
+    _counters.add(NfsV3Stat::writeProcsAmount);
 }
 
 void JsonAnalyzer::create3(const RPCProcedure* /*proc*/,
                            const struct NFS3::CREATE3args* /*args*/,
                            const struct NFS3::CREATE3res* /*res*/)
 {
-    _nfsV3Stat.createProcsAmount++;
+    _counters.add(NfsV3Stat::createProcsAmount);
 }
 
 void JsonAnalyzer::mkdir3(const RPCProcedure* /*proc*/,
                           const struct NFS3::MKDIR3args* /*args*/,
                           const struct NFS3::MKDIR3res* /*res*/)
 {
-    _nfsV3Stat.mkdirProcsAmount++;
+    _counters.add(NfsV3Stat::mkdirProcsAmount);
 }
 
 void JsonAnalyzer::symlink3(const RPCProcedure* /*proc*/,
                             const struct NFS3::SYMLINK3args* /*args*/,
                             const struct NFS3::SYMLINK3res* /*res*/)
 {
-    _nfsV3Stat.symlinkProcsAmount++;
+    _counters.add(NfsV3Stat::symlinkProcsAmount);
 }
 
 void JsonAnalyzer::mknod3(const RPCProcedure* /*proc*/,
                           const struct NFS3::MKNOD3args* /*args*/,
                           const struct NFS3::MKNOD3res* /*res*/)
 {
-    _nfsV3Stat.mknodProcsAmount++;
+    _counters.add(NfsV3Stat::mknodProcsAmount);
 }
 
 void JsonAnalyzer::remove3(const RPCProcedure* /*proc*/,
                            const struct NFS3::REMOVE3args* /*args*/,
                            const struct NFS3::REMOVE3res* /*res*/)
 {
-    _nfsV3Stat.removeProcsAmount++;
+    _counters.add(NfsV3Stat::removeProcsAmount);
 }
 
 void JsonAnalyzer::rmdir3(const RPCProcedure* /*proc*/,
                           const struct NFS3::RMDIR3args* /*args*/,
                           const struct NFS3::RMDIR3res* /*res*/)
 {
-    _nfsV3Stat.rmdirProcsAmount++;
+    _counters.add(NfsV3Stat::rmdirProcsAmount);
 }
 
 void JsonAnalyzer::rename3(const RPCProcedure* /*proc*/,
                            const struct NFS3::RENAME3args* /*args*/,
                            const struct NFS3::RENAME3res* /*res*/)
 {
-    _nfsV3Stat.renameProcsAmount++;
+    _counters.add(NfsV3Stat::renameProcsAmount);
 }
 
 void JsonAnalyzer::link3(const RPCProcedure* /*proc*/,
                          const struct NFS3::LINK3args* /*args*/,
                          const struct NFS3::LINK3res* /*res*/)
 {
-    _nfsV3Stat.linkProcsAmount++;
+    _counters.add(NfsV3Stat::linkProcsAmount);
 }
 
 void JsonAnalyzer::readdir3(const RPCProcedure* /*proc*/,
                             const struct NFS3::READDIR3args* /*args*/,
                             const struct NFS3::READDIR3res* /*res*/)
 {
-    _nfsV3Stat.readdirProcsAmount++;
+    _counters.add(NfsV3Stat::readdirProcsAmount);
 }
 
 void JsonAnalyzer::readdirplus3(const RPCProcedure* /*proc*/,
                                 const struct NFS3::READDIRPLUS3args* /*args*/,
                                 const struct NFS3::READDIRPLUS3res* /*res*/)
 {
-    _nfsV3Stat.readdirplusProcsAmount++;
+    _counters.add(NfsV3Stat::readdirplusProcsAmount);
 }
 
 void JsonAnalyzer::fsstat3(const RPCProcedure* /*proc*/,
                            const struct NFS3::FSSTAT3args* /*args*/,
                            const struct NFS3::FSSTAT3res* /*res*/)
 {
-    _nfsV3Stat.fsstatProcsAmount++;
+    _counters.add(NfsV3Stat::fsstatProcsAmount);
 }
 
 void JsonAnalyzer::fsinfo3(const RPCProcedure* /*proc*/,
                            const struct NFS3::FSINFO3args* /*args*/,
                            const struct NFS3::FSINFO3res* /*res*/)
 {
-    _nfsV3Stat.fsinfoProcsAmount++;
+    _counters.add(NfsV3Stat::fsinfoProcsAmount);
 }
 
 void JsonAnalyzer::pathconf3(const RPCProcedure* /*proc*/,
                              const struct NFS3::PATHCONF3args* /*args*/,
                              const struct NFS3::PATHCONF3res* /*res*/)
 {
-    _nfsV3Stat.pathconfProcsAmount++;
+    _counters.add(NfsV3Stat::pathconfProcsAmount);
 }
 
 void JsonAnalyzer::commit3(const RPCProcedure* /*proc*/,
                            const struct NFS3::COMMIT3args* /*args*/,
                            const struct NFS3::COMMIT3res* /*res*/)
 {
-    _nfsV3Stat.commitProcsAmount++;
+    _counters.add(NfsV3Stat::commitProcsAmount);
 }
 
 // NFS4.0
@@ -200,13 +213,13 @@ void JsonAnalyzer::null4(const RPCProcedure* /*proc*/,
                          const struct NFS4::NULL4args* /*args*/,
                          const struct NFS4::NULL4res* /*res*/)
 {
-    _nfsV40Stat.nullProcsAmount++;
+    _counters.add(NfsV40Stat::nullProcsAmount);
 }
 void JsonAnalyzer::compound4(const RPCProcedure* /*proc*/,
                              const struct NFS4::COMPOUND4args* /*args*/,
                              const struct NFS4::COMPOUND4res* /*res*/)
 {
-    _nfsV40Stat.compoundProcsAmount++;
+    _counters.add(NfsV40Stat::compoundProcsAmount);
 }
 
 // Operations:
@@ -215,265 +228,265 @@ void JsonAnalyzer::access40(const RPCProcedure* /* proc */,
                             const struct NFS4::ACCESS4args* /* args */,
                             const struct NFS4::ACCESS4res* res)
 {
-    if(res) _nfsV40Stat.accessOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::accessOpsAmount);
 }
 
 void JsonAnalyzer::close40(const RPCProcedure* /* proc */,
                            const struct NFS4::CLOSE4args* /* args */,
                            const struct NFS4::CLOSE4res* res)
 {
-    if(res) _nfsV40Stat.closeOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::closeOpsAmount);
 }
 
 void JsonAnalyzer::commit40(const RPCProcedure* /* proc */,
                             const struct NFS4::COMMIT4args* /* args */,
                             const struct NFS4::COMMIT4res* res)
 {
-    if(res) _nfsV40Stat.commitOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::commitOpsAmount);
 }
 
 void JsonAnalyzer::create40(const RPCProcedure* /* proc */,
                             const struct NFS4::CREATE4args* /* args */,
                             const struct NFS4::CREATE4res* res)
 {
-    if(res) _nfsV40Stat.createOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::createOpsAmount);
 }
 
 void JsonAnalyzer::delegpurge40(const RPCProcedure* /* proc */,
                                 const struct NFS4::DELEGPURGE4args* /* args */,
                                 const struct NFS4::DELEGPURGE4res* res)
 {
-    if(res) _nfsV40Stat.delegpurgeOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::delegpurgeOpsAmount);
 }
 
 void JsonAnalyzer::delegreturn40(const RPCProcedure* /* proc */,
                                  const struct NFS4::DELEGRETURN4args* /* args */,
                                  const struct NFS4::DELEGRETURN4res* res)
 {
-    if(res) _nfsV40Stat.delegreturnOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::delegreturnOpsAmount);
 }
 
 void JsonAnalyzer::getattr40(const RPCProcedure* /* proc */,
                              const struct NFS4::GETATTR4args* /* args */,
                              const struct NFS4::GETATTR4res* res)
 {
-    if(res) _nfsV40Stat.getattrOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::getattrOpsAmount);
 }
 
 void JsonAnalyzer::getfh40(const RPCProcedure* /* proc */,
                            const struct NFS4::GETFH4res* res)
 {
-    if(res) _nfsV40Stat.getfhOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::getfhOpsAmount);
 }
 
 void JsonAnalyzer::link40(const RPCProcedure* /* proc */,
                           const struct NFS4::LINK4args* /* args */,
                           const struct NFS4::LINK4res* res)
 {
-    if(res) _nfsV40Stat.linkOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::linkOpsAmount);
 }
 
 void JsonAnalyzer::lock40(const RPCProcedure* /* proc */,
                           const struct NFS4::LOCK4args* /* args */,
                           const struct NFS4::LOCK4res* res)
 {
-    if(res) _nfsV40Stat.lockOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::lockOpsAmount);
 }
 
 void JsonAnalyzer::lockt40(const RPCProcedure* /* proc */,
                            const struct NFS4::LOCKT4args* /* args */,
                            const struct NFS4::LOCKT4res* res)
 {
-    if(res) _nfsV40Stat.locktOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::locktOpsAmount);
 }
 
 void JsonAnalyzer::locku40(const RPCProcedure* /* proc */,
                            const struct NFS4::LOCKU4args* /* args */,
                            const struct NFS4::LOCKU4res* res)
 {
-    if(res) _nfsV40Stat.lockuOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::lockuOpsAmount);
 }
 
 void JsonAnalyzer::lookup40(const RPCProcedure* /* proc */,
                             const struct NFS4::LOOKUP4args* /* args */,
                             const struct NFS4::LOOKUP4res* res)
 {
-    if(res) _nfsV40Stat.lookupOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::lookupOpsAmount);
 }
 
 void JsonAnalyzer::lookupp40(const RPCProcedure* /* proc */,
                              const struct NFS4::LOOKUPP4res* res)
 {
-    if(res) _nfsV40Stat.lookuppOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::lookuppOpsAmount);
 }
 
 void JsonAnalyzer::nverify40(const RPCProcedure* /* proc */,
                              const struct NFS4::NVERIFY4args* /* args */,
                              const struct NFS4::NVERIFY4res* res)
 {
-    if(res) _nfsV40Stat.nverifyOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::nverifyOpsAmount);
 }
 
 void JsonAnalyzer::open40(const RPCProcedure* /* proc */,
                           const struct NFS4::OPEN4args* /* args */,
                           const struct NFS4::OPEN4res* res)
 {
-    if(res) _nfsV40Stat.openOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::openOpsAmount);
 }
 
 void JsonAnalyzer::openattr40(const RPCProcedure* /* proc */,
                               const struct NFS4::OPENATTR4args* /* args */,
                               const struct NFS4::OPENATTR4res* res)
 {
-    if(res) _nfsV40Stat.openattrOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::openattrOpsAmount);
 }
 
 void JsonAnalyzer::open_confirm40(const RPCProcedure* /* proc */,
                                   const struct NFS4::OPEN_CONFIRM4args* /* args */,
                                   const struct NFS4::OPEN_CONFIRM4res* res)
 {
-    if(res) _nfsV40Stat.open_confirmOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::open_confirmOpsAmount);
 }
 
 void JsonAnalyzer::open_downgrade40(const RPCProcedure* /* proc */,
                                     const struct NFS4::OPEN_DOWNGRADE4args* /* args */,
                                     const struct NFS4::OPEN_DOWNGRADE4res* res)
 {
-    if(res) _nfsV40Stat.open_downgradeOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::open_downgradeOpsAmount);
 }
 
 void JsonAnalyzer::putfh40(const RPCProcedure* /* proc */,
                            const struct NFS4::PUTFH4args* /* args */,
                            const struct NFS4::PUTFH4res* res)
 {
-    if(res) _nfsV40Stat.putfhOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::putfhOpsAmount);
 }
 
 void JsonAnalyzer::putpubfh40(const RPCProcedure* /* proc */,
                               const struct NFS4::PUTPUBFH4res* res)
 {
-    if(res) _nfsV40Stat.putpubfhOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::putpubfhOpsAmount);
 }
 
 void JsonAnalyzer::putrootfh40(const RPCProcedure* /* proc */,
                                const struct NFS4::PUTROOTFH4res* res)
 {
-    if(res) _nfsV40Stat.putrootfhOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::putrootfhOpsAmount);
 }
 
 void JsonAnalyzer::read40(const RPCProcedure* /* proc */,
                           const struct NFS4::READ4args* /* args */,
                           const struct NFS4::READ4res* res)
 {
-    if(res) _nfsV40Stat.readOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::readOpsAmount);
 }
 
 void JsonAnalyzer::readdir40(const RPCProcedure* /* proc */,
                              const struct NFS4::READDIR4args* /* args */,
                              const struct NFS4::READDIR4res* res)
 {
-    if(res) _nfsV40Stat.readdirOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::readdirOpsAmount);
 }
 
 void JsonAnalyzer::readlink40(const RPCProcedure* /* proc */,
                               const struct NFS4::READLINK4res* res)
 {
-    if(res) _nfsV40Stat.readlinkOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::readlinkOpsAmount);
 }
 
 void JsonAnalyzer::remove40(const RPCProcedure* /* proc */,
                             const struct NFS4::REMOVE4args* /* args */,
                             const struct NFS4::REMOVE4res* res)
 {
-    if(res) _nfsV40Stat.removeOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::removeOpsAmount);
 }
 
 void JsonAnalyzer::rename40(const RPCProcedure* /* proc */,
                             const struct NFS4::RENAME4args* /* args */,
                             const struct NFS4::RENAME4res* res)
 {
-    if(res) _nfsV40Stat.renameOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::renameOpsAmount);
 }
 
 void JsonAnalyzer::renew40(const RPCProcedure* /* proc */,
                            const struct NFS4::RENEW4args* /* args */,
                            const struct NFS4::RENEW4res* res)
 {
-    if(res) _nfsV40Stat.renewOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::renewOpsAmount);
 }
 
 void JsonAnalyzer::restorefh40(const RPCProcedure* /* proc */,
                                const struct NFS4::RESTOREFH4res* res)
 {
-    if(res) _nfsV40Stat.restorefhOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::restorefhOpsAmount);
 }
 
 void JsonAnalyzer::savefh40(const RPCProcedure* /* proc */,
                             const struct NFS4::SAVEFH4res* res)
 {
-    if(res) _nfsV40Stat.savefhOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::savefhOpsAmount);
 }
 
 void JsonAnalyzer::secinfo40(const RPCProcedure* /* proc */,
                              const struct NFS4::SECINFO4args* /* args */,
                              const struct NFS4::SECINFO4res* res)
 {
-    if(res) _nfsV40Stat.secinfoOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::secinfoOpsAmount);
 }
 
 void JsonAnalyzer::setattr40(const RPCProcedure* /* proc */,
                              const struct NFS4::SETATTR4args* /* args */,
                              const struct NFS4::SETATTR4res* res)
 {
-    if(res) _nfsV40Stat.setattrOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::setattrOpsAmount);
 }
 
 void JsonAnalyzer::setclientid40(const RPCProcedure* /* proc */,
                                  const struct NFS4::SETCLIENTID4args* /* args */,
                                  const struct NFS4::SETCLIENTID4res* res)
 {
-    if(res) _nfsV40Stat.setclientidOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::setclientidOpsAmount);
 }
 
 void JsonAnalyzer::setclientid_confirm40(const RPCProcedure* /* proc */,
                                          const struct NFS4::SETCLIENTID_CONFIRM4args* /* args */,
                                          const struct NFS4::SETCLIENTID_CONFIRM4res* res)
 {
-    if(res) _nfsV40Stat.setclientid_confirmOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::setclientid_confirmOpsAmount);
 }
 
 void JsonAnalyzer::verify40(const RPCProcedure* /* proc */,
                             const struct NFS4::VERIFY4args* /* args */,
                             const struct NFS4::VERIFY4res* res)
 {
-    if(res) _nfsV40Stat.verifyOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::verifyOpsAmount);
 }
 
 void JsonAnalyzer::write40(const RPCProcedure* /* proc */,
                            const struct NFS4::WRITE4args* /* args */,
                            const struct NFS4::WRITE4res* res)
 {
-    if(res) _nfsV40Stat.writeOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::writeOpsAmount);
 }
 
 void JsonAnalyzer::release_lockowner40(const RPCProcedure* /* proc */,
                                        const struct NFS4::RELEASE_LOCKOWNER4args* /* args */,
                                        const struct NFS4::RELEASE_LOCKOWNER4res* res)
 {
-    if(res) _nfsV40Stat.release_lockownerOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::release_lockownerOpsAmount);
 }
 
 void JsonAnalyzer::get_dir_delegation40(const RPCProcedure* /* proc */,
                                         const struct NFS4::GET_DIR_DELEGATION4args* /* args */,
                                         const struct NFS4::GET_DIR_DELEGATION4res* res)
 {
-    if(res) _nfsV40Stat.get_dir_delegationOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::get_dir_delegationOpsAmount);
 }
 
 void JsonAnalyzer::illegal40(const RPCProcedure* /* proc */,
                              const struct NFS4::ILLEGAL4res* res)
 {
-    if(res) _nfsV40Stat.illegalOpsAmount++;
+    if(res) _counters.add(NfsV40Stat::illegalOpsAmount);
 }
 
 // NFS4.1
@@ -483,7 +496,7 @@ void JsonAnalyzer::compound41(const RPCProcedure* /*proc*/,
                               const struct NFS41::COMPOUND4args* /*args*/,
                               const struct NFS41::COMPOUND4res* /*res*/)
 {
-    _nfsV41Stat.compoundProcsAmount++;
+    _counters.add(NfsV41Stat::compoundProcsAmount);
 }
 
 // Operations:
@@ -492,391 +505,391 @@ void JsonAnalyzer::access41(const RPCProcedure* /* proc */,
                             const struct NFS41::ACCESS4args* /* args */,
                             const struct NFS41::ACCESS4res* res)
 {
-    if(res) _nfsV41Stat.accessOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::accessOpsAmount);
 }
 
 void JsonAnalyzer::close41(const RPCProcedure* /* proc */,
                            const struct NFS41::CLOSE4args* /* args */,
                            const struct NFS41::CLOSE4res* res)
 {
-    if(res) _nfsV41Stat.closeOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::closeOpsAmount);
 }
 
 void JsonAnalyzer::commit41(const RPCProcedure* /* proc */,
                             const struct NFS41::COMMIT4args* /* args */,
                             const struct NFS41::COMMIT4res* res)
 {
-    if(res) _nfsV41Stat.commitOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::commitOpsAmount);
 }
 
 void JsonAnalyzer::create41(const RPCProcedure* /* proc */,
                             const struct NFS41::CREATE4args* /* args */,
                             const struct NFS41::CREATE4res* res)
 {
-    if(res) _nfsV41Stat.createOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::createOpsAmount);
 }
 
 void JsonAnalyzer::delegpurge41(const RPCProcedure* /* proc */,
                                 const struct NFS41::DELEGPURGE4args* /* args */,
                                 const struct NFS41::DELEGPURGE4res* res)
 {
-    if(res) _nfsV41Stat.delegpurgeOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::delegpurgeOpsAmount);
 }
 
 void JsonAnalyzer::delegreturn41(const RPCProcedure* /* proc */,
                                  const struct NFS41::DELEGRETURN4args* /* args */,
                                  const struct NFS41::DELEGRETURN4res* res)
 {
-    if(res) _nfsV41Stat.delegreturnOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::delegreturnOpsAmount);
 }
 
 void JsonAnalyzer::getattr41(const RPCProcedure* /* proc */,
                              const struct NFS41::GETATTR4args* /* args */,
                              const struct NFS41::GETATTR4res* res)
 {
-    if(res) _nfsV41Stat.getattrOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::getattrOpsAmount);
 }
 
 void JsonAnalyzer::getfh41(const RPCProcedure* /* proc */,
                            const struct NFS41::GETFH4res* res)
 {
-    if(res) _nfsV41Stat.getfhOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::getfhOpsAmount);
 }
 
 void JsonAnalyzer::link41(const RPCProcedure* /* proc */,
                           const struct NFS41::LINK4args* /* args */,
                           const struct NFS41::LINK4res* res)
 {
-    if(res) _nfsV41Stat.linkOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::linkOpsAmount);
 }
 
 void JsonAnalyzer::lock41(const RPCProcedure* /* proc */,
                           const struct NFS41::LOCK4args* /* args */,
                           const struct NFS41::LOCK4res* res)
 {
-    if(res) _nfsV41Stat.lockOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::lockOpsAmount);
 }
 
 void JsonAnalyzer::lockt41(const RPCProcedure* /* proc */,
                            const struct NFS41::LOCKT4args* /* args */,
                            const struct NFS41::LOCKT4res* res)
 {
-    if(res) _nfsV41Stat.locktOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::locktOpsAmount);
 }
 
 void JsonAnalyzer::locku41(const RPCProcedure* /* proc */,
                            const struct NFS41::LOCKU4args* /* args */,
                            const struct NFS41::LOCKU4res* res)
 {
-    if(res) _nfsV41Stat.lockuOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::lockuOpsAmount);
 }
 
 void JsonAnalyzer::lookup41(const RPCProcedure* /* proc */,
                             const struct NFS41::LOOKUP4args* /* args */,
                             const struct NFS41::LOOKUP4res* res)
 {
-    if(res) _nfsV41Stat.lookupOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::lookupOpsAmount);
 }
 
 void JsonAnalyzer::lookupp41(const RPCProcedure* /* proc */,
                              const struct NFS41::LOOKUPP4res* res)
 {
-    if(res) _nfsV41Stat.lookuppOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::lookuppOpsAmount);
 }
 
 void JsonAnalyzer::nverify41(const RPCProcedure* /* proc */,
                              const struct NFS41::NVERIFY4args* /* args */,
                              const struct NFS41::NVERIFY4res* res)
 {
-    if(res) _nfsV41Stat.nverifyOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::nverifyOpsAmount);
 }
 
 void JsonAnalyzer::open41(const RPCProcedure* /* proc */,
                           const struct NFS41::OPEN4args* /* args */,
                           const struct NFS41::OPEN4res* res)
 {
-    if(res) _nfsV41Stat.openOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::openOpsAmount);
 }
 
 void JsonAnalyzer::openattr41(const RPCProcedure* /* proc */,
                               const struct NFS41::OPENATTR4args* /* args */,
                               const struct NFS41::OPENATTR4res* res)
 {
-    if(res) _nfsV41Stat.openattrOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::openattrOpsAmount);
 }
 
 void JsonAnalyzer::open_confirm41(const RPCProcedure* /* proc */,
                                   const struct NFS41::OPEN_CONFIRM4args* /* args */,
                                   const struct NFS41::OPEN_CONFIRM4res* res)
 {
-    if(res) _nfsV41Stat.open_confirmOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::open_confirmOpsAmount);
 }
 
 void JsonAnalyzer::open_downgrade41(const RPCProcedure* /* proc */,
                                     const struct NFS41::OPEN_DOWNGRADE4args* /* args */,
                                     const struct NFS41::OPEN_DOWNGRADE4res* res)
 {
-    if(res) _nfsV41Stat.open_downgradeOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::open_downgradeOpsAmount);
 }
 
 void JsonAnalyzer::putfh41(const RPCProcedure* /* proc */,
                            const struct NFS41::PUTFH4args* /* args */,
                            const struct NFS41::PUTFH4res* res)
 {
-    if(res) _nfsV41Stat.putfhOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::putfhOpsAmount);
 }
 
 void JsonAnalyzer::putpubfh41(const RPCProcedure* /* proc */,
                               const struct NFS41::PUTPUBFH4res* res)
 {
-    if(res) _nfsV41Stat.putpubfhOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::putpubfhOpsAmount);
 }
 
 void JsonAnalyzer::putrootfh41(const RPCProcedure* /* proc */,
                                const struct NFS41::PUTROOTFH4res* res)
 {
-    if(res) _nfsV41Stat.putrootfhOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::putrootfhOpsAmount);
 }
 
 void JsonAnalyzer::read41(const RPCProcedure* /* proc */,
                           const struct NFS41::READ4args* /* args */,
                           const struct NFS41::READ4res* res)
 {
-    if(res) _nfsV41Stat.readOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::readOpsAmount);
 }
 
 void JsonAnalyzer::readdir41(const RPCProcedure* /* proc */,
                              const struct NFS41::READDIR4args* /* args */,
                              const struct NFS41::READDIR4res* res)
 {
-    if(res) _nfsV41Stat.readdirOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::readdirOpsAmount);
 }
 
 void JsonAnalyzer::readlink41(const RPCProcedure* /* proc */,
                               const struct NFS41::READLINK4res* res)
 {
-    if(res) _nfsV41Stat.readlinkOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::readlinkOpsAmount);
 }
 
 void JsonAnalyzer::remove41(const RPCProcedure* /* proc */,
                             const struct NFS41::REMOVE4args* /* args */,
                             const struct NFS41::REMOVE4res* res)
 {
-    if(res) _nfsV41Stat.removeOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::removeOpsAmount);
 }
 
 void JsonAnalyzer::rename41(const RPCProcedure* /* proc */,
                             const struct NFS41::RENAME4args* /* args */,
                             const struct NFS41::RENAME4res* res)
 {
-    if(res) _nfsV41Stat.renameOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::renameOpsAmount);
 }
 
 void JsonAnalyzer::renew41(const RPCProcedure* /* proc */,
                            const struct NFS41::RENEW4args* /* args */,
                            const struct NFS41::RENEW4res* res)
 {
-    if(res) _nfsV41Stat.renewOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::renewOpsAmount);
 }
 
 void JsonAnalyzer::restorefh41(const RPCProcedure* /* proc */,
                                const struct NFS41::RESTOREFH4res* res)
 {
-    if(res) _nfsV41Stat.restorefhOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::restorefhOpsAmount);
 }
 
 void JsonAnalyzer::savefh41(const RPCProcedure* /* proc */,
                             const struct NFS41::SAVEFH4res* res)
 {
-    if(res) _nfsV41Stat.savefhOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::savefhOpsAmount);
 }
 
 void JsonAnalyzer::secinfo41(const RPCProcedure* /* proc */,
                              const struct NFS41::SECINFO4args* /* args */,
                              const struct NFS41::SECINFO4res* res)
 {
-    if(res) _nfsV41Stat.secinfoOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::secinfoOpsAmount);
 }
 
 void JsonAnalyzer::setattr41(const RPCProcedure* /* proc */,
                              const struct NFS41::SETATTR4args* /* args */,
                              const struct NFS41::SETATTR4res* res)
 {
-    if(res) _nfsV41Stat.setattrOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::setattrOpsAmount);
 }
 
 void JsonAnalyzer::setclientid41(const RPCProcedure* /* proc */,
                                  const struct NFS41::SETCLIENTID4args* /* args */,
                                  const struct NFS41::SETCLIENTID4res* res)
 {
-    if(res) _nfsV41Stat.setclientidOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::setclientidOpsAmount);
 }
 
 void JsonAnalyzer::setclientid_confirm41(const RPCProcedure* /* proc */,
                                          const struct NFS41::SETCLIENTID_CONFIRM4args* /* args */,
                                          const struct NFS41::SETCLIENTID_CONFIRM4res* res)
 {
-    if(res) _nfsV41Stat.setclientid_confirmOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::setclientid_confirmOpsAmount);
 }
 
 void JsonAnalyzer::verify41(const RPCProcedure* /* proc */,
                             const struct NFS41::VERIFY4args* /* args */,
                             const struct NFS41::VERIFY4res* res)
 {
-    if(res) _nfsV41Stat.verifyOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::verifyOpsAmount);
 }
 
 void JsonAnalyzer::write41(const RPCProcedure* /* proc */,
                            const struct NFS41::WRITE4args* /* args */,
                            const struct NFS41::WRITE4res* res)
 {
-    if(res) _nfsV41Stat.writeOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::writeOpsAmount);
 }
 
 void JsonAnalyzer::release_lockowner41(const RPCProcedure* /* proc */,
                                        const struct NFS41::RELEASE_LOCKOWNER4args* /* args */,
                                        const struct NFS41::RELEASE_LOCKOWNER4res* res)
 {
-    if(res) _nfsV41Stat.release_lockownerOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::release_lockownerOpsAmount);
 }
 
 void JsonAnalyzer::backchannel_ctl41(const RPCProcedure* /* proc */,
                                      const struct NFS41::BACKCHANNEL_CTL4args* /* args */,
                                      const struct NFS41::BACKCHANNEL_CTL4res* res)
 {
-    if(res) _nfsV41Stat.backchannel_ctlOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::backchannel_ctlOpsAmount);
 }
 
 void JsonAnalyzer::bind_conn_to_session41(const RPCProcedure* /* proc */,
                                           const struct NFS41::BIND_CONN_TO_SESSION4args* /* args */,
                                           const struct NFS41::BIND_CONN_TO_SESSION4res* res)
 {
-    if(res) _nfsV41Stat.bind_conn_to_sessionOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::bind_conn_to_sessionOpsAmount);
 }
 
 void JsonAnalyzer::exchange_id41(const RPCProcedure* /* proc */,
                                  const struct NFS41::EXCHANGE_ID4args* /* args */,
                                  const struct NFS41::EXCHANGE_ID4res* res)
 {
-    if(res) _nfsV41Stat.exchange_idOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::exchange_idOpsAmount);
 }
 
 void JsonAnalyzer::create_session41(const RPCProcedure* /* proc */,
                                     const struct NFS41::CREATE_SESSION4args* /* args */,
                                     const struct NFS41::CREATE_SESSION4res* res)
 {
-    if(res) _nfsV41Stat.create_sessionOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::create_sessionOpsAmount);
 }
 
 void JsonAnalyzer::destroy_session41(const RPCProcedure* /* proc */,
                                      const struct NFS41::DESTROY_SESSION4args* /* args */,
                                      const struct NFS41::DESTROY_SESSION4res* res)
 {
-    if(res) _nfsV41Stat.destroy_sessionOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::destroy_sessionOpsAmount);
 }
 
 void JsonAnalyzer::free_stateid41(const RPCProcedure* /* proc */,
                                   const struct NFS41::FREE_STATEID4args* /* args */,
                                   const struct NFS41::FREE_STATEID4res* res)
 {
-    if(res) _nfsV41Stat.free_stateidOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::free_stateidOpsAmount);
 }
 
 void JsonAnalyzer::get_dir_delegation41(const RPCProcedure* /* proc */,
                                         const struct NFS41::GET_DIR_DELEGATION4args* /* args */,
                                         const struct NFS41::GET_DIR_DELEGATION4res* res)
 {
-    if(res) _nfsV41Stat.get_dir_delegationOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::get_dir_delegationOpsAmount);
 }
 
 void JsonAnalyzer::getdeviceinfo41(const RPCProcedure* /* proc */,
                                    const struct NFS41::GETDEVICEINFO4args* /* args */,
                                    const struct NFS41::GETDEVICEINFO4res* res)
 {
-    if(res) _nfsV41Stat.getdeviceinfoOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::getdeviceinfoOpsAmount);
 }
 
 void JsonAnalyzer::getdevicelist41(const RPCProcedure* /* proc */,
                                    const struct NFS41::GETDEVICELIST4args* /* args */,
                                    const struct NFS41::GETDEVICELIST4res* res)
 {
-    if(res) _nfsV41Stat.getdevicelistOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::getdevicelistOpsAmount);
 }
 
 void JsonAnalyzer::layoutcommit41(const RPCProcedure* /* proc */,
                                   const struct NFS41::LAYOUTCOMMIT4args* /* args */,
                                   const struct NFS41::LAYOUTCOMMIT4res* res)
 {
-    if(res) _nfsV41Stat.layoutcommitOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::layoutcommitOpsAmount);
 }
 
 void JsonAnalyzer::layoutget41(const RPCProcedure* /* proc */,
                                const struct NFS41::LAYOUTGET4args* /* args */,
                                const struct NFS41::LAYOUTGET4res* res)
 {
-    if(res) _nfsV41Stat.layoutgetOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::layoutgetOpsAmount);
 }
 
 void JsonAnalyzer::layoutreturn41(const RPCProcedure* /* proc */,
                                   const struct NFS41::LAYOUTRETURN4args* /* args */,
                                   const struct NFS41::LAYOUTRETURN4res* res)
 {
-    if(res) _nfsV41Stat.layoutreturnOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::layoutreturnOpsAmount);
 }
 
 void JsonAnalyzer::secinfo_no_name41(const RPCProcedure* /* proc */,
                                      const NFS41::SECINFO_NO_NAME4args* /* args */,
                                      const NFS41::SECINFO_NO_NAME4res* res)
 {
-    if(res) _nfsV41Stat.secinfo_no_nameOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::secinfo_no_nameOpsAmount);
 }
 
 void JsonAnalyzer::sequence41(const RPCProcedure* /* proc */,
                               const struct NFS41::SEQUENCE4args* /* args */,
                               const struct NFS41::SEQUENCE4res* res)
 {
-    if(res) _nfsV41Stat.sequenceOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::sequenceOpsAmount);
 }
 
 void JsonAnalyzer::set_ssv41(const RPCProcedure* /* proc */,
                              const struct NFS41::SET_SSV4args* /* args */,
                              const struct NFS41::SET_SSV4res* res)
 {
-    if(res) _nfsV41Stat.set_ssvOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::set_ssvOpsAmount);
 }
 
 void JsonAnalyzer::test_stateid41(const RPCProcedure* /* proc */,
                                   const struct NFS41::TEST_STATEID4args* /* args */,
                                   const struct NFS41::TEST_STATEID4res* res)
 {
-    if(res) _nfsV41Stat.test_stateidOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::test_stateidOpsAmount);
 }
 
 void JsonAnalyzer::want_delegation41(const RPCProcedure* /* proc */,
                                      const struct NFS41::WANT_DELEGATION4args* /* args */,
                                      const struct NFS41::WANT_DELEGATION4res* res)
 {
-    if(res) _nfsV41Stat.want_delegationOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::want_delegationOpsAmount);
 }
 
 void JsonAnalyzer::destroy_clientid41(const RPCProcedure* /* proc */,
                                       const struct NFS41::DESTROY_CLIENTID4args* /* args */,
                                       const struct NFS41::DESTROY_CLIENTID4res* res)
 {
-    if(res) _nfsV41Stat.destroy_clientidOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::destroy_clientidOpsAmount);
 }
 
 void JsonAnalyzer::reclaim_complete41(const RPCProcedure* /* proc */,
                                       const struct NFS41::RECLAIM_COMPLETE4args* /* args */,
                                       const struct NFS41::RECLAIM_COMPLETE4res* res)
 {
-    if(res) _nfsV41Stat.reclaim_completeOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::reclaim_completeOpsAmount);
 }
 
 void JsonAnalyzer::illegal41(const RPCProcedure* /* proc */,
                              const struct NFS41::ILLEGAL4res* res)
 {
-    if(res) _nfsV41Stat.illegalOpsAmount++;
+    if(res) _counters.add(NfsV41Stat::illegalOpsAmount);
 }
 
 void JsonAnalyzer::flush_statistics()
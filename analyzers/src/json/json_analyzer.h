@@ -22,158 +22,184 @@
 #ifndef JSON_ANALYZER_H
 #define JSON_ANALYZER_H
 //------------------------------------------------------------------------------
-#include <atomic>
-
+#include "api/counter_set.h"
+#include "api/heavy_hitters.h"
 #include "api/ianalyzer.h"
 #include "json_tcp_service.h"
+#include "metrics_registry.h"
 //------------------------------------------------------------------------------
 using namespace NST::API;
 
 class JsonAnalyzer : public IAnalyzer
 {
 public:
+    //! Indexes of counters of NFSv3 in getCounters()
     struct NfsV3Stat
     {
-        // Procedures:
-        std::atomic_int nullProcsAmount        = {0};
-        std::atomic_int getattrProcsAmount     = {0};
-        std::atomic_int setattrProcsAmount     = {0};
-        std::atomic_int lookupProcsAmount      = {0};
-        std::atomic_int accessProcsAmount      = {0};
-        std::atomic_int readlinkProcsAmount    = {0};
-        std::atomic_int readProcsAmount        = {0};
-        std::atomic_int writeProcsAmount       = {0};
-        std::atomic_int createProcsAmount      = {0};
-        std::atomic_int mkdirProcsAmount       = {0};
-        std::atomic_int symlinkProcsAmount     = {0};
-        std::atomic_int mknodProcsAmount       = {0};
-        std::atomic_int removeProcsAmount      = {0};
-        std::atomic_int rmdirProcsAmount       = {0};
-        std::atomic_int renameProcsAmount      = {0};
-        std::atomic_int linkProcsAmount        = {0};
-        std::atomic_int readdirProcsAmount     = {0};
-        std::atomic_int readdirplusProcsAmount = {0};
-        std::atomic_int fsstatProcsAmount      = {0};
-        std::atomic_int fsinfoProcsAmount      = {0};
-        std::atomic_int pathconfProcsAmount    = {0};
-        std::atomic_int commitProcsAmount      = {0};
+        enum : std::size_t
+        {
+            // Procedures:
+            nullProcsAmount,
+            getattrProcsAmount,
+            setattrProcsAmount,
+            lookupProcsAmount,
+            accessProcsAmount,
+            readlinkProcsAmount,
+            readProcsAmount,
+            writeProcsAmount,
+            createProcsAmount,
+            mkdirProcsAmount,
+            symlinkProcsAmount,
+            mknodProcsAmount,
+            removeProcsAmount,
+            rmdirProcsAmount,
+            renameProcsAmount,
+            linkProcsAmount,
+            readdirProcsAmount,
+            readdirplusProcsAmount,
+            fsstatProcsAmount,
+            fsinfoProcsAmount,
+            pathconfProcsAmount,
+            commitProcsAmount,
+            end
+        };
     };
+    //! Indexes of counters of NFSv4.0, they follow counters of NFSv3
     struct NfsV40Stat
     {
-        // Procedures:
-        std::atomic_int nullProcsAmount     = {0};
-        std::atomic_int compoundProcsAmount = {0};
-
-        // Operations:
-        std::atomic_int accessOpsAmount              = {0};
-        std::atomic_int closeOpsAmount               = {0};
-        std::atomic_int commitOpsAmount              = {0};
-        std::atomic_int createOpsAmount              = {0};
-        std::atomic_int delegpurgeOpsAmount          = {0};
-        std::atomic_int delegreturnOpsAmount         = {0};
-        std::atomic_int getattrOpsAmount             = {0};
-        std::atomic_int getfhOpsAmount               = {0};
-        std::atomic_int linkOpsAmount                = {0};
-        std::atomic_int lockOpsAmount                = {0};
-        std::atomic_int locktOpsAmount               = {0};
-        std::atomic_int lockuOpsAmount               = {0};
-        std::atomic_int lookupOpsAmount              = {0};
-        std::atomic_int lookuppOpsAmount             = {0};
-        std::atomic_int nverifyOpsAmount             = {0};
-        std::atomic_int openOpsAmount                = {0};
-        std::atomic_int openattrOpsAmount            = {0};
-        std::atomic_int open_confirmOpsAmount        = {0};
-        std::atomic_int open_downgradeOpsAmount      = {0};
-        std::atomic_int putfhOpsAmount               = {0};
-        std::atomic_int putpubfhOpsAmount            = {0};
-        std::atomic_int putrootfhOpsAmount           = {0};
-        std::atomic_int readOpsAmount                = {0};
-        std::atomic_int readdirOpsAmount             = {0};
-        std::atomic_int readlinkOpsAmount            = {0};
-        std::atomic_int removeOpsAmount              = {0};
-        std::atomic_int renameOpsAmount              = {0};
-        std::atomic_int renewOpsAmount               = {0};
-        std::atomic_int restorefhOpsAmount           = {0};
-        std::atomic_int savefhOpsAmount              = {0};
-        std::atomic_int secinfoOpsAmount             = {0};
-        std::atomic_int setattrOpsAmount             = {0};
-        std::atomic_int setclientidOpsAmount         = {0};
-        std::atomic_int setclientid_confirmOpsAmount = {0};
-        std::atomic_int verifyOpsAmount              = {0};
-        std::atomic_int writeOpsAmount               = {0};
-        std::atomic_int release_lockownerOpsAmount   = {0};
-        std::atomic_int get_dir_delegationOpsAmount  = {0};
-        std::atomic_int illegalOpsAmount             = {0};
+        enum : std::size_t
+        {
+            // Procedures:
+            nullProcsAmount = NfsV3Stat::end,
+            compoundProcsAmount,
+
+            // Operations:
+            accessOpsAmount,
+            closeOpsAmount,
+            commitOpsAmount,
+            createOpsAmount,
+            delegpurgeOpsAmount,
+            delegreturnOpsAmount,
+            getattrOpsAmount,
+            getfhOpsAmount,
+            linkOpsAmount,
+            lockOpsAmount,
+            locktOpsAmount,
+            lockuOpsAmount,
+            lookupOpsAmount,
+            lookuppOpsAmount,
+            nverifyOpsAmount,
+            openOpsAmount,
+            openattrOpsAmount,
+            open_confirmOpsAmount,
+            open_downgradeOpsAmount,
+            putfhOpsAmount,
+            putpubfhOpsAmount,
+            putrootfhOpsAmount,
+            readOpsAmount,
+            readdirOpsAmount,
+            readlinkOpsAmount,
+            removeOpsAmount,
+            renameOpsAmount,
+            renewOpsAmount,
+            restorefhOpsAmount,
+            savefhOpsAmount,
+            secinfoOpsAmount,
+            setattrOpsAmount,
+            setclientidOpsAmount,
+            setclientid_confirmOpsAmount,
+            verifyOpsAmount,
+            writeOpsAmount,
+            release_lockownerOpsAmount,
+            get_dir_delegationOpsAmount,
+            illegalOpsAmount,
+            end
+        };
     };
+    //! Indexes of counters of NFSv4.1, they follow counters of NFSv4.0
     struct NfsV41Stat
     {
-        // Procedures:
-        std::atomic_int nullProcsAmount     = {0};
-        std::atomic_int compoundProcsAmount = {0};
-
-        // Operations:
-        std::atomic_int accessOpsAmount               = {0};
-        std::atomic_int closeOpsAmount                = {0};
-        std::atomic_int commitOpsAmount               = {0};
-        std::atomic_int createOpsAmount               = {0};
-        std::atomic_int delegpurgeOpsAmount           = {0};
-        std::atomic_int delegreturnOpsAmount          = {0};
-        std::atomic_int getattrOpsAmount              = {0};
-        std::atomic_int getfhOpsAmount                = {0};
-        std::atomic_int linkOpsAmount                 = {0};
-        std::atomic_int lockOpsAmount                 = {0};
-        std::atomic_int locktOpsAmount                = {0};
-        std::atomic_int lockuOpsAmount                = {0};
-        std::atomic_int lookupOpsAmount               = {0};
-        std::atomic_int lookuppOpsAmount              = {0};
-        std::atomic_int nverifyOpsAmount              = {0};
-        std::atomic_int openOpsAmount                 = {0};
-        std::atomic_int openattrOpsAmount             = {0};
-        std::atomic_int open_confirmOpsAmount         = {0};
-        std::atomic_int open_downgradeOpsAmount       = {0};
-        std::atomic_int putfhOpsAmount                = {0};
-        std::atomic_int putpubfhOpsAmount             = {0};
-        std::atomic_int putrootfhOpsAmount            = {0};
-        std::atomic_int readOpsAmount                 = {0};
-        std::atomic_int readdirOpsAmount              = {0};
-        std::atomic_int readlinkOpsAmount             = {0};
-        std::atomic_int removeOpsAmount               = {0};
-        std::atomic_int renameOpsAmount               = {0};
-        std::atomic_int renewOpsAmount                = {0};
-        std::atomic_int restorefhOpsAmount            = {0};
-        std::atomic_int savefhOpsAmount               = {0};
-        std::atomic_int secinfoOpsAmount              = {0};
-        std::atomic_int setattrOpsAmount              = {0};
-        std::atomic_int setclientidOpsAmount          = {0};
-        std::atomic_int setclientid_confirmOpsAmount  = {0};
-        std::atomic_int verifyOpsAmount               = {0};
-        std::atomic_int writeOpsAmount                = {0};
-        std::atomic_int release_lockownerOpsAmount    = {0};
-        std::atomic_int backchannel_ctlOpsAmount      = {0};
-        std::atomic_int bind_conn_to_sessionOpsAmount = {0};
-        std::atomic_int exchange_idOpsAmount          = {0};
-        std::atomic_int create_sessionOpsAmount       = {0};
-        std::atomic_int destroy_sessionOpsAmount      = {0};
-        std::atomic_int free_stateidOpsAmount         = {0};
-        std::atomic_int get_dir_delegationOpsAmount   = {0};
-        std::atomic_int getdeviceinfoOpsAmount        = {0};
-        std::atomic_int getdevicelistOpsAmount        = {0};
-        std::atomic_int layoutcommitOpsAmount         = {0};
-        std::atomic_int layoutgetOpsAmount            = {0};
-        std::atomic_int layoutreturnOpsAmount         = {0};
-        std::atomic_int secinfo_no_nameOpsAmount      = {0};
-        std::atomic_int sequenceOpsAmount             = {0};
-        std::atomic_int set_ssvOpsAmount              = {0};
-        std::atomic_int test_stateidOpsAmount         = {0};
-        std::atomic_int want_delegationOpsAmount      = {0};
-        std::atomic_int destroy_clientidOpsAmount     = {0};
-        std::atomic_int reclaim_completeOpsAmount     = {0};
-        std::atomic_int illegalOpsAmount              = {0};
+        enum : std::size_t
+        {
+            // Procedures:
+            nullProcsAmount = NfsV40Stat::end,
+            compoundProcsAmount,
+
+            // Operations:
+            accessOpsAmount,
+            closeOpsAmount,
+            commitOpsAmount,
+            createOpsAmount,
+            delegpurgeOpsAmount,
+            delegreturnOpsAmount,
+            getattrOpsAmount,
+            getfhOpsAmount,
+            linkOpsAmount,
+            lockOpsAmount,
+            locktOpsAmount,
+            lockuOpsAmount,
+            lookupOpsAmount,
+            lookuppOpsAmount,
+            nverifyOpsAmount,
+            openOpsAmount,
+            openattrOpsAmount,
+            open_confirmOpsAmount,
+            open_downgradeOpsAmount,
+            putfhOpsAmount,
+            putpubfhOpsAmount,
+            putrootfhOpsAmount,
+            readOpsAmount,
+            readdirOpsAmount,
+            readlinkOpsAmount,
+            removeOpsAmount,
+            renameOpsAmount,
+            renewOpsAmount,
+            restorefhOpsAmount,
+            savefhOpsAmount,
+            secinfoOpsAmount,
+            setattrOpsAmount,
+            setclientidOpsAmount,
+            setclientid_confirmOpsAmount,
+            verifyOpsAmount,
+            writeOpsAmount,
+            release_lockownerOpsAmount,
+            backchannel_ctlOpsAmount,
+            bind_conn_to_sessionOpsAmount,
+            exchange_idOpsAmount,
+            create_sessionOpsAmount,
+            destroy_sessionOpsAmount,
+            free_stateidOpsAmount,
+            get_dir_delegationOpsAmount,
+            getdeviceinfoOpsAmount,
+            getdevicelistOpsAmount,
+            layoutcommitOpsAmount,
+            layoutgetOpsAmount,
+            layoutreturnOpsAmount,
+            secinfo_no_nameOpsAmount,
+            sequenceOpsAmount,
+            set_ssvOpsAmount,
+            test_stateidOpsAmount,
+            want_delegationOpsAmount,
+            destroy_clientidOpsAmount,
+            reclaim_completeOpsAmount,
+            illegalOpsAmount,
+            end
+        };
     };
 
-    JsonAnalyzer(std::size_t workersAmount, int port, const std::string& host, std::size_t maxServingDurationMs, int backlog);
+    JsonAnalyzer(std::size_t workersAmount, int port, const std::string& host, std::size_t maxServingDurationMs, int backlog,
+                 std::size_t keepAliveTimeoutMs, std::size_t maxConnections, std::size_t snapshotIntervalMs, std::size_t historySize,
+                 std::size_t topSize, uint32_t halfLifeS, std::size_t metricsIntervalMs, std::size_t metricsHosts);
     ~JsonAnalyzer();
 
+    // Headers of NFS procedures, they are used for metrics of latencies and traffic and for top clients
+
+    void headers(const HeaderEvent* events, std::size_t count) override final;
+
+    // Records of operations, file handles of top files are taken from them
+
+    void records(const OpRecord* records, std::size_t count) override final;
+
     // NFSv3 procedures
 
     void null(const RPCProcedure* /*proc*/,
@@ -560,26 +586,26 @@ public:
 
     void flush_statistics() override final;
 
-    inline const NfsV3Stat& getNfsV3Stat() const
+    inline const CounterSet& getCounters() const
     {
-        return _nfsV3Stat;
+        return _counters;
     }
 
-    inline const NfsV40Stat& getNfsV40Stat() const
+    inline const MetricsRegistry& getMetrics() const
     {
-        return _nfsV40Stat;
+        return _metrics;
     }
 
-    inline const NfsV41Stat& getNfsV41Stat() const
+    inline const HeavyHitters& getHeavyHitters() const
     {
-        return _nfsV41Stat;
+        return _hitters;
     }
 
 private:
-    JsonTcpService _jsonTcpService;
-    NfsV3Stat      _nfsV3Stat;
-    NfsV40Stat     _nfsV40Stat;
-    NfsV41Stat     _nfsV41Stat;
+    JsonTcpService  _jsonTcpService;
+    CounterSet      _counters;
+    MetricsRegistry _metrics;
+    HeavyHitters    _hitters;
 };
 //------------------------------------------------------------------------------
 #endif //JSON_ANALYZER_H
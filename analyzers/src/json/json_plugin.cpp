@@ -25,9 +25,31 @@
 
 static constexpr int         DefaultPort                 = 8888;
 static constexpr const char* DefaultHost                 = IpEndpoint::WildcardAddress;
-static constexpr std::size_t DefaultWorkersAmount        = 10U;
+static constexpr std::size_t DefaultWorkersAmount        = 2U;
 static constexpr int         DefaultBacklog              = 15;
 static constexpr std::size_t DefaultMaxServingDurationMs = 500U;
+static constexpr std::size_t DefaultKeepAliveTimeoutMs   = AbstractTcpService::DefaultKeepAliveTimeoutMs;
+static constexpr std::size_t DefaultMaxConnections       = AbstractTcpService::DefaultMaxConnections;
+static constexpr std::size_t DefaultSnapshotIntervalMs   = JsonTcpService::DefaultSnapshotIntervalMs;
+static constexpr std::size_t DefaultHistorySize          = JsonTcpService::DefaultHistorySize;
+static constexpr std::size_t DefaultTopSize              = JsonTcpService::DefaultTopSize;
+static constexpr uint32_t    DefaultHalfLifeS            = HeavyHitters::DefaultHalfLifeS;
+static constexpr std::size_t DefaultMetricsIntervalMs    = JsonTcpService::DefaultMetricsIntervalMs;
+static constexpr std::size_t DefaultMetricsHosts         = MetricsRegistry::DefaultMaxHosts;
+
+//! Only NFS procedures and operations are counted, their bodies are not used.
+//! Metrics and top clients are accumulated from batches of headers of procedures,
+//! top files from batches of records of operations.
+static AnalyzerSubscription subscription()
+{
+    AnalyzerSubscription subscription;
+    subscription.smbv1.reset();
+    subscription.smbv2.reset();
+    subscription.bodies  = false;
+    subscription.batches = true;
+    subscription.records = true;
+    return subscription;
+}
 
 extern "C" {
 
@@ -35,9 +57,17 @@ const char* usage()
 {
     return "host - Network interface to listen (default is to listen all interfaces)\n"
            "port - IP-port to bind to (default is 8888)\n"
-           "workers - Amount of worker threads (default is 10)\n"
-           "duration - Max serving duration in milliseconds (default is 500 ms)\n"
-           "backlog - Listen backlog (default is 15)";
+           "workers - Amount of event loop threads (default is 2)\n"
+           "duration - Max serving duration of request in milliseconds (default is 500 ms)\n"
+           "backlog - Listen backlog (default is 15)\n"
+           "keepalive - Max idle duration of persistent connection in milliseconds (default is 5000 ms)\n"
+           "connections - Max amount of connections (default is 1024)\n"
+           "interval - Interval of rendering of JSON and top in milliseconds (default is 100 ms)\n"
+           "history - Amount of previous generations of JSON, deltas since them are available (default is 32)\n"
+           "top - Amount of top clients and files responded to /top (default is 10)\n"
+           "halflife - Half-life of counts of operations of top clients and files in seconds (default is 60, 0 disables decay)\n"
+           "metrics_interval - Interval of rendering of metrics in milliseconds (default is 1000 ms)\n"
+           "metrics_hosts - Max amount of pairs of client and server labeled in metrics, others are labeled as \"other\" (default is 1000)";
 }
 
 IAnalyzer* create(const char* opts)
@@ -46,8 +76,16 @@ IAnalyzer* create(const char* opts)
     int         backlog              = DefaultBacklog;
     std::size_t maxServingDurationMs = DefaultMaxServingDurationMs;
     std::string host{DefaultHost};
-    int         port          = DefaultPort;
-    std::size_t workersAmount = DefaultWorkersAmount;
+    int         port               = DefaultPort;
+    std::size_t workersAmount      = DefaultWorkersAmount;
+    std::size_t keepAliveTimeoutMs = DefaultKeepAliveTimeoutMs;
+    std::size_t maxConnections     = DefaultMaxConnections;
+    std::size_t snapshotIntervalMs = DefaultSnapshotIntervalMs;
+    std::size_t historySize        = DefaultHistorySize;
+    std::size_t topSize            = DefaultTopSize;
+    uint32_t    halfLifeS          = DefaultHalfLifeS;
+    std::size_t metricsIntervalMs  = DefaultMetricsIntervalMs;
+    std::size_t metricsHosts       = DefaultMetricsHosts;
     // Parising plugin options
     enum
     {
@@ -55,13 +93,29 @@ IAnalyzer* create(const char* opts)
         DURATION_SUBOPT_INDEX,
         HOST_SUBOPT_INDEX,
         PORT_SUBOPT_INDEX,
-        WORKERS_SUBOPT_INDEX
+        WORKERS_SUBOPT_INDEX,
+        KEEPALIVE_SUBOPT_INDEX,
+        CONNECTIONS_SUBOPT_INDEX,
+        INTERVAL_SUBOPT_INDEX,
+        HISTORY_SUBOPT_INDEX,
+        TOP_SUBOPT_INDEX,
+        HALFLIFE_SUBOPT_INDEX,
+        METRICS_INTERVAL_SUBOPT_INDEX,
+        METRICS_HOSTS_SUBOPT_INDEX
     };
-    char        backlogSubOptName[]  = "backlog";
-    char        durationSubOptName[] = "duration";
-    char        hostSubOptName[]     = "host";
-    char        portSubOptName[]     = "port";
-    char        workersSubOptName[]  = "workers";
+    char        backlogSubOptName[]         = "backlog";
+    char        durationSubOptName[]        = "duration";
+    char        hostSubOptName[]            = "host";
+    char        portSubOptName[]            = "port";
+    char        workersSubOptName[]         = "workers";
+    char        keepaliveSubOptName[]       = "keepalive";
+    char        connectionsSubOptName[]     = "connections";
+    char        intervalSubOptName[]        = "interval";
+    char        historySubOptName[]         = "history";
+    char        topSubOptName[]             = "top";
+    char        halflifeSubOptName[]        = "halflife";
+    char        metricsIntervalSubOptName[] = "metrics_interval";
+    char        metricsHostsSubOptName[]    = "metrics_hosts";
     char* const tokens[] =
         {
             backlogSubOptName,
@@ -69,6 +123,14 @@ IAnalyzer* create(const char* opts)
             hostSubOptName,
             portSubOptName,
             workersSubOptName,
+            keepaliveSubOptName,
+            connectionsSubOptName,
+            intervalSubOptName,
+            historySubOptName,
+            topSubOptName,
+            halflifeSubOptName,
+            metricsIntervalSubOptName,
+            metricsHostsSubOptName,
             NULL};
     std::size_t       optsLen = strlen(opts);
     std::vector<char> optsBuf{opts, opts + optsLen + 2};
@@ -96,6 +158,30 @@ IAnalyzer* create(const char* opts)
             case WORKERS_SUBOPT_INDEX:
                 workersAmount = std::stoul(valuep);
                 break;
+            case KEEPALIVE_SUBOPT_INDEX:
+                keepAliveTimeoutMs = std::stoul(valuep);
+                break;
+            case CONNECTIONS_SUBOPT_INDEX:
+                maxConnections = std::stoul(valuep);
+                break;
+            case INTERVAL_SUBOPT_INDEX:
+                snapshotIntervalMs = std::stoul(valuep);
+                break;
+            case HISTORY_SUBOPT_INDEX:
+                historySize = std::stoul(valuep);
+                break;
+            case TOP_SUBOPT_INDEX:
+                topSize = std::stoul(valuep);
+                break;
+            case HALFLIFE_SUBOPT_INDEX:
+                halfLifeS = std::stoul(valuep);
+                break;
+            case METRICS_INTERVAL_SUBOPT_INDEX:
+                metricsIntervalMs = std::stoul(valuep);
+                break;
+            case METRICS_HOSTS_SUBOPT_INDEX:
+                metricsHosts = std::stoul(valuep);
+                break;
             default:
                 throw std::runtime_error{std::string{"Invalid suboption index: "} + std::to_string(optIndex)};
             }
@@ -106,7 +192,12 @@ IAnalyzer* create(const char* opts)
         }
     }
     // Creating and returning plugin
-    return new JsonAnalyzer{workersAmount, port, host, maxServingDurationMs, backlog};
+    if(workersAmount == 0 || maxConnections == 0 || snapshotIntervalMs == 0 || metricsIntervalMs == 0)
+    {
+        throw std::runtime_error{"Amount of workers and connections and intervals must be positive"};
+    }
+    return new JsonAnalyzer{workersAmount, port, host, maxServingDurationMs, backlog, keepAliveTimeoutMs, maxConnections, snapshotIntervalMs, historySize, topSize, halfLifeS,
+                            metricsIntervalMs, metricsHosts};
 }
 
 void destroy(IAnalyzer* instance)
@@ -114,7 +205,15 @@ void destroy(IAnalyzer* instance)
     delete instance;
 }
 
-NST_PLUGIN_ENTRY_POINTS(&usage, &create, &destroy, nullptr)
+const AnalyzerRequirements* requirements()
+{
+    // callbacks may be called by parser threads concurrently: counters are in per-thread CounterSet slots,
+    // MetricsRegistry and HeavyHitters are guarded by their own mutexes
+    static const AnalyzerRequirements requirements{false, subscription(), AnalyzerThreading::ThreadSafe};
+    return &requirements;
+}
+
+NST_PLUGIN_ENTRY_POINTS(&usage, &create, &destroy, &requirements)
 
 } //extern "C"
 
@@ -19,223 +19,604 @@
     along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
 */
 //------------------------------------------------------------------------------
-#include <chrono>
-
-#include <json.h>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 
 #include "json_analyzer.h"
 #include "json_tcp_service.h"
 #include "utils/log.h"
 //------------------------------------------------------------------------------
+namespace
+{
+//! Counter of statistics and its name, it is a key in JSON and a label of metrics
+struct Field
+{
+    const char* name;
+    std::size_t size;    //!< Length of name
+    std::size_t counter; //!< Index of counter in JsonAnalyzer::getCounters()
+};
 
-JsonTcpService::JsonTcpService(JsonAnalyzer& analyzer, std::size_t workersAmount, int port, const std::string& host,
-                               std::size_t maxServingDurationMs, int backlog)
-    : AbstractTcpService{workersAmount, port, host, backlog}
-    , _analyzer(analyzer)
-    , _maxServingDurationMs{maxServingDurationMs}
+#define JSON_FIELD(Stat, name, counter) {name, sizeof(name) - 1, JsonAnalyzer::Stat::counter}
+
+const Field nfsV3Fields[] = {
+    JSON_FIELD(NfsV3Stat, "null", nullProcsAmount),
+    JSON_FIELD(NfsV3Stat, "getattr", getattrProcsAmount),
+    JSON_FIELD(NfsV3Stat, "setattr", setattrProcsAmount),
+    JSON_FIELD(NfsV3Stat, "lookup", lookupProcsAmount),
+    JSON_FIELD(NfsV3Stat, "access", accessProcsAmount),
+    JSON_FIELD(NfsV3Stat, "readlink", readlinkProcsAmount),
+    JSON_FIELD(NfsV3Stat, "read", readProcsAmount),
+    JSON_FIELD(NfsV3Stat, "write", writeProcsAmount),
+    JSON_FIELD(NfsV3Stat, "create", createProcsAmount),
+    JSON_FIELD(NfsV3Stat, "mkdir", mkdirProcsAmount),
+    JSON_FIELD(NfsV3Stat, "symlink", symlinkProcsAmount),
+    JSON_FIELD(NfsV3Stat, "mkdnod", mknodProcsAmount),
+    JSON_FIELD(NfsV3Stat, "remove", removeProcsAmount),
+    JSON_FIELD(NfsV3Stat, "rmdir", rmdirProcsAmount),
+    JSON_FIELD(NfsV3Stat, "rename", renameProcsAmount),
+    JSON_FIELD(NfsV3Stat, "link", linkProcsAmount),
+    JSON_FIELD(NfsV3Stat, "readdir", readdirProcsAmount),
+    JSON_FIELD(NfsV3Stat, "readdirplus", readdirplusProcsAmount),
+    JSON_FIELD(NfsV3Stat, "fsstat", fsstatProcsAmount),
+    JSON_FIELD(NfsV3Stat, "fsinfo", fsinfoProcsAmount),
+    JSON_FIELD(NfsV3Stat, "pathconf", pathconfProcsAmount),
+    JSON_FIELD(NfsV3Stat, "commit", commitProcsAmount)
+};
+
+const Field nfsV40Fields[] = {
+    JSON_FIELD(NfsV40Stat, "null", nullProcsAmount),
+    JSON_FIELD(NfsV40Stat, "compound", compoundProcsAmount),
+    JSON_FIELD(NfsV40Stat, "access", accessOpsAmount),
+    JSON_FIELD(NfsV40Stat, "close", closeOpsAmount),
+    JSON_FIELD(NfsV40Stat, "commit", commitOpsAmount),
+    JSON_FIELD(NfsV40Stat, "create", createOpsAmount),
+    JSON_FIELD(NfsV40Stat, "delegpurge", delegpurgeOpsAmount),
+    JSON_FIELD(NfsV40Stat, "delegreturn", delegreturnOpsAmount),
+    JSON_FIELD(NfsV40Stat, "getattr", getattrOpsAmount),
+    JSON_FIELD(NfsV40Stat, "getfh", getfhOpsAmount),
+    JSON_FIELD(NfsV40Stat, "link", linkOpsAmount),
+    JSON_FIELD(NfsV40Stat, "lock", lockOpsAmount),
+    JSON_FIELD(NfsV40Stat, "lockt", locktOpsAmount),
+    JSON_FIELD(NfsV40Stat, "locku", lockuOpsAmount),
+    JSON_FIELD(NfsV40Stat, "lookup", lookupOpsAmount),
+    JSON_FIELD(NfsV40Stat, "lookupp", lookuppOpsAmount),
+    JSON_FIELD(NfsV40Stat, "nverify", nverifyOpsAmount),
+    JSON_FIELD(NfsV40Stat, "open", openOpsAmount),
+    JSON_FIELD(NfsV40Stat, "openattr", openattrOpsAmount),
+    JSON_FIELD(NfsV40Stat, "open_confirm", open_confirmOpsAmount),
+    JSON_FIELD(NfsV40Stat, "open_downgrade", open_downgradeOpsAmount),
+    JSON_FIELD(NfsV40Stat, "putfh", putfhOpsAmount),
+    JSON_FIELD(NfsV40Stat, "putpubfh", putpubfhOpsAmount),
+    JSON_FIELD(NfsV40Stat, "putrootfh", putrootfhOpsAmount),
+    JSON_FIELD(NfsV40Stat, "read", readOpsAmount),
+    JSON_FIELD(NfsV40Stat, "readdir", readdirOpsAmount),
+    JSON_FIELD(NfsV40Stat, "readlink", readlinkOpsAmount),
+    JSON_FIELD(NfsV40Stat, "remove", removeOpsAmount),
+    JSON_FIELD(NfsV40Stat, "rename", renameOpsAmount),
+    JSON_FIELD(NfsV40Stat, "renew", renewOpsAmount),
+    JSON_FIELD(NfsV40Stat, "restorefh", restorefhOpsAmount),
+    JSON_FIELD(NfsV40Stat, "savefh", savefhOpsAmount),
+    JSON_FIELD(NfsV40Stat, "secinfo", secinfoOpsAmount),
+    JSON_FIELD(NfsV40Stat, "setattr", setattrOpsAmount),
+    JSON_FIELD(NfsV40Stat, "setclientid", setclientidOpsAmount),
+    JSON_FIELD(NfsV40Stat, "setclientid_confirm", setclientid_confirmOpsAmount),
+    JSON_FIELD(NfsV40Stat, "verify", verifyOpsAmount),
+    JSON_FIELD(NfsV40Stat, "write", writeOpsAmount),
+    JSON_FIELD(NfsV40Stat, "release_lockowner", release_lockownerOpsAmount),
+    JSON_FIELD(NfsV40Stat, "get_dir_delegation", get_dir_delegationOpsAmount),
+    JSON_FIELD(NfsV40Stat, "illegal", illegalOpsAmount)
+};
+
+const Field nfsV41Fields[] = {
+    JSON_FIELD(NfsV41Stat, "null", nullProcsAmount),
+    JSON_FIELD(NfsV41Stat, "compound", compoundProcsAmount),
+    JSON_FIELD(NfsV41Stat, "access", accessOpsAmount),
+    JSON_FIELD(NfsV41Stat, "close", closeOpsAmount),
+    JSON_FIELD(NfsV41Stat, "commit", commitOpsAmount),
+    JSON_FIELD(NfsV41Stat, "create", createOpsAmount),
+    JSON_FIELD(NfsV41Stat, "delegpurge", delegpurgeOpsAmount),
+    JSON_FIELD(NfsV41Stat, "delegreturn", delegreturnOpsAmount),
+    JSON_FIELD(NfsV41Stat, "getattr", getattrOpsAmount),
+    JSON_FIELD(NfsV41Stat, "getfh", getfhOpsAmount),
+    JSON_FIELD(NfsV41Stat, "link", linkOpsAmount),
+    JSON_FIELD(NfsV41Stat, "lock", lockOpsAmount),
+    JSON_FIELD(NfsV41Stat, "lockt", locktOpsAmount),
+    JSON_FIELD(NfsV41Stat, "locku", lockuOpsAmount),
+    JSON_FIELD(NfsV41Stat, "lookup", lookupOpsAmount),
+    JSON_FIELD(NfsV41Stat, "lookupp", lookuppOpsAmount),
+    JSON_FIELD(NfsV41Stat, "nverify", nverifyOpsAmount),
+    JSON_FIELD(NfsV41Stat, "open", openOpsAmount),
+    JSON_FIELD(NfsV41Stat, "openattr", openattrOpsAmount),
+    JSON_FIELD(NfsV41Stat, "open_confirm", open_confirmOpsAmount),
+    JSON_FIELD(NfsV41Stat, "open_downgrade", open_downgradeOpsAmount),
+    JSON_FIELD(NfsV41Stat, "putfh", putfhOpsAmount),
+    JSON_FIELD(NfsV41Stat, "putpubfh", putpubfhOpsAmount),
+    JSON_FIELD(NfsV41Stat, "putrootfh", putrootfhOpsAmount),
+    JSON_FIELD(NfsV41Stat, "read", readOpsAmount),
+    JSON_FIELD(NfsV41Stat, "readdir", readdirOpsAmount),
+    JSON_FIELD(NfsV41Stat, "readlink", readlinkOpsAmount),
+    JSON_FIELD(NfsV41Stat, "remove", removeOpsAmount),
+    JSON_FIELD(NfsV41Stat, "rename", renameOpsAmount),
+    JSON_FIELD(NfsV41Stat, "renew", renewOpsAmount),
+    JSON_FIELD(NfsV41Stat, "restorefh", restorefhOpsAmount),
+    JSON_FIELD(NfsV41Stat, "savefh", savefhOpsAmount),
+    JSON_FIELD(NfsV41Stat, "secinfo", secinfoOpsAmount),
+    JSON_FIELD(NfsV41Stat, "setattr", setattrOpsAmount),
+    JSON_FIELD(NfsV41Stat, "setclientid", setclientidOpsAmount),
+    JSON_FIELD(NfsV41Stat, "setclientid_confirm", setclientid_confirmOpsAmount),
+    JSON_FIELD(NfsV41Stat, "verify", verifyOpsAmount),
+    JSON_FIELD(NfsV41Stat, "write", writeOpsAmount),
+    JSON_FIELD(NfsV41Stat, "release_lockowner", release_lockownerOpsAmount),
+    JSON_FIELD(NfsV41Stat, "backchannel_ctl", backchannel_ctlOpsAmount),
+    JSON_FIELD(NfsV41Stat, "bind_conn_to_session", bind_conn_to_sessionOpsAmount),
+    JSON_FIELD(NfsV41Stat, "exchange_id", exchange_idOpsAmount),
+    JSON_FIELD(NfsV41Stat, "create_session", create_sessionOpsAmount),
+    JSON_FIELD(NfsV41Stat, "destroy_session", destroy_sessionOpsAmount),
+    JSON_FIELD(NfsV41Stat, "free_stateid", free_stateidOpsAmount),
+    JSON_FIELD(NfsV41Stat, "get_dir_delegation", get_dir_delegationOpsAmount),
+    JSON_FIELD(NfsV41Stat, "getdeviceinfo", getdeviceinfoOpsAmount),
+    JSON_FIELD(NfsV41Stat, "getdevicelist", getdevicelistOpsAmount),
+    JSON_FIELD(NfsV41Stat, "layoutcommit", layoutcommitOpsAmount),
+    JSON_FIELD(NfsV41Stat, "layoutget", layoutgetOpsAmount),
+    JSON_FIELD(NfsV41Stat, "layoutreturn", layoutreturnOpsAmount),
+    JSON_FIELD(NfsV41Stat, "secinfo_no_name", secinfo_no_nameOpsAmount),
+    JSON_FIELD(NfsV41Stat, "sequence", sequenceOpsAmount),
+    JSON_FIELD(NfsV41Stat, "set_ssv", set_ssvOpsAmount),
+    JSON_FIELD(NfsV41Stat, "test_stateid", test_stateidOpsAmount),
+    JSON_FIELD(NfsV41Stat, "want_delegation", want_delegationOpsAmount),
+    JSON_FIELD(NfsV41Stat, "destroy_clientid", destroy_clientidOpsAmount),
+    JSON_FIELD(NfsV41Stat, "reclaim_complete", reclaim_completeOpsAmount),
+    JSON_FIELD(NfsV41Stat, "illegal", illegalOpsAmount)
+};
+
+#undef JSON_FIELD
+
+static_assert(sizeof(nfsV3Fields) / sizeof(Field) == JsonAnalyzer::NfsV3Stat::end - JsonAnalyzer::NfsV3Stat::nullProcsAmount, "Every counter of NFSv3 must be rendered");
+static_assert(sizeof(nfsV40Fields) / sizeof(Field) == JsonAnalyzer::NfsV40Stat::end - JsonAnalyzer::NfsV40Stat::nullProcsAmount, "Every counter of NFSv4.0 must be rendered");
+static_assert(sizeof(nfsV41Fields) / sizeof(Field) == JsonAnalyzer::NfsV41Stat::end - JsonAnalyzer::NfsV41Stat::nullProcsAmount, "Every counter of NFSv4.1 must be rendered");
+
+void appendInteger(std::string& json, uint64_t value)
 {
+    char  digits[20];
+    char* end   = digits + sizeof(digits);
+    char* begin = end;
+    do
+    {
+        *--begin = '0' + value % 10;
+        value /= 10;
+    } while(value != 0);
+    json.append(begin, end);
 }
 
-AbstractTcpService::AbstractTask* JsonTcpService::createTask(int socket)
+//! Appends object followed by comma, only counters which differ from previous ones are appended
+//! Object without counters is skipped
+template <std::size_t N>
+void appendObject(std::string& json, const char* key, const std::vector<uint64_t>& counters,
+                  const std::vector<uint64_t>* previous, const Field (&fields)[N])
 {
-    return new Task(*this, socket);
+    char separator = '{';
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        const std::size_t counter = fields[i].counter;
+        if(previous && (*previous)[counter] == counters[counter])
+        {
+            continue;
+        }
+        if(separator == '{')
+        {
+            json += key;
+        }
+        json += separator;
+        json += '"';
+        json.append(fields[i].name, fields[i].size);
+        json += "\":";
+        appendInteger(json, counters[counter]);
+        separator = ',';
+    }
+    if(separator == ',')
+    {
+        json += "},";
+    }
 }
 
-//------------------------------------------------------------------------------
+//! Renders JSON of all counters, or of changed ones since previous generation
+void renderDocument(std::string& json, const std::vector<uint64_t>& counters,
+                    const std::vector<uint64_t>* previous, uint64_t generation, uint64_t since)
+{
+    json += '{';
+    appendObject(json, "\"nfs_v3\":", counters, previous, nfsV3Fields);
+    appendObject(json, "\"nfs_v40\":", counters, previous, nfsV40Fields);
+    appendObject(json, "\"nfs_v41\":", counters, previous, nfsV41Fields);
+    json += "\"generation\":";
+    appendInteger(json, generation);
+    if(previous)
+    {
+        json += ",\"since\":";
+        appendInteger(json, since);
+    }
+    json += '}';
+}
 
-JsonTcpService::Task::Task(JsonTcpService& service, int socket)
-    : AbstractTask{socket}
-    , _service(service)
-{
-}
-
-void JsonTcpService::Task::execute()
-{
-    std::chrono::system_clock::time_point servingStarted = std::chrono::system_clock::now();
-    // Composing JSON with statistics
-    struct json_object* root      = json_object_new_object();
-    struct json_object* nfsV3Stat = json_object_new_object();
-    // NFS3 procedures:
-    json_object_object_add(nfsV3Stat, "null", json_object_new_int64(_service._analyzer.getNfsV3Stat().nullProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "getattr", json_object_new_int64(_service._analyzer.getNfsV3Stat().getattrProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "setattr", json_object_new_int64(_service._analyzer.getNfsV3Stat().setattrProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "lookup", json_object_new_int64(_service._analyzer.getNfsV3Stat().lookupProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "access", json_object_new_int64(_service._analyzer.getNfsV3Stat().accessProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "readlink", json_object_new_int64(_service._analyzer.getNfsV3Stat().readlinkProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "read", json_object_new_int64(_service._analyzer.getNfsV3Stat().readProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "write", json_object_new_int64(_service._analyzer.getNfsV3Stat().writeProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "create", json_object_new_int64(_service._analyzer.getNfsV3Stat().createProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "mkdir", json_object_new_int64(_service._analyzer.getNfsV3Stat().mkdirProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "symlink", json_object_new_int64(_service._analyzer.getNfsV3Stat().symlinkProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "mkdnod", json_object_new_int64(_service._analyzer.getNfsV3Stat().mknodProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "remove", json_object_new_int64(_service._analyzer.getNfsV3Stat().removeProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "rmdir", json_object_new_int64(_service._analyzer.getNfsV3Stat().rmdirProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "rename", json_object_new_int64(_service._analyzer.getNfsV3Stat().renameProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "link", json_object_new_int64(_service._analyzer.getNfsV3Stat().linkProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "readdir", json_object_new_int64(_service._analyzer.getNfsV3Stat().readdirProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "readdirplus", json_object_new_int64(_service._analyzer.getNfsV3Stat().readdirplusProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "fsstat", json_object_new_int64(_service._analyzer.getNfsV3Stat().fsstatProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "fsinfo", json_object_new_int64(_service._analyzer.getNfsV3Stat().fsinfoProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "pathconf", json_object_new_int64(_service._analyzer.getNfsV3Stat().pathconfProcsAmount.load()));
-    json_object_object_add(nfsV3Stat, "commit", json_object_new_int64(_service._analyzer.getNfsV3Stat().commitProcsAmount.load()));
-    json_object_object_add(root, "nfs_v3", nfsV3Stat);
-    struct json_object* nfsV40Stat = json_object_new_object();
-    // NFS4.0 procedures:
-    json_object_object_add(nfsV40Stat, "null", json_object_new_int64(_service._analyzer.getNfsV40Stat().nullProcsAmount.load()));
-    json_object_object_add(nfsV40Stat, "compound", json_object_new_int64(_service._analyzer.getNfsV40Stat().compoundProcsAmount.load()));
-    // NFS4.0 operations:
-    json_object_object_add(nfsV40Stat, "access", json_object_new_int64(_service._analyzer.getNfsV40Stat().accessOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "close", json_object_new_int64(_service._analyzer.getNfsV40Stat().closeOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "commit", json_object_new_int64(_service._analyzer.getNfsV40Stat().commitOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "create", json_object_new_int64(_service._analyzer.getNfsV40Stat().createOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "delegpurge", json_object_new_int64(_service._analyzer.getNfsV40Stat().delegpurgeOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "delegreturn", json_object_new_int64(_service._analyzer.getNfsV40Stat().delegreturnOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "getattr", json_object_new_int64(_service._analyzer.getNfsV40Stat().getattrOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "getfh", json_object_new_int64(_service._analyzer.getNfsV40Stat().getfhOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "link", json_object_new_int64(_service._analyzer.getNfsV40Stat().linkOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "lock", json_object_new_int64(_service._analyzer.getNfsV40Stat().lockOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "lockt", json_object_new_int64(_service._analyzer.getNfsV40Stat().locktOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "locku", json_object_new_int64(_service._analyzer.getNfsV40Stat().lockuOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "lookup", json_object_new_int64(_service._analyzer.getNfsV40Stat().lookupOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "lookupp", json_object_new_int64(_service._analyzer.getNfsV40Stat().lookuppOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "nverify", json_object_new_int64(_service._analyzer.getNfsV40Stat().nverifyOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "open", json_object_new_int64(_service._analyzer.getNfsV40Stat().openOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "openattr", json_object_new_int64(_service._analyzer.getNfsV40Stat().openattrOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "open_confirm", json_object_new_int64(_service._analyzer.getNfsV40Stat().open_confirmOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "open_downgrade", json_object_new_int64(_service._analyzer.getNfsV40Stat().open_downgradeOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "putfh", json_object_new_int64(_service._analyzer.getNfsV40Stat().putfhOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "putpubfh", json_object_new_int64(_service._analyzer.getNfsV40Stat().putpubfhOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "putrootfh", json_object_new_int64(_service._analyzer.getNfsV40Stat().putrootfhOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "read", json_object_new_int64(_service._analyzer.getNfsV40Stat().readOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "readdir", json_object_new_int64(_service._analyzer.getNfsV40Stat().readdirOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "readlink", json_object_new_int64(_service._analyzer.getNfsV40Stat().readlinkOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "remove", json_object_new_int64(_service._analyzer.getNfsV40Stat().removeOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "rename", json_object_new_int64(_service._analyzer.getNfsV40Stat().renameOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "renew", json_object_new_int64(_service._analyzer.getNfsV40Stat().renewOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "restorefh", json_object_new_int64(_service._analyzer.getNfsV40Stat().restorefhOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "savefh", json_object_new_int64(_service._analyzer.getNfsV40Stat().savefhOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "secinfo", json_object_new_int64(_service._analyzer.getNfsV40Stat().secinfoOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "setattr", json_object_new_int64(_service._analyzer.getNfsV40Stat().setattrOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "setclientid", json_object_new_int64(_service._analyzer.getNfsV40Stat().setclientidOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "setclientid_confirm", json_object_new_int64(_service._analyzer.getNfsV40Stat().setclientid_confirmOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "verify", json_object_new_int64(_service._analyzer.getNfsV40Stat().verifyOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "write", json_object_new_int64(_service._analyzer.getNfsV40Stat().writeOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "release_lockowner", json_object_new_int64(_service._analyzer.getNfsV40Stat().release_lockownerOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "get_dir_delegation", json_object_new_int64(_service._analyzer.getNfsV40Stat().get_dir_delegationOpsAmount.load()));
-    json_object_object_add(nfsV40Stat, "illegal", json_object_new_int64(_service._analyzer.getNfsV40Stat().illegalOpsAmount.load()));
-    json_object_object_add(root, "nfs_v40", nfsV40Stat);
-    struct json_object* nfsV41Stat = json_object_new_object();
-    // NFS4.1 procedures:
-    json_object_object_add(nfsV41Stat, "null", json_object_new_int64(_service._analyzer.getNfsV41Stat().nullProcsAmount.load()));
-    json_object_object_add(nfsV41Stat, "compound", json_object_new_int64(_service._analyzer.getNfsV41Stat().compoundProcsAmount.load()));
-    // NFS4.1 operations:
-    json_object_object_add(nfsV41Stat, "access", json_object_new_int64(_service._analyzer.getNfsV41Stat().accessOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "close", json_object_new_int64(_service._analyzer.getNfsV41Stat().closeOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "commit", json_object_new_int64(_service._analyzer.getNfsV41Stat().commitOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "create", json_object_new_int64(_service._analyzer.getNfsV41Stat().createOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "delegpurge", json_object_new_int64(_service._analyzer.getNfsV41Stat().delegpurgeOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "delegreturn", json_object_new_int64(_service._analyzer.getNfsV41Stat().delegreturnOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "getattr", json_object_new_int64(_service._analyzer.getNfsV41Stat().getattrOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "getfh", json_object_new_int64(_service._analyzer.getNfsV41Stat().getfhOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "link", json_object_new_int64(_service._analyzer.getNfsV41Stat().linkOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "lock", json_object_new_int64(_service._analyzer.getNfsV41Stat().lockOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "lockt", json_object_new_int64(_service._analyzer.getNfsV41Stat().locktOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "locku", json_object_new_int64(_service._analyzer.getNfsV41Stat().lockuOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "lookup", json_object_new_int64(_service._analyzer.getNfsV41Stat().lookupOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "lookupp", json_object_new_int64(_service._analyzer.getNfsV41Stat().lookuppOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "nverify", json_object_new_int64(_service._analyzer.getNfsV41Stat().nverifyOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "open", json_object_new_int64(_service._analyzer.getNfsV41Stat().openOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "openattr", json_object_new_int64(_service._analyzer.getNfsV41Stat().openattrOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "open_confirm", json_object_new_int64(_service._analyzer.getNfsV41Stat().open_confirmOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "open_downgrade", json_object_new_int64(_service._analyzer.getNfsV41Stat().open_downgradeOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "putfh", json_object_new_int64(_service._analyzer.getNfsV41Stat().putfhOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "putpubfh", json_object_new_int64(_service._analyzer.getNfsV41Stat().putpubfhOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "putrootfh", json_object_new_int64(_service._analyzer.getNfsV41Stat().putrootfhOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "read", json_object_new_int64(_service._analyzer.getNfsV41Stat().readOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "readdir", json_object_new_int64(_service._analyzer.getNfsV41Stat().readdirOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "readlink", json_object_new_int64(_service._analyzer.getNfsV41Stat().readlinkOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "remove", json_object_new_int64(_service._analyzer.getNfsV41Stat().removeOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "rename", json_object_new_int64(_service._analyzer.getNfsV41Stat().renameOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "renew", json_object_new_int64(_service._analyzer.getNfsV41Stat().renewOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "restorefh", json_object_new_int64(_service._analyzer.getNfsV41Stat().restorefhOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "savefh", json_object_new_int64(_service._analyzer.getNfsV41Stat().savefhOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "secinfo", json_object_new_int64(_service._analyzer.getNfsV41Stat().secinfoOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "setattr", json_object_new_int64(_service._analyzer.getNfsV41Stat().setattrOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "setclientid", json_object_new_int64(_service._analyzer.getNfsV41Stat().setclientidOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "setclientid_confirm", json_object_new_int64(_service._analyzer.getNfsV41Stat().setclientid_confirmOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "verify", json_object_new_int64(_service._analyzer.getNfsV41Stat().verifyOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "write", json_object_new_int64(_service._analyzer.getNfsV41Stat().writeOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "release_lockowner", json_object_new_int64(_service._analyzer.getNfsV41Stat().release_lockownerOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "backchannel_ctl", json_object_new_int64(_service._analyzer.getNfsV41Stat().backchannel_ctlOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "bind_conn_to_session", json_object_new_int64(_service._analyzer.getNfsV41Stat().bind_conn_to_sessionOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "exchange_id", json_object_new_int64(_service._analyzer.getNfsV41Stat().exchange_idOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "create_session", json_object_new_int64(_service._analyzer.getNfsV41Stat().create_sessionOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "destroy_session", json_object_new_int64(_service._analyzer.getNfsV41Stat().destroy_sessionOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "free_stateid", json_object_new_int64(_service._analyzer.getNfsV41Stat().free_stateidOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "get_dir_delegation", json_object_new_int64(_service._analyzer.getNfsV41Stat().get_dir_delegationOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "getdeviceinfo", json_object_new_int64(_service._analyzer.getNfsV41Stat().getdeviceinfoOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "getdevicelist", json_object_new_int64(_service._analyzer.getNfsV41Stat().getdevicelistOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "layoutcommit", json_object_new_int64(_service._analyzer.getNfsV41Stat().layoutcommitOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "layoutget", json_object_new_int64(_service._analyzer.getNfsV41Stat().layoutgetOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "layoutreturn", json_object_new_int64(_service._analyzer.getNfsV41Stat().layoutreturnOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "secinfo_no_name", json_object_new_int64(_service._analyzer.getNfsV41Stat().secinfo_no_nameOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "sequence", json_object_new_int64(_service._analyzer.getNfsV41Stat().sequenceOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "set_ssv", json_object_new_int64(_service._analyzer.getNfsV41Stat().set_ssvOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "test_stateid", json_object_new_int64(_service._analyzer.getNfsV41Stat().test_stateidOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "want_delegation", json_object_new_int64(_service._analyzer.getNfsV41Stat().want_delegationOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "destroy_clientid", json_object_new_int64(_service._analyzer.getNfsV41Stat().destroy_clientidOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "reclaim_complete", json_object_new_int64(_service._analyzer.getNfsV41Stat().reclaim_completeOpsAmount.load()));
-    json_object_object_add(nfsV41Stat, "illegal", json_object_new_int64(_service._analyzer.getNfsV41Stat().illegalOpsAmount.load()));
-    json_object_object_add(root, "nfs_v41", nfsV41Stat);
-    std::string json(json_object_to_json_string_ext(root, JSON_C_TO_STRING_PRETTY));
-    json_object_put(root);
-
-    // Sending JSON to the client
-    std::size_t totalBytesSent = 0U;
-    while(totalBytesSent < json.length())
-    {
-        if(!_service.isRunning())
+//! Finds value of parameter in query of request target
+bool findParameter(const std::string& query, const std::string& name, std::string& value)
+{
+    for(std::size_t begin = 0; begin < query.size();)
+    {
+        std::size_t end = query.find('&', begin);
+        if(end == std::string::npos)
+        {
+            end = query.size();
+        }
+        if(query.compare(begin, name.size(), name) == 0 && query[begin + name.size()] == '=')
+        {
+            value = query.substr(begin + name.size() + 1, end - begin - name.size() - 1);
+            return true;
+        }
+        begin = end + 1;
+    }
+    return false;
+}
+
+const std::string badRequest{"HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"};
+
+//! Appends nanoseconds as decimal fraction of seconds
+void appendSeconds(std::string& text, uint64_t ns)
+{
+    appendInteger(text, ns / 1000000000);
+    char fraction[11];
+    std::snprintf(fraction, sizeof(fraction), ".%09u", static_cast<unsigned>(ns % 1000000000));
+    text += fraction;
+}
+
+//! Appends counters of operations of NFSv4.x, the first fields are procedures
+template <std::size_t N>
+void appendOperations(std::string& text, const char* protocol, const std::vector<uint64_t>& counters, const Field (&fields)[N])
+{
+    for(std::size_t i = 2; i < N; ++i)
+    {
+        text += "nfstrace_operations_total{protocol=\"";
+        text += protocol;
+        text += "\",operation=\"";
+        text.append(fields[i].name, fields[i].size);
+        text += "\"} ";
+        appendInteger(text, counters[fields[i].counter]);
+        text += '\n';
+    }
+}
+
+const char* protocolName(NST::API::Protocol protocol)
+{
+    switch(protocol)
+    {
+    case NST::API::Protocol::NFSv3:
+        return "nfs_v3";
+    case NST::API::Protocol::NFSv40:
+        return "nfs_v40";
+    case NST::API::Protocol::NFSv41:
+        return "nfs_v41";
+    default:
+        return "unknown";
+    }
+}
+
+const char* procedureName(NST::API::Protocol protocol, uint32_t procedure)
+{
+    switch(protocol)
+    {
+    case NST::API::Protocol::NFSv3:
+        return nfsV3Fields[procedure].name;
+    case NST::API::Protocol::NFSv40:
+        return nfsV40Fields[procedure].name;
+    default:
+        return nfsV41Fields[procedure].name;
+    }
+}
+
+//! Appends labels of series without closing brace
+void appendLabels(std::string& text, const char* family, const MetricsRegistry::Series& series, const std::string& hosts)
+{
+    text += family;
+    text += "{protocol=\"";
+    text += protocolName(series.protocol);
+    text += "\",procedure=\"";
+    text += procedureName(series.protocol, series.procedure);
+    text += "\",";
+    text += hosts;
+}
+} // namespace
+
+JsonTcpService::JsonTcpService(JsonAnalyzer& analyzer, std::size_t workersAmount, int port, const std::string& host,
+                               std::size_t maxServingDurationMs, int backlog, std::size_t keepAliveTimeoutMs,
+                               std::size_t maxConnections, std::size_t snapshotIntervalMs, std::size_t historySize, std::size_t topSize,
+                               std::size_t metricsIntervalMs)
+    : AbstractTcpService{workersAmount, port, host, maxServingDurationMs, backlog, keepAliveTimeoutMs, maxConnections}
+    , _analyzer(analyzer)
+    , _historySize{historySize}
+    , _topSize{topSize}
+    , _snapshots{[this](Document& next, const Document& previous) { renderJson(next, previous); }, snapshotIntervalMs}
+    , _metricsSnapshots{[this](std::string& text, const std::string& previous) {
+                            text.reserve(previous.size());
+                            renderMetrics(text);
+                        },
+                        metricsIntervalMs}
+    , _topSnapshots{[this](std::string& json, const std::string& previous) {
+                        json.reserve(previous.size());
+                        renderTop(json);
+                    },
+                    snapshotIntervalMs}
+    , _series{}
+    , _hosts{}
+    , _bounds{}
+{
+    for(std::size_t i = 0; i < MetricsRegistry::BucketsAmount; ++i)
+    {
+        char bound[32];
+        std::snprintf(bound, sizeof(bound), "%g", MetricsRegistry::BucketBoundsNs[i] / 1e9);
+        _bounds[i] = bound;
+        if(_bounds[i].find('.') == std::string::npos)
         {
-            LOG("WARNING: Service shutdown detected - terminating task execution");
-            return;
+            _bounds[i] += ".0"; // canonical form of integral bounds in OpenMetrics
         }
-        if(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - servingStarted).count() >
-           static_cast<std::chrono::milliseconds::rep>(_service._maxServingDurationMs))
+    }
+}
+
+void JsonTcpService::start()
+{
+    _snapshots.start();
+    _metricsSnapshots.start();
+    _topSnapshots.start();
+    AbstractTcpService::start();
+}
+
+void JsonTcpService::stop()
+{
+    AbstractTcpService::stop();
+    _topSnapshots.stop();
+    _metricsSnapshots.stop();
+    _snapshots.stop();
+}
+
+std::size_t JsonTcpService::processRequest(const std::string& input, Output& output, bool& keepAlive)
+{
+    const std::size_t headerEnd = input.find("\r\n\r\n");
+    if(headerEnd == std::string::npos)
+    {
+        return 0;
+    }
+    const std::size_t requestSize = headerEnd + 4;
+
+    // Parsing request line: METHOD SP TARGET SP VERSION
+    const std::size_t lineEnd   = input.find("\r\n");
+    const std::string line      = input.substr(0, lineEnd);
+    const std::size_t methodEnd = line.find(' ');
+    const std::size_t targetEnd = line.rfind(' ');
+    const std::string method    = line.substr(0, methodEnd);
+    const std::string target    = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    const std::string version   = targetEnd == std::string::npos ? std::string{} : line.substr(targetEnd + 1);
+    const bool        isHttp11  = version == "HTTP/1.1";
+    if(methodEnd == std::string::npos || methodEnd == targetEnd || (!isHttp11 && version != "HTTP/1.0"))
+    {
+        keepAlive = false;
+        output.append(badRequest);
+        return requestSize;
+    }
+
+    // HTTP/1.1 connections are persistent by default, HTTP/1.0 ones are not
+    keepAlive = isHttp11;
+    for(std::size_t fieldBegin = lineEnd + 2; fieldBegin < headerEnd;)
+    {
+        std::size_t fieldEnd = input.find("\r\n", fieldBegin);
+        std::string field    = input.substr(fieldBegin, fieldEnd - fieldBegin);
+        for(auto& c : field)
         {
-            // TODO: Use general logging
-            LOG("WARNING: A client is too slow - terminating task execution");
-            return;
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
         }
-        struct timespec writeDuration;
-        AbstractTcpService::fillDuration(writeDuration);
-        fd_set writeDescriptorsSet;
-        FD_ZERO(&writeDescriptorsSet);
-        FD_SET(socket(), &writeDescriptorsSet);
-        int descriptorsCount = pselect(socket() + 1, NULL, &writeDescriptorsSet, NULL, &writeDuration, NULL);
-        if(descriptorsCount < 0)
+        if(field.compare(0, 11, "connection:") == 0)
         {
-            throw std::system_error{errno, std::system_category(), "Error awaiting for sending data availability on socket"};
+            if(field.find("close", 11) != std::string::npos)
+            {
+                keepAlive = false;
+            }
+            else if(field.find("keep-alive", 11) != std::string::npos)
+            {
+                keepAlive = true;
+            }
         }
-        else if(descriptorsCount == 0)
+        fieldBegin = fieldEnd + 2;
+    }
+    const char* connection = keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+
+    if(method != "GET" && method != "HEAD")
+    {
+        // Requests with body aren't supported, so connection can't be reused
+        keepAlive = false;
+        output.append(std::string{"HTTP/1.1 405 Method Not Allowed\r\nAllow: GET, HEAD\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"});
+        return requestSize;
+    }
+
+    // Snapshot is shared with other responses, only header is composed
+    const std::size_t queryBegin = target.find('?');
+    const bool        isMetrics  = target.compare(0, queryBegin, "/metrics") == 0;
+    Buffer            body;
+    if(isMetrics)
+    {
+        body = _metricsSnapshots.current();
+    }
+    else if(target.compare(0, queryBegin, "/top") == 0)
+    {
+        body = _topSnapshots.current();
+    }
+    else
+    {
+        const SnapshotPublisher<Document>::Snapshot document = _snapshots.current();
+        std::string                                 since;
+        body = document->full;
+        if(queryBegin != std::string::npos && findParameter(target.substr(queryBegin + 1), "since", since))
         {
-            // Timeout expired
-            continue;
+            char*          end        = nullptr;
+            const uint64_t generation = std::strtoull(since.c_str(), &end, 10);
+            if(since.empty() || !std::isdigit(since[0]) || *end != '\0')
+            {
+                keepAlive = false;
+                output.append(badRequest);
+                return requestSize;
+            }
+            // Full JSON is responded if the generation is unknown
+            if(generation <= document->generation && document->generation - generation < document->deltas.size())
+            {
+                body = document->deltas[document->generation - generation];
+            }
         }
-        ssize_t bytesSent = send(socket(), json.data() + totalBytesSent, json.length() - totalBytesSent, MSG_NOSIGNAL);
-        if(bytesSent < 0)
+    }
+    std::string header{"HTTP/1.1 200 OK\r\nContent-Type: "};
+    header += isMetrics ? "application/openmetrics-text; version=1.0.0; charset=utf-8" : "application/json";
+    header += "\r\nContent-Length: ";
+    header += std::to_string(body->size());
+    header += "\r\n";
+    header += connection;
+    header += "\r\n";
+    output.append(header);
+    if(method == "GET")
+    {
+        output.append(body);
+    }
+    return requestSize;
+}
+
+void JsonTcpService::renderJson(Document& next, const Document& previous) const
+{
+    std::shared_ptr<Counters> counters = std::make_shared<Counters>();
+    _analyzer.getCounters().snapshot(*counters);
+
+    next.generation = previous.generation + 1;
+    next.counters   = counters;
+    next.history    = previous.history;
+    if(previous.counters)
+    {
+        next.history.push_front(previous.counters);
+        if(next.history.size() > _historySize)
         {
-            std::system_error e{errno, std::system_category(), "Sending data to client error"};
-            LOG("WARNING: %s", e.what());
-            return;
+            next.history.pop_back();
         }
-        else if(bytesSent == 0)
+    }
+
+    std::shared_ptr<std::string> full = std::make_shared<std::string>();
+    full->reserve(previous.full ? previous.full->size() : 0);
+    renderDocument(*full, *counters, nullptr, next.generation, 0);
+    next.full = std::move(full);
+
+    // Deltas are rendered once per generation, so polling clients only share them
+    next.deltas.reserve(next.history.size() + 1);
+    for(std::size_t i = 0; i <= next.history.size(); ++i)
+    {
+        std::shared_ptr<std::string> delta = std::make_shared<std::string>();
+        renderDocument(*delta, *counters, i == 0 ? counters.get() : next.history[i - 1].get(), next.generation, next.generation - i);
+        next.deltas.push_back(std::move(delta));
+    }
+}
+
+void JsonTcpService::renderMetrics(std::string& text)
+{
+    _analyzer.getMetrics().collect(_series, _hosts);
+
+    text += "# TYPE nfstrace_requests counter\n"
+            "# HELP nfstrace_requests NFS calls matched with replies.\n";
+    for(const auto& series : _series)
+    {
+        appendLabels(text, "nfstrace_requests_total", series, _hosts[series.hosts]);
+        text += "} ";
+        appendInteger(text, series.requests);
+        text += '\n';
+    }
+    text += "# TYPE nfstrace_request_bytes counter\n"
+            "# UNIT nfstrace_request_bytes bytes\n"
+            "# HELP nfstrace_request_bytes Length of NFS calls.\n";
+    for(const auto& series : _series)
+    {
+        appendLabels(text, "nfstrace_request_bytes_total", series, _hosts[series.hosts]);
+        text += "} ";
+        appendInteger(text, series.requestBytes);
+        text += '\n';
+    }
+    text += "# TYPE nfstrace_response_bytes counter\n"
+            "# UNIT nfstrace_response_bytes bytes\n"
+            "# HELP nfstrace_response_bytes Length of NFS replies.\n";
+    for(const auto& series : _series)
+    {
+        appendLabels(text, "nfstrace_response_bytes_total", series, _hosts[series.hosts]);
+        text += "} ";
+        appendInteger(text, series.responseBytes);
+        text += '\n';
+    }
+    text += "# TYPE nfstrace_latency_seconds histogram\n"
+            "# UNIT nfstrace_latency_seconds seconds\n"
+            "# HELP nfstrace_latency_seconds Time between NFS call and its reply.\n";
+    for(const auto& series : _series)
+    {
+        uint64_t cumulative = 0;
+        for(std::size_t i = 0; i <= MetricsRegistry::BucketsAmount; ++i)
         {
-            LOG("WARNING: Connection has been aborted by client while sending data");
-            return;
+            cumulative += series.buckets[i];
+            appendLabels(text, "nfstrace_latency_seconds_bucket", series, _hosts[series.hosts]);
+            text += ",le=\"";
+            text += i < MetricsRegistry::BucketsAmount ? _bounds[i] : "+Inf";
+            text += "\"} ";
+            appendInteger(text, cumulative);
+            text += '\n';
         }
-        totalBytesSent += bytesSent;
+        appendLabels(text, "nfstrace_latency_seconds_count", series, _hosts[series.hosts]);
+        text += "} ";
+        appendInteger(text, series.requests);
+        text += '\n';
+        appendLabels(text, "nfstrace_latency_seconds_sum", series, _hosts[series.hosts]);
+        text += "} ";
+        appendSeconds(text, series.latencySumNs);
+        text += '\n';
+    }
+    text += "# TYPE nfstrace_operations counter\n"
+            "# HELP nfstrace_operations Operations of NFSv4.x COMPOUND procedures.\n";
+    Counters counters;
+    _analyzer.getCounters().snapshot(counters);
+    appendOperations(text, "nfs_v40", counters, nfsV40Fields);
+    appendOperations(text, "nfs_v41", counters, nfsV41Fields);
+    text += "# EOF\n";
+}
+
+void JsonTcpService::renderTop(std::string& json) const
+{
+    const HeavyHitters& hitters = _analyzer.getHeavyHitters();
+
+    std::vector<HeavyHitters::Clients::Entry> clients;
+    hitters.clients(_topSize, clients);
+    json += "{\"clients\":[";
+    for(std::size_t i = 0; i < clients.size(); ++i)
+    {
+        json += i == 0 ? "{\"address\":\"" : ",{\"address\":\"";
+        json += clients[i].key.to_string();
+        json += "\",\"operations\":";
+        appendInteger(json, std::llround(clients[i].count));
+        json += ",\"error\":";
+        appendInteger(json, std::llround(clients[i].error));
+        json += '}';
+    }
+
+    std::vector<HeavyHitters::Files::Entry> files;
+    hitters.files(_topSize, files);
+    json += "],\"files\":[";
+    for(std::size_t i = 0; i < files.size(); ++i)
+    {
+        json += i == 0 ? "{\"fh\":\"" : ",{\"fh\":\"";
+        json += file_handle_hash(files[i].key);
+        json += "\",\"operations\":";
+        appendInteger(json, std::llround(files[i].count));
+        json += ",\"error\":";
+        appendInteger(json, std::llround(files[i].error));
+        json += '}';
     }
-    LOG("INFO: Serving of client has been completed");
+    json += "]}";
 }
 
 //------------------------------------------------------------------------------
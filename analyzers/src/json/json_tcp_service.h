@@ -22,32 +22,78 @@
 #ifndef JSON_TCP_SERVICE_H
 #define JSON_TCP_SERVICE_H
 //------------------------------------------------------------------------------
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
 #include "abstract_tcp_service.h"
+#include "metrics_registry.h"
+#include "snapshot_publisher.h"
 //------------------------------------------------------------------------------
+//! JSON-service over HTTP/1.1
+/*!
+ * Responds to GET requests with JSON of statistics, connections are persistent
+ * unless client asks to close them. JSON is rendered once per snapshot interval
+ * and shared by responses. Each rendering gets next generation number, client
+ * which passes since=GENERATION gets only counters changed after it, if the
+ * generation is still kept in history. Requests of /metrics are responded in
+ * the same way with metrics of latencies and traffic in OpenMetrics text format,
+ * requests of /top with JSON of clients and files which send the most operations.
+ * Metrics are rendered at own interval, it is longer since their size grows
+ * with amount of pairs of hosts.
+ */
 class JsonTcpService : public AbstractTcpService
 {
 public:
+    static constexpr std::size_t DefaultSnapshotIntervalMs = 100U;
+    static constexpr std::size_t DefaultHistorySize        = 32U;
+    static constexpr std::size_t DefaultTopSize            = 10U;
+    static constexpr std::size_t DefaultMetricsIntervalMs  = 1000U;
+
     JsonTcpService() = delete;
     JsonTcpService(class JsonAnalyzer& analyzer, std::size_t workersAmount, int port, const std::string& host,
-                   std::size_t maxServingDurationMs, int backlog);
+                   std::size_t maxServingDurationMs, int backlog, std::size_t keepAliveTimeoutMs = DefaultKeepAliveTimeoutMs,
+                   std::size_t maxConnections = DefaultMaxConnections, std::size_t snapshotIntervalMs = DefaultSnapshotIntervalMs,
+                   std::size_t historySize = DefaultHistorySize, std::size_t topSize = DefaultTopSize,
+                   std::size_t metricsIntervalMs = DefaultMetricsIntervalMs);
+
+    void start() override;
+    void stop() override;
 
 private:
-    class Task : public AbstractTask
+    using Counters = std::vector<uint64_t>; //!< Values of all counters of JsonAnalyzer::getCounters()
+
+    //! Published generation of JSON and its deltas from previous generations
+    struct Document
     {
-    public:
-        Task(JsonTcpService& service, int socket);
-        Task() = delete;
+        uint64_t                                    generation{0};
+        std::shared_ptr<const Counters>             counters;
+        std::deque<std::shared_ptr<const Counters>> history; //!< Counters of previous generations, the latest first
+        Buffer                                      full;
+        std::vector<Buffer>                         deltas; //!< Deltas since generation - i, deltas[0] has no counters
+    };
 
-        void execute() override final;
+    std::size_t processRequest(const std::string& input, Output& output, bool& keepAlive) override final;
 
-    private:
-        JsonTcpService& _service;
-    };
+    //! Renders next generation of JSON with current statistics
+    void renderJson(Document& next, const Document& previous) const;
+    //! Renders current metrics in OpenMetrics text format
+    void renderMetrics(std::string& text);
+    //! Renders JSON of current top clients and files
+    void renderTop(std::string& json) const;
 
-    AbstractTask* createTask(int socket) override final;
+    JsonAnalyzer&                  _analyzer;
+    const std::size_t              _historySize;
+    const std::size_t              _topSize;
+    SnapshotPublisher<Document>    _snapshots;
+    SnapshotPublisher<std::string> _metricsSnapshots;
+    SnapshotPublisher<std::string> _topSnapshots;
 
-    JsonAnalyzer& _analyzer;
-    std::size_t   _maxServingDurationMs;
+    // Used by renderer of metrics only
+    std::vector<MetricsRegistry::Series>                    _series;
+    std::vector<std::string>                                _hosts;
+    std::array<std::string, MetricsRegistry::BucketsAmount> _bounds; //!< Upper bounds of buckets in seconds
 };
 //------------------------------------------------------------------------------
 #endif //JSON_TCP_SERVICE_H
@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Registry of latency and traffic metrics of NFS procedures definition
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cstring>
+
+#include <arpa/inet.h>
+
+#include "api/nfs_types.h"
+#include "metrics_registry.h"
+//------------------------------------------------------------------------------
+using namespace NST::API;
+//------------------------------------------------------------------------------
+
+// Buckets from 100 us to 10 s with steps 1, 2.5, 5 per decade
+const int64_t MetricsRegistry::BucketBoundsNs[BucketsAmount] = {
+    100000, 250000, 500000,
+    1000000, 2500000, 5000000,
+    10000000, 25000000, 50000000,
+    100000000, 250000000, 500000000,
+    1000000000, 2500000000, 5000000000,
+    10000000000};
+
+MetricsRegistry::MetricsRegistry(std::size_t maxHosts)
+    : _mutex{}
+    , _increments{}
+    , _created{}
+    , _seriesAmount{0}
+    , _seriesIndexes{}
+    , _hosts{}
+    , _hostsIndexes{}
+    , _maxHosts{maxHosts}
+    , _otherHosts{UINT32_MAX}
+    , _collectMutex{}
+    , _collected{}
+    , _totals{}
+    , _totalsHosts{}
+{
+}
+
+void MetricsRegistry::account(const HeaderEvent* events, std::size_t count)
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    for(const HeaderEvent* e = events; e != events + count; ++e)
+    {
+        if(e->procedure >= proceduresAmount(e->protocol))
+        {
+            continue;
+        }
+        const uint32_t index = resolveSeries(resolveHosts(*e->session), e->protocol, e->procedure);
+        if(index >= _increments.size())
+        {
+            _increments.resize(index + 1, Series{});
+        }
+        Series& series = _increments[index];
+        ++series.requests;
+        series.requestBytes += e->call_size;
+        series.responseBytes += e->reply_size;
+
+        const int64_t latency = e->reply_time - e->call_time;
+        std::size_t   bucket  = 0;
+        while(bucket < BucketsAmount && latency > BucketBoundsNs[bucket])
+        {
+            ++bucket;
+        }
+        ++series.buckets[bucket];
+        series.latencySumNs += latency > 0 ? latency : 0;
+    }
+}
+
+void MetricsRegistry::collect(std::vector<Series>& series, std::vector<std::string>& hosts) const
+{
+    std::lock_guard<std::mutex> collecting{_collectMutex};
+    {
+        // Only new series and labels are copied under lock of parser threads
+        std::lock_guard<std::mutex> lock{_mutex};
+        _collected.swap(_increments);
+        _totals.insert(_totals.end(), _created.begin(), _created.end());
+        _created.clear();
+        _totalsHosts.insert(_totalsHosts.end(), _hosts.begin() + _totalsHosts.size(), _hosts.end());
+    }
+
+    for(std::size_t i = 0; i < _collected.size(); ++i)
+    {
+        const Series& increment = _collected[i];
+        Series&       total     = _totals[i];
+        total.requests += increment.requests;
+        total.requestBytes += increment.requestBytes;
+        total.responseBytes += increment.responseBytes;
+        total.latencySumNs += increment.latencySumNs;
+        for(std::size_t bucket = 0; bucket <= BucketsAmount; ++bucket)
+        {
+            total.buckets[bucket] += increment.buckets[bucket];
+        }
+    }
+    _collected.clear();
+
+    series = _totals;
+    hosts.insert(hosts.end(), _totalsHosts.begin() + hosts.size(), _totalsHosts.end());
+}
+
+uint32_t MetricsRegistry::proceduresAmount(Protocol protocol)
+{
+    switch(protocol)
+    {
+    case Protocol::NFSv3:
+        return ProcEnumNFS3::count;
+    case Protocol::NFSv40:
+        return ProcEnumNFS4::count_proc;
+    case Protocol::NFSv41:
+        return ProcEnumNFS41::count_proc;
+    default:
+        return 0;
+    }
+}
+
+bool MetricsRegistry::HostsKey::operator==(const HostsKey& other) const
+{
+    return v6 == other.v6 && std::memcmp(addresses, other.addresses, sizeof(addresses)) == 0;
+}
+
+std::size_t MetricsRegistry::HostsKeyHash::operator()(const HostsKey& key) const
+{
+    // FNV-1a of used bytes of addresses
+    const std::size_t length = key.v6 ? sizeof(key.addresses) : 8;
+    uint64_t          hash   = 14695981039346656037ULL;
+    for(std::size_t i = 0; i < length; ++i)
+    {
+        hash = (hash ^ key.addresses[i]) * 1099511628211ULL;
+    }
+    return hash ^ key.v6;
+}
+
+uint32_t MetricsRegistry::resolveHosts(const Session& session)
+{
+    // Cache is keyed by pair of hosts, so it doesn't grow with reconnections
+    HostsKey key{{}, session.ip_type == Session::IPType::v6};
+    if(key.v6)
+    {
+        std::memcpy(key.addresses, session.ip.v6.addr[Session::Source], 16);
+        std::memcpy(key.addresses + 16, session.ip.v6.addr[Session::Destination], 16);
+    }
+    else
+    {
+        std::memcpy(key.addresses, &session.ip.v4.addr[Session::Source], 4);
+        std::memcpy(key.addresses + 4, &session.ip.v4.addr[Session::Destination], 4);
+    }
+    auto i = _hostsIndexes.find(key);
+    if(i != _hostsIndexes.end())
+    {
+        return i->second;
+    }
+    if(_hostsIndexes.size() >= _maxHosts)
+    {
+        // Pairs of hosts over the limit aren't cached, so memory doesn't grow with them
+        if(_otherHosts == UINT32_MAX)
+        {
+            _hosts.push_back("client=\"other\",server=\"other\"");
+            _otherHosts = _hosts.size() - 1;
+        }
+        return _otherHosts;
+    }
+
+    // Labels are composed once per pair of hosts
+    const int   family = key.v6 ? AF_INET6 : AF_INET;
+    const void* client = key.addresses;
+    const void* server = key.v6 ? key.addresses + 16 : key.addresses + 4;
+    char        buffer[INET6_ADDRSTRLEN];
+    std::string labels{"client=\""};
+    labels += inet_ntop(family, client, buffer, sizeof(buffer));
+    labels += "\",server=\"";
+    labels += inet_ntop(family, server, buffer, sizeof(buffer));
+    labels += '"';
+
+    _hosts.push_back(std::move(labels));
+    _hostsIndexes.emplace(key, _hosts.size() - 1);
+    return _hosts.size() - 1;
+}
+
+uint32_t MetricsRegistry::resolveSeries(uint32_t hosts, Protocol protocol, uint32_t procedure)
+{
+    const uint64_t key = uint64_t{hosts} << 32 | uint64_t{static_cast<uint8_t>(protocol)} << 16 | procedure;
+    auto           i   = _seriesIndexes.find(key);
+    if(i != _seriesIndexes.end())
+    {
+        return i->second;
+    }
+    _created.push_back(Series{protocol, procedure, hosts, 0, 0, 0, 0, {}});
+    _seriesIndexes.emplace(key, _seriesAmount);
+    return _seriesAmount++;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Registry of latency and traffic metrics of NFS procedures declaration
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+//------------------------------------------------------------------------------
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "api/header_event.h"
+//------------------------------------------------------------------------------
+//! Registry of metrics of NFS procedures
+/*!
+ * Metrics are accumulated from batches of header-only events per procedure
+ * and pair of client and server hosts. A batch is accounted under single lock,
+ * so the registry can be fed by several parser threads concurrently.
+ * Counters are double-buffered: parser threads accumulate increments, and
+ * collect() only swaps them under that lock, totals are summed and copied
+ * outside of it.
+ * Amount of labeled pairs of hosts is limited, so are amount of series and
+ * size of metrics: further pairs share client="other",server="other" labels.
+ */
+class MetricsRegistry
+{
+public:
+    //! Amount of finite buckets of latency histogram
+    static constexpr std::size_t BucketsAmount = 16;
+    //! Default limit of labeled pairs of hosts
+    static constexpr std::size_t DefaultMaxHosts = 1000;
+    //! Upper bounds of finite buckets in nanoseconds
+    static const int64_t BucketBoundsNs[BucketsAmount];
+
+    //! Metrics of procedure of protocol between pair of hosts
+    struct Series
+    {
+        NST::API::Protocol protocol;
+        uint32_t           procedure;
+        uint32_t           hosts;         //!< Index of labels of pair of hosts
+        uint64_t           requests;      //!< Amount of calls matched with replies
+        uint64_t           requestBytes;  //!< Length of calls
+        uint64_t           responseBytes; //!< Length of replies
+        uint64_t           latencySumNs;  //!< Sum of latencies
+        uint64_t           buckets[BucketsAmount + 1]; //!< Non-cumulative counts of latencies, the last one is +Inf
+    };
+
+    //! Constructs registry
+    /*!
+     * \param maxHosts Max amount of labeled pairs of hosts, traffic of other pairs is accounted together
+     */
+    explicit MetricsRegistry(std::size_t maxHosts = DefaultMaxHosts);
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    //! Accounts batch of events, events of non-NFS protocols are skipped
+    void account(const NST::API::HeaderEvent* events, std::size_t count);
+
+    //! Copies current metrics
+    /*!
+     * \param series Replaced by current metrics
+     * \param hosts Labels of pairs of hosts, new ones are appended to already copied ones
+     */
+    void collect(std::vector<Series>& series, std::vector<std::string>& hosts) const;
+
+    //! Returns amount of procedures of protocol, or 0 if it isn't NFS
+    static uint32_t proceduresAmount(NST::API::Protocol protocol);
+
+private:
+    //! Addresses of client and server, IPv4 ones occupy first 8 bytes
+    struct HostsKey
+    {
+        uint8_t addresses[32];
+        bool    v6;
+
+        bool operator==(const HostsKey& other) const;
+    };
+
+    struct HostsKeyHash
+    {
+        std::size_t operator()(const HostsKey& key) const;
+    };
+
+    uint32_t resolveHosts(const NST::API::Session& session);
+    uint32_t resolveSeries(uint32_t hosts, NST::API::Protocol protocol, uint32_t procedure);
+
+    mutable std::mutex                                   _mutex;
+    mutable std::vector<Series>                          _increments;    //!< Counters accounted since last collect() by index of series
+    mutable std::vector<Series>                          _created;       //!< Series created since last collect()
+    uint32_t                                             _seriesAmount;  //!< Amount of all created series
+    std::unordered_map<uint64_t, uint32_t>               _seriesIndexes; //!< Key is composed of hosts, protocol and procedure
+    std::vector<std::string>                             _hosts;         //!< Labels of pairs of hosts
+    std::unordered_map<HostsKey, uint32_t, HostsKeyHash> _hostsIndexes;
+    const std::size_t                                    _maxHosts;
+    uint32_t                                             _otherHosts; //!< Index of labels of other pairs of hosts, if there are some
+
+    // Guarded by _collectMutex and accessed without _mutex except swap
+    mutable std::mutex               _collectMutex;
+    mutable std::vector<Series>      _collected; //!< Swapped out increments, kept to reuse their storage
+    mutable std::vector<Series>      _totals;
+    mutable std::vector<std::string> _totalsHosts;
+};
+//------------------------------------------------------------------------------
+#endif //METRICS_REGISTRY_H
+//------------------------------------------------------------------------------
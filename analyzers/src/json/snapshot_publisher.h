@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Publisher of periodically rendered snapshots
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef SNAPSHOT_PUBLISHER_H
+#define SNAPSHOT_PUBLISHER_H
+//------------------------------------------------------------------------------
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+//------------------------------------------------------------------------------
+//! Publisher of snapshots
+/*!
+ * Snapshot is rendered by own thread of publisher once per interval into a
+ * new document, which atomically replaces the current one. Readers share the
+ * current document without copying and locks, the previous one is freed when
+ * its last reader releases it.
+ */
+template <typename Document>
+class SnapshotPublisher
+{
+public:
+    using Snapshot = std::shared_ptr<const Document>;
+    //! Renders the next document, the previous one is passed for reuse of its content
+    using Renderer = std::function<void(Document& next, const Document& previous)>;
+
+    SnapshotPublisher() = delete;
+    //! Constructs publisher
+    /*!
+     * \param renderer Function which renders snapshot
+     * \param intervalMs Interval of rendering in milliseconds
+     */
+    SnapshotPublisher(Renderer renderer, std::size_t intervalMs)
+        : _renderer{std::move(renderer)}
+        , _interval{intervalMs}
+        , _current{std::make_shared<const Document>()}
+        , _isRunning{false}
+        , _mutex{}
+        , _cond{}
+        , _thread{}
+    {
+    }
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+    ~SnapshotPublisher()
+    {
+        stop();
+    }
+
+    //! Renders the first snapshot and starts publishing
+    void start()
+    {
+        publish();
+        _isRunning = true;
+        _thread    = std::thread{&SnapshotPublisher::run, this};
+    }
+
+    //! Stops publishing, the current snapshot is available still
+    void stop()
+    {
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _isRunning = false;
+            _cond.notify_all();
+        }
+        if(_thread.joinable())
+        {
+            _thread.join();
+        }
+    }
+
+    //! Returns the current snapshot
+    inline Snapshot current() const
+    {
+        return std::atomic_load(&_current);
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        while(!_cond.wait_for(lock, _interval, [this] { return !_isRunning; }))
+        {
+            publish();
+        }
+    }
+
+    void publish()
+    {
+        // Only this thread replaces the current snapshot, so it is read without atomic_load
+        std::shared_ptr<Document> snapshot = std::make_shared<Document>();
+        _renderer(*snapshot, *_current);
+        std::atomic_store(&_current, Snapshot{std::move(snapshot)});
+    }
+
+    Renderer                        _renderer;
+    const std::chrono::milliseconds _interval;
+    Snapshot                        _current;
+    bool                            _isRunning;
+    std::mutex                      _mutex;
+    std::condition_variable         _cond;
+    std::thread                     _thread;
+};
+//------------------------------------------------------------------------------
+#endif //SNAPSHOT_PUBLISHER_H
+//------------------------------------------------------------------------------
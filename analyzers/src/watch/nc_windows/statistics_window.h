@@ -22,6 +22,7 @@
 #ifndef STATISTICS_WINDOW_H
 #define STATISTICS_WINDOW_H
 //------------------------------------------------------------------------------
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 
@@ -30,7 +31,7 @@
 //------------------------------------------------------------------------------
 class StatisticsWindow
 {
-    using ProtocolStatistic    = std::vector<std::size_t>;
+    using ProtocolStatistic    = std::vector<uint64_t>;
     using StatisticsContainers = std::unordered_map<AbstractProtocol*, ProtocolStatistic>;
 
 public:
@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Source for screens of top clients and files.
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include "top_protocol.h"
+//------------------------------------------------------------------------------
+namespace
+{
+const std::size_t ROW_NAME_SIZE = 20; // counters are drawn after names
+}
+
+TopProtocol::TopProtocol(const char* name, std::size_t rows)
+    : AbstractProtocol{name, rows}
+    , _rows(rows)
+{
+}
+
+TopProtocol::~TopProtocol()
+{
+}
+
+const char* TopProtocol::printProcedure(std::size_t i)
+{
+    if(i >= _rows.size())
+    {
+        return nullptr;
+    }
+    return _rows[i].c_str();
+}
+
+void TopProtocol::setRow(std::size_t i, const std::string& name)
+{
+    if(i >= _rows.size())
+    {
+        return;
+    }
+    if(name.size() > ROW_NAME_SIZE)
+    {
+        _rows[i] = "~" + name.substr(name.size() - ROW_NAME_SIZE + 1);
+    }
+    else
+    {
+        _rows[i] = name;
+    }
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Header for screens of top clients and files.
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef TOP_PROTOCOL_H
+#define TOP_PROTOCOL_H
+//------------------------------------------------------------------------------
+#include <string>
+#include <vector>
+
+#include "abstract_protocol.h"
+//------------------------------------------------------------------------------
+/*! Screen of top keys (clients, files), its rows are renamed on every update.
+ * Counters of the rows are decayed amounts of operations of the keys.
+ */
+class TopProtocol : public AbstractProtocol
+{
+public:
+    TopProtocol(const char* name, std::size_t rows);
+    ~TopProtocol();
+    virtual const char* printProcedure(std::size_t);
+
+    /*! Set name of row, long names are cut from the left
+    */
+    void setRow(std::size_t, const std::string&);
+
+private:
+    std::vector<std::string> _rows;
+};
+//------------------------------------------------------------------------------
+#endif //TOP_PROTOCOL_H
+//------------------------------------------------------------------------------
@@ -23,6 +23,7 @@
 #include <exception>
 #include <iostream>
 #include <system_error>
+#include <utility>
 
 #include <unistd.h>
 
@@ -59,7 +60,7 @@ void UserGUI::run()
 
         uint16_t key = 0;
 
-        std::vector<std::size_t> tmp;
+        ProtocolStatistic tmp;
 
         statisticsWindow.updateProtocol(_activeProtocol);
 
@@ -76,8 +77,8 @@ void UserGUI::run()
             }
             if(_running.test_and_set())
             {
-                std::unique_lock<std::mutex> lck(_statisticsDeltaMutex);
-                tmp = _statisticsContainers.at(_activeProtocol);
+                _source(_activeProtocol, tmp);
+                statisticsWindow.updateProtocol(_activeProtocol); // names of top keys are changed by source
             }
             headerWindow.update();
             statisticsWindow.update(tmp);
@@ -111,18 +112,15 @@ void UserGUI::run()
                             else
                                 --it;
                         }
-                        auto a = find_if(_statisticsContainers.begin(), _statisticsContainers.end(), [&](std::pair<AbstractProtocol*, std::vector<std::size_t>> p) {
+                        auto a = find_if(_statisticsContainers.begin(), _statisticsContainers.end(), [&](const StatisticsContainers::value_type& p) {
                             return !(p.first->getProtocolName().compare(*it));
                         });
                         if(a != _statisticsContainers.end())
                         {
                             _activeProtocol = a->first;
+                            _source(_activeProtocol, tmp);
                             statisticsWindow.setProtocol(_activeProtocol);
                             statisticsWindow.resize(mainWindow);
-                            {
-                                std::unique_lock<std::mutex> lck(_statisticsDeltaMutex);
-                                tmp = a->second;
-                            }
                             statisticsWindow.update(tmp);
                         }
                     }
@@ -155,31 +153,21 @@ timeval UserGUI::getTimeval() const
     return tv;
 }
 
-UserGUI::UserGUI(const char* opts, std::vector<AbstractProtocol*>& data)
-    : _refresh_delta{900000}
+UserGUI::UserGUI(unsigned long refresh, std::vector<AbstractProtocol*>& data, StatisticsSource source)
+    : _refresh_delta{refresh}
     , _shouldResize{false}
     , _running{ATOMIC_FLAG_INIT}
     , _activeProtocol(nullptr)
+    , _source{std::move(source)}
 {
-    try
+    for(auto it = data.begin(); it != data.end(); ++it)
     {
-        if(opts != nullptr && *opts != '\0')
-        {
-            _refresh_delta = std::stoul(opts);
-        }
-        for(auto it = data.begin(); it != data.end(); ++it)
-        {
-            _allProtocols.push_back((*it)->getProtocolName());
-            _statisticsContainers.insert(std::make_pair<AbstractProtocol*, std::vector<std::size_t>>((AbstractProtocol * &&)(*it), std::vector<std::size_t>((*it)->getAmount(), 0)));
-        }
-        if(_activeProtocol == nullptr && !data.empty())
-        {
-            _activeProtocol = data.back();
-        }
+        _allProtocols.push_back((*it)->getProtocolName());
+        _statisticsContainers.insert(std::make_pair<AbstractProtocol*, ProtocolStatistic>((AbstractProtocol * &&)(*it), ProtocolStatistic((*it)->getAmount(), 0)));
     }
-    catch(std::exception& e)
+    if(_activeProtocol == nullptr && !data.empty())
     {
-        throw std::runtime_error{std::string{"Error in plugin options processing. OPTS: "} + opts + std::string(" Error: ") + e.what()};
+        _activeProtocol = data.back();
     }
     _running.test_and_set();
     _guiThread = std::thread(&UserGUI::run, this);
@@ -191,17 +179,6 @@ UserGUI::~UserGUI()
     _guiThread.join();
 }
 
-void UserGUI::update(AbstractProtocol* p, std::vector<std::size_t>& d)
-{
-    std::vector<std::size_t>::iterator it;
-    std::vector<std::size_t>::iterator st;
-    std::unique_lock<std::mutex>       lck(_statisticsDeltaMutex);
-    for(it = (_statisticsContainers.at(p)).begin(), st = d.begin(); it != (_statisticsContainers.at(p)).end() && st != d.end(); ++it, ++st)
-    {
-        (*it) += (*st);
-    }
-}
-
 void UserGUI::enableUpdate()
 {
     _shouldResize = true;
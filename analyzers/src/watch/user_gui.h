@@ -23,9 +23,11 @@
 #define USERGUI_H
 //------------------------------------------------------------------------------
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
-#include <mutex>
+#include <functional>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <ncurses.h>
@@ -35,17 +37,19 @@
 class UserGUI
 {
 public:
-    using ProtocolStatistic    = std::vector<std::size_t>;
+    using ProtocolStatistic    = std::vector<uint64_t>;
     using StatisticsContainers = std::unordered_map<AbstractProtocol*, ProtocolStatistic>;
+    using StatisticsSource     = std::function<void(AbstractProtocol*, ProtocolStatistic&)>;
 
     UserGUI() = delete;
-    UserGUI(const char*, std::vector<AbstractProtocol*>&);
+    /*! Starts thread of GUI.
+     * \param refresh - timeout of screen update
+     * \param protocols - protocols shown by GUI
+     * \param source - copies current counters of protocol, it is called by thread of GUI
+     */
+    UserGUI(unsigned long refresh, std::vector<AbstractProtocol*>& protocols, StatisticsSource source);
     ~UserGUI();
 
-    /*! Update Protocol's data.
-    */
-    void update(AbstractProtocol*, std::vector<std::size_t>&);
-
     /*! Enable screen full update. Use for resize main window.
     */
     void enableUpdate();
@@ -56,10 +60,10 @@ private:
 
     unsigned long            _refresh_delta; // in microseconds
     std::atomic<bool>        _shouldResize;
-    std::mutex               _statisticsDeltaMutex;
     std::atomic_flag         _running;
     StatisticsContainers     _statisticsContainers;
     AbstractProtocol*        _activeProtocol;
+    StatisticsSource         _source;
     std::thread              _guiThread;
     std::vector<std::string> _allProtocols;
 };
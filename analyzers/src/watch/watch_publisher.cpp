@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Source for WatchPublisher
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "watch_publisher.h"
+//------------------------------------------------------------------------------
+using namespace NST::API;
+//------------------------------------------------------------------------------
+WatchPublisher::WatchPublisher(const std::string& path, uint32_t intervalMs, const std::vector<AbstractProtocol*>& protocols, StatisticsSource source)
+    : _path{path}
+    , _intervalMs{intervalMs}
+    , _protocols{protocols}
+    , _source{std::move(source)}
+    , _size{0}
+    , _header{nullptr}
+    , _counters{nullptr}
+    , _stopping{false}
+{
+    uint32_t amount{0};
+    for(AbstractProtocol* p : _protocols)
+    {
+        if(p->getGroups() > WATCH_SEGMENT_GROUPS)
+        {
+            throw std::runtime_error{"Too many groups of counters of " + p->getProtocolName()};
+        }
+        amount += p->getAmount();
+    }
+    const uint16_t protocolsAmount = static_cast<uint16_t>(_protocols.size());
+    _size = watch_segment_size(protocolsAmount, amount);
+
+    // viewers of previous segment keep their mapping, new viewers open the new file
+    unlink(_path.c_str());
+    const int fd{open(_path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644)};
+    if(fd < 0)
+    {
+        throw std::system_error{errno, std::system_category(), {"Error in creating watch segment: " + _path}};
+    }
+    void* map{MAP_FAILED};
+    if(ftruncate(fd, _size) == 0)
+    {
+        map = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    const int err{errno};
+    close(fd);
+    if(map == MAP_FAILED)
+    {
+        unlink(_path.c_str());
+        throw std::system_error{err, std::system_category(), {"Error in mapping watch segment: " + _path}};
+    }
+
+    // the file is zeroed by ftruncate(), names and descriptors are written once
+    char* base = static_cast<char*>(map);
+    _header    = static_cast<WatchSegmentHeader*>(map);
+    _counters  = reinterpret_cast<std::atomic<uint64_t>*>(base + watch_segment_counters(protocolsAmount, amount));
+
+    WatchSegmentProtocol* descriptor = reinterpret_cast<WatchSegmentProtocol*>(_header + 1);
+    char*                 name       = base + watch_segment_names(protocolsAmount);
+    uint32_t              first{0};
+    for(AbstractProtocol* p : _protocols)
+    {
+        std::snprintf(descriptor->name, WATCH_SEGMENT_NAME_SIZE, "%s", p->getProtocolName().c_str());
+        descriptor->first  = first;
+        descriptor->amount = p->getAmount();
+        descriptor->groups = static_cast<uint32_t>(p->getGroups());
+        for(uint32_t g = 0; g < descriptor->groups; ++g)
+        {
+            descriptor->group_begins[g] = static_cast<uint32_t>(p->getGroupBegin(g + 1));
+        }
+        for(uint32_t i = 0; i < descriptor->amount; ++i, name += WATCH_SEGMENT_NAME_SIZE)
+        {
+            const char* procedure = p->printProcedure(i);
+            std::snprintf(name, WATCH_SEGMENT_NAME_SIZE, "%s", procedure ? procedure : "");
+        }
+        first += descriptor->amount;
+        ++descriptor;
+    }
+    _header->version    = WATCH_SEGMENT_VERSION;
+    _header->protocols  = protocolsAmount;
+    _header->counters   = amount;
+    _header->refresh_ms = _intervalMs;
+    _header->running.store(1, std::memory_order_relaxed);
+    _header->magic.store(WATCH_SEGMENT_MAGIC, std::memory_order_release);
+
+    _values.reserve(amount);
+    _thread = std::thread(&WatchPublisher::run, this);
+}
+
+WatchPublisher::~WatchPublisher()
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+    }
+    _stopped.notify_one();
+    _thread.join();
+
+    publish(); // the last values are left for viewers
+    _header->running.store(0, std::memory_order_release);
+    munmap(_header, _size);
+    unlink(_path.c_str());
+}
+
+void WatchPublisher::run()
+{
+    std::unique_lock<std::mutex> lock{_mutex};
+    while(!_stopped.wait_for(lock, std::chrono::milliseconds{_intervalMs}, [this] { return _stopping; }))
+    {
+        lock.unlock();
+        publish();
+        lock.lock();
+    }
+}
+
+void WatchPublisher::publish()
+{
+    // counters are copied before the sequence is opened, so viewers wait for stores only
+    _values.clear();
+    for(AbstractProtocol* p : _protocols)
+    {
+        _source(p, _protocolValues);
+        _protocolValues.resize(p->getAmount());
+        _values.insert(_values.end(), _protocolValues.begin(), _protocolValues.end());
+    }
+    const uint64_t published = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    const uint64_t sequence{_header->sequence.load(std::memory_order_relaxed)};
+    _header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(std::size_t i = 0; i < _values.size(); ++i)
+    {
+        _counters[i].store(_values[i], std::memory_order_relaxed);
+    }
+    _header->published.store(published, std::memory_order_relaxed);
+    _header->sequence.store(sequence + 2, std::memory_order_release);
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Header for WatchPublisher
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef WATCH_PUBLISHER_H
+#define WATCH_PUBLISHER_H
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <api/watch_segment.h>
+
+#include "protocols/abstract_protocol.h"
+//------------------------------------------------------------------------------
+/*! Publisher of counters of protocols into shared memory segment.
+ * Counters are copied by own thread at fixed interval, so viewers attached
+ * to the segment (nfstrace-watch) never touch threads of analyzer.
+ */
+class WatchPublisher
+{
+public:
+    using StatisticsSource = std::function<void(AbstractProtocol*, std::vector<uint64_t>&)>;
+
+    /*! Creates the segment and starts thread of publishing.
+     * \param path - file of the segment, usually in /dev/shm
+     * \param intervalMs - interval of publishing
+     * \param protocols - protocols, their names and names of their counters are written once
+     * \param source - copies current counters of protocol, it is called by thread of publisher
+     */
+    WatchPublisher(const std::string& path, uint32_t intervalMs, const std::vector<AbstractProtocol*>& protocols, StatisticsSource source);
+    ~WatchPublisher();
+    WatchPublisher(const WatchPublisher&) = delete;
+    WatchPublisher& operator=(const WatchPublisher&) = delete;
+
+private:
+    void run();
+    void publish();
+
+    const std::string                    _path;
+    const uint32_t                       _intervalMs;
+    const std::vector<AbstractProtocol*> _protocols;
+    StatisticsSource                     _source;
+    std::size_t                          _size;
+    NST::API::WatchSegmentHeader*        _header;
+    std::atomic<uint64_t>*               _counters;
+    std::vector<uint64_t>                _values; // all counters, in order of the segment
+    std::vector<uint64_t>                _protocolValues;
+    std::mutex                           _mutex;
+    std::condition_variable              _stopped;
+    bool                                 _stopping;
+    std::thread                          _thread;
+};
+//------------------------------------------------------------------------------
+#endif //WATCH_PUBLISHER_H
+//------------------------------------------------------------------------------
@@ -20,18 +20,7 @@ if (${CMAKE_SYSTEM_NAME} MATCHES "Linux" AND EXISTS "/etc/os-release")
         message (FATAL_ERROR "Linux distro identification error")
     endif ()
 endif ()
-# libjson package has different names on different RPM-based distros
-if (${LINUX_DISTRO} MATCHES "openSUSE")
-    set (CPACK_RPM_PACKAGE_REQUIRES "libjson-c2 >= 0.11")
-elseif (${LINUX_DISTRO} MATCHES "ALT Linux")
-    set (CPACK_RPM_PACKAGE_REQUIRES "libjson-c >= 0.11")
-else ()
-    # CentOS/Fedora/etc.
-    set (CPACK_RPM_PACKAGE_REQUIRES "json-c >= 0.11")
-endif ()
-
 set (CPACK_DEBIAN_PACKAGE_SECTION "admin")
 set (CPACK_DEBIAN_PACKAGE_DEPENDS "libpcap0.8 (>=1.3.0-1)")
-set (CPACK_DEBIAN_PACKAGE_DEPENDS "libjson-c2 (>=0.11)")
 
 include (CPack)
@@ -25,28 +25,46 @@ namespace NST
 {
 namespace analysis
 {
-AnalysisManager::AnalysisManager(RunningStatus& status, const Parameters& params)
-    : analysiss{nullptr}
-    , queue{nullptr}
-    , parser_thread{nullptr}
+AnalysisManager::AnalysisManager(RunningStatus& s, const Parameters& params)
+    : status(s)
 {
-    analysiss.reset(new Analyzers(params));
+    const unsigned short threads{params.parser_threads()};
 
-    queue.reset(new FilteredDataQueue(params.queue_capacity(), 1));
+    analysiss.emplace_back(new Analyzers(params));
+    for(unsigned short i = 1; i < threads; ++i)
+    {
+        analysiss.emplace_back(new Analyzers(*analysiss.front()));
+    }
 
-    Parsers parser(*analysiss);
-    parser_thread.reset(new ParserThread<Parsers>(parser, *queue, status));
+    for(const auto& a : analysiss)
+    {
+        queues.emplace_back(new FilteredDataQueue(params.queue_capacity(), 1));
+
+        Parsers parser(*a);
+        parser_threads.emplace_back(new ParserThread<Parsers>(parser, *queues.back(), status));
+    }
 }
 
 void AnalysisManager::start()
 {
-    parser_thread->start();
+    analysiss.front()->start_async(status);
+    for(const auto& p : parser_threads)
+    {
+        p->start();
+    }
 }
 
 void AnalysisManager::stop()
 {
-    parser_thread->stop();
-    analysiss->flush_statistics();
+    for(const auto& p : parser_threads)
+    {
+        p->stop();
+    }
+    analysiss.front()->stop_async(); // after parser threads, so all events are delivered
+    for(const auto& a : analysiss)
+    {
+        a->flush_statistics();
+    }
 }
 
 } // namespace analysis
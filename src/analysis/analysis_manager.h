@@ -23,6 +23,7 @@
 #define ANALYSIS_MANAGER_H
 //------------------------------------------------------------------------------
 #include <memory>
+#include <vector>
 
 #include "analysis/analyzers.h"
 #include "analysis/parser_thread.h"
@@ -37,9 +38,10 @@ namespace analysis
 {
 class AnalysisManager
 {
-    using Parameters        = NST::controller::Parameters;
-    using RunningStatus     = NST::controller::RunningStatus;
-    using FilteredDataQueue = NST::utils::FilteredDataQueue;
+    using Parameters         = NST::controller::Parameters;
+    using RunningStatus      = NST::controller::RunningStatus;
+    using FilteredDataQueue  = NST::utils::FilteredDataQueue;
+    using FilteredDataQueues = NST::utils::FilteredDataQueues;
 
 public:
     AnalysisManager(RunningStatus& status, const Parameters& params);
@@ -47,24 +49,30 @@ public:
     AnalysisManager& operator=(const AnalysisManager&) = delete;
     ~AnalysisManager()                                 = default;
 
-    FilteredDataQueue& get_queue() { return *queue; }
-    void               start();
-    void               stop();
+    FilteredDataQueues& get_queues() { return queues; }
+    void                start();
+    void                stop();
 
     inline void on_unix_signal(int signo)
     {
-        analysiss->on_unix_signal(signo);
+        for(const auto& a : analysiss)
+        {
+            a->on_unix_signal(signo);
+        }
     }
 
     inline bool isSilent()
     {
-        return analysiss->isSilent();
+        return analysiss.front()->isSilent();
     }
 
 private:
-    std::unique_ptr<Analyzers>             analysiss;
-    std::unique_ptr<FilteredDataQueue>     queue;
-    std::unique_ptr<ParserThread<Parsers>> parser_thread;
+    RunningStatus& status;
+
+    // Each parser thread has own queue and analyzers, the first analyzers load plugins
+    std::vector<std::unique_ptr<Analyzers>>             analysiss;
+    FilteredDataQueues                                  queues;
+    std::vector<std::unique_ptr<ParserThread<Parsers>>> parser_threads;
 };
 
 } // namespace analysis
@@ -21,6 +21,7 @@
 //------------------------------------------------------------------------------
 #include "analysis/analyzers.h"
 #include "analysis/print_analyzer.h"
+#include "analysis/ring_exporter.h"
 #include "utils/out.h"
 //------------------------------------------------------------------------------
 namespace NST
@@ -29,6 +30,7 @@ namespace analysis
 {
 Analyzers::Analyzers(const controller::Parameters& params)
     : _silent{false}
+    , _subscription{false}
 {
     for(const auto& a : params.analysis_modules())
     {
@@ -53,7 +55,25 @@ Analyzers::Analyzers(const controller::Parameters& params)
                 }
             }
 
-            modules.emplace_back(plugin->instance());
+            const AnalyzerThreading threading{plugin->concurrency()};
+            if(threading == AnalyzerThreading::Asynchronous)
+            {
+                // gets batches of records only, they are copied to its own thread
+                AnalyzerSubscription records{false};
+                records.records = true;
+                _subscription |= records;
+
+                std::unique_ptr<AsyncDelivery> async{new AsyncDelivery{plugin->instance(), plugin->overflow_policy(), a.path}};
+                producers.emplace_back(async->add_producer());
+                origins.emplace_back(Origin{a, threading, nullptr, std::move(async)});
+                plugins.emplace_back(std::move(plugin));
+                continue;
+            }
+
+            const AnalyzerSubscription handles{plugin->handles()};
+            _subscription |= handles;
+            modules.emplace_back(plugin->instance(), nullptr, handles);
+            origins.emplace_back(Origin{a, threading, nullptr, nullptr});
             plugins.emplace_back(std::move(plugin));
         }
         catch(std::runtime_error& e)
@@ -65,9 +85,102 @@ Analyzers::Analyzers(const controller::Parameters& params)
     if(params.trace()) // add special module for tracing RPC procedures
     {
         std::unique_ptr<IAnalyzer> tracer{new PrintAnalyzer{std::cout}};
+        _subscription |= AnalyzerSubscription{};
         modules.emplace_back(tracer.get());
+        origins.emplace_back(Origin{controller::AParams{""}, AnalyzerThreading::Serialized, nullptr, nullptr});
         builtin.emplace_back(std::move(tracer));
     }
+
+    if(!params.ring_path().empty()) // add special module for publishing records to external readers
+    {
+        std::unique_ptr<IAnalyzer> exporter{new RingExporter{params.ring_path()}};
+        AnalyzerSubscription       records{false};
+        records.records = true;
+        _subscription |= records;
+        modules.emplace_back(exporter.get(), nullptr, records);
+        origins.emplace_back(Origin{controller::AParams{""}, AnalyzerThreading::Serialized, nullptr, nullptr});
+        builtin.emplace_back(std::move(exporter));
+    }
+
+    if(_subscription.batches)
+    {
+        batch.reset(new HeaderBatch);
+    }
+    if(_subscription.records)
+    {
+        records.reset(new RecordBatch);
+    }
+}
+
+Analyzers::Analyzers(Analyzers& first)
+    : _silent{first._silent}
+    , _subscription{first._subscription}
+{
+    std::size_t i{0}; // index of module in the first analyzers
+    for(Origin& origin : first.origins)
+    {
+        if(origin.async)
+        {
+            producers.emplace_back(origin.async->add_producer());
+            continue;
+        }
+
+        const Module& module{first.modules[i]};
+        switch(origin.threading)
+        {
+        case AnalyzerThreading::Asynchronous: // handled above, origin.async is set
+        case AnalyzerThreading::ThreadSafe:
+            modules.emplace_back(module, module.analyzer, nullptr);
+            break;
+        case AnalyzerThreading::PerThread:
+        {
+            std::unique_ptr<PluginInstance> plugin{new PluginInstance{origin.params.path, origin.params.args}};
+            modules.emplace_back(module, plugin->instance(), nullptr);
+            plugins.emplace_back(std::move(plugin));
+        }
+        break;
+        case AnalyzerThreading::Serialized:
+            if(!origin.lock)
+            {
+                origin.lock.reset(new std::mutex);
+                first.modules[i].lock = origin.lock.get();
+            }
+            modules.emplace_back(module, module.analyzer, origin.lock.get());
+            break;
+        }
+        ++i;
+    }
+
+    if(_subscription.batches)
+    {
+        batch.reset(new HeaderBatch);
+    }
+    if(_subscription.records)
+    {
+        records.reset(new RecordBatch);
+    }
+}
+
+void Analyzers::start_async(controller::RunningStatus& status)
+{
+    for(const auto& origin : origins)
+    {
+        if(origin.async)
+        {
+            origin.async->start(status);
+        }
+    }
+}
+
+void Analyzers::stop_async()
+{
+    for(const auto& origin : origins)
+    {
+        if(origin.async)
+        {
+            origin.async->stop();
+        }
+    }
 }
 
 } // namespace analysis
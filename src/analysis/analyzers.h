@@ -23,11 +23,16 @@
 #define ANALYZERS_H
 //------------------------------------------------------------------------------
 #include <memory>
+#include <mutex>
 #include <vector>
 
+#include "analysis/async_delivery.h"
+#include "analysis/header_batch.h"
 #include "analysis/plugin.h"
+#include "analysis/record_batch.h"
 #include "api/plugin_api.h"
 #include "controller/parameters.h"
+#include "controller/running_status.h"
 //------------------------------------------------------------------------------
 namespace NST
 {
@@ -35,12 +40,64 @@ namespace analysis
 {
 class Analyzers
 {
-    using Storage  = std::vector<IAnalyzer*>;
+    //! Analyzer called by parser thread
+    struct Module
+    {
+        Module(IAnalyzer* a, std::mutex* l = nullptr, const AnalyzerSubscription& s = AnalyzerSubscription{}) noexcept
+            : analyzer{a}
+            , lock{l}
+            , headers{s.headers && !s.batches}
+            , batched{s.headers && s.batches}
+            , recorded{s.records}
+        {
+        }
+
+        //! Module of another parser thread which handles the same events
+        Module(const Module& m, IAnalyzer* a, std::mutex* l) noexcept
+            : analyzer{a}
+            , lock{l}
+            , headers{m.headers}
+            , batched{m.batched}
+            , recorded{m.recorded}
+        {
+        }
+
+        //! Locks serialized analyzer shared by several parser threads
+        inline std::unique_lock<std::mutex> serialize() const
+        {
+            return lock ? std::unique_lock<std::mutex>{*lock} : std::unique_lock<std::mutex>{};
+        }
+
+        IAnalyzer*  analyzer;
+        std::mutex* lock;     // not null for serialized analyzer shared by several parser threads
+        bool        headers;  // header-only events are passed one by one
+        bool        batched;  // header-only events are passed in batches
+        bool        recorded; // operation records are passed in batches
+    };
+
+    //! Analyzer loaded by analyzers of the first parser thread
+    struct Origin
+    {
+        controller::AParams            params; // path and args of plugin, builtins have empty path
+        AnalyzerThreading              threading;
+        std::unique_ptr<std::mutex>    lock;  // created when the module is shared by several threads
+        std::unique_ptr<AsyncDelivery> async; // thread of asynchronous analyzer, it isn't in modules
+    };
+
+    using Storage   = std::vector<Module>;
+    using Origins   = std::vector<Origin>;
+    using Producers = std::vector<AsyncDelivery::Producer*>;
     using Plugins  = std::vector<std::unique_ptr<PluginInstance>>;
     using BuiltIns = std::vector<std::unique_ptr<IAnalyzer>>;
 
 public:
     Analyzers(const controller::Parameters& params);
+
+    /*! Constructs analyzers of additional parser thread
+     * Analyzers of the first thread are shared or replicated according to their AnalyzerThreading
+     * \param first - analyzers of the first parser thread
+     */
+    explicit Analyzers(Analyzers& first);
     Analyzers(const Analyzers&) = delete;
     Analyzers& operator=(const Analyzers&) = delete;
 
@@ -50,9 +107,10 @@ public:
         typename Procedure>
     inline void operator()(Handle handle, const Procedure& proc)
     {
-        for(const auto a : modules)
+        for(const auto& m : modules)
         {
-            (a->*handle)(&proc, proc.parg, proc.pres);
+            auto lock = m.serialize();
+            (m.analyzer->*handle)(&proc, proc.parg, proc.pres);
         }
     }
 
@@ -62,9 +120,10 @@ public:
         typename ArgOrResType>
     inline void operator()(Handle handle, const RPCProcedure* rpc, ArgOrResType* arg_or_res)
     {
-        for(const auto a : modules)
+        for(const auto& m : modules)
         {
-            (a->*handle)(rpc, arg_or_res);
+            auto lock = m.serialize();
+            (m.analyzer->*handle)(rpc, arg_or_res);
         }
     }
 
@@ -75,25 +134,100 @@ public:
         typename ResopType>
     inline void operator()(Handle handle, const RPCProcedure* rpc, ArgopType* arg, ResopType* res)
     {
-        for(const auto a : modules)
+        for(const auto& m : modules)
         {
-            (a->*handle)(rpc, arg, res);
+            auto lock = m.serialize();
+            (m.analyzer->*handle)(rpc, arg, res);
         }
     }
 
+    //! This function is used for passing header-only events to analyzers
+    inline void operator()(void (IAnalyzer::IHeaderEvents::*handle)(const HeaderEvent*), const HeaderEvent& event)
+    {
+        for(const auto& m : modules)
+        {
+            if(m.headers)
+            {
+                auto lock = m.serialize();
+                (m.analyzer->*handle)(&event);
+            }
+        }
+        if(batch && batch->push(event))
+        {
+            deliver_batch();
+        }
+    }
+
+    //! This function is used for passing operation records to analyzers
+    inline void operator()(const OpRecord& record)
+    {
+        if(records && records->push(record))
+        {
+            deliver_batch();
+        }
+    }
+
+    //! Passes accumulated header-only events and records to analyzers subscribed to batches
+    inline void deliver_batch()
+    {
+        if(batch && batch->size() != 0)
+        {
+            for(const auto& m : modules)
+            {
+                if(m.batched)
+                {
+                    auto lock = m.serialize();
+                    m.analyzer->headers(batch->events(), batch->size());
+                }
+            }
+            batch->clear();
+        }
+        if(records && records->size() != 0)
+        {
+            for(const auto& m : modules)
+            {
+                if(m.recorded)
+                {
+                    auto lock = m.serialize();
+                    m.analyzer->records(records->records(), records->size());
+                }
+            }
+            for(const auto& p : producers)
+            {
+                p->push(*records);
+            }
+            records->clear();
+        }
+    }
+
+    //! Starts threads of asynchronous analyzers loaded by these analyzers
+    void start_async(controller::RunningStatus& status);
+
+    //! Stops threads of asynchronous analyzers, it must be called after parser threads are stopped
+    void stop_async();
+
+    //! Flushes statistics of instances created by these analyzers, shared ones are flushed by the first thread
     inline void flush_statistics()
     {
-        for(const auto a : modules)
+        for(const auto& p : plugins)
         {
-            a->flush_statistics();
+            p->instance()->flush_statistics();
+        }
+        for(const auto& b : builtin)
+        {
+            b->flush_statistics();
         }
     }
 
     inline void on_unix_signal(int signo)
     {
-        for(const auto a : modules)
+        for(const auto& p : plugins)
+        {
+            p->instance()->on_unix_signal(signo);
+        }
+        for(const auto& b : builtin)
         {
-            a->on_unix_signal(signo);
+            b->on_unix_signal(signo);
         }
     }
     inline bool isSilent()
@@ -101,11 +235,23 @@ public:
         return _silent;
     }
 
+    //! Union of procedures, operations and commands handled by all modules
+    inline const AnalyzerSubscription& subscription() const
+    {
+        return _subscription;
+    }
+
 private:
     Storage  modules; // pointers to all modules (plugins and builtins)
+    Origins  origins; // modules which can be shared or replicated by other parser threads
     Plugins  plugins;
     BuiltIns builtin;
     bool     _silent;
+
+    AnalyzerSubscription         _subscription;
+    std::unique_ptr<HeaderBatch> batch;     // created if some of modules handles batches
+    std::unique_ptr<RecordBatch> records;   // created if some of modules handles records
+    Producers                    producers; // rings of asynchronous analyzers
 };
 
 } // namespace analysis
@@ -0,0 +1,198 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Dedicated thread of asynchronous analyzer fed by parser threads
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef ASYNC_DELIVERY_H
+#define ASYNC_DELIVERY_H
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "analysis/record_batch.h"
+#include "api/plugin_api.h"
+#include "controller/running_status.h"
+#include "utils/out.h"
+#include "utils/spsc_ring.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace analysis
+{
+/*! Calls asynchronous analyzer in its own thread.
+ * Each parser thread passes copies of its batches of operation records
+ * through own bounded ring, so slow analyzer doesn't stall parsing.
+ */
+class AsyncDelivery
+{
+    using RunningStatus = NST::controller::RunningStatus;
+
+public:
+    static constexpr std::size_t ring_size{16}; //!< Batches buffered for each parser thread
+
+    //! Ring written by one parser thread
+    class Producer
+    {
+    public:
+        Producer(AnalyzerOverflow p, const std::atomic<bool>& c)
+            : ring{ring_size}
+            , policy{p}
+            , consuming(c)
+        {
+        }
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+
+        void push(const RecordBatch& batch)
+        {
+            RecordBatch* slot = ring.slot();
+            while(!slot && policy == AnalyzerOverflow::Block && consuming)
+            {
+                std::this_thread::yield();
+                slot = ring.slot();
+            }
+            if(!slot)
+            {
+                dropped += batch.size();
+                return;
+            }
+            slot->assign(batch);
+            ring.push();
+            passed += batch.size();
+        }
+
+    private:
+        friend class AsyncDelivery;
+
+        utils::SPSCRing<RecordBatch> ring;
+        const AnalyzerOverflow       policy;
+        const std::atomic<bool>&     consuming; // false if analyzer thread isn't running
+
+        // counted by parser thread, read after it is stopped
+        uint64_t passed{0};
+        uint64_t dropped{0};
+    };
+
+    AsyncDelivery(IAnalyzer* a, AnalyzerOverflow p, const std::string& n)
+        : analyzer{a}
+        , policy{p}
+        , name{n}
+        , consuming{false}
+        , running{ATOMIC_FLAG_INIT} // false
+    {
+    }
+    AsyncDelivery(const AsyncDelivery&) = delete;
+    AsyncDelivery& operator=(const AsyncDelivery&) = delete;
+    ~AsyncDelivery()
+    {
+        if(delivery.joinable()) stop();
+    }
+
+    //! Adds ring for parser thread, it must be called before start()
+    Producer* add_producer()
+    {
+        producers.emplace_back(new Producer{policy, consuming});
+        return producers.back().get();
+    }
+
+    void start(RunningStatus& s)
+    {
+        if(running.test_and_set()) return;
+        status    = &s;
+        consuming = true;
+        delivery  = std::thread(&AsyncDelivery::thread, this);
+    }
+
+    //! Stops thread after parser threads are stopped, so it delivers all passed events
+    void stop()
+    {
+        running.clear();
+        delivery.join();
+
+        uint64_t passed{0};
+        uint64_t dropped{0};
+        for(const auto& p : producers)
+        {
+            passed += p->passed;
+            dropped += p->dropped;
+        }
+        utils::Out message;
+        message << "Asynchronous analyzer " << name << " got " << passed
+                << " records, dropped: " << dropped;
+    }
+
+private:
+    inline void thread()
+    {
+        try
+        {
+            while(running.test_and_set())
+            {
+                if(!deliver())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            deliver(); // flush rings
+        }
+        catch(...)
+        {
+            status->push_current_exception();
+        }
+        consuming = false; // blocked parser threads drop events now
+    }
+
+    //! Passes all available batches to analyzer, returns false if there were none
+    inline bool deliver()
+    {
+        bool delivered{false};
+        for(const auto& p : producers)
+        {
+            while(const RecordBatch* batch = p->ring.front())
+            {
+                analyzer->records(batch->records(), batch->size());
+                p->ring.pop();
+                delivered = true;
+            }
+        }
+        return delivered;
+    }
+
+    IAnalyzer* const       analyzer;
+    const AnalyzerOverflow policy;
+    const std::string      name;
+
+    std::vector<std::unique_ptr<Producer>> producers;
+    std::atomic<bool>                      consuming;
+    RunningStatus*                         status{nullptr};
+
+    std::thread      delivery;
+    std::atomic_flag running;
+};
+
+} // namespace analysis
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // ASYNC_DELIVERY_H
+//------------------------------------------------------------------------------
@@ -19,13 +19,72 @@
     along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
 */
 //------------------------------------------------------------------------------
+#include <cstddef>
+
 #include "analysis/cifs_parser.h"
+#include "analysis/record_batch.h"
 #include "api/cifs_types.h"
 #include "utils/log.h"
 //------------------------------------------------------------------------------
 using namespace NST::protocols;
 using namespace NST::analysis;
 
+//! Fills header-only event from headers of request and response
+template <typename Header>
+static inline HeaderEvent header_event(const Header*                   response,
+                                       const NST::utils::FilteredData& requestData,
+                                       const NST::utils::FilteredData* responseData,
+                                       const NST::API::Session*        session)
+{
+    HeaderEvent event;
+    event.session     = session;
+    event.call_time   = requestData.timestamp;
+    event.reply_time  = responseData ? responseData->timestamp : requestData.timestamp;
+    event.program     = 0;
+    event.version     = 0;
+    event.reply_stat  = NST::API::ReplyStat::MSG_ACCEPTED;
+    event.accept_stat = NST::API::AcceptStat::SUCCESS;
+    event.status      = response ? static_cast<uint32_t>(response->status) : 0;
+    event.call_size   = requestData.msg_len ? requestData.msg_len : requestData.dlen;
+    event.reply_size  = 0;
+    if(responseData)
+    {
+        event.reply_size = responseData->msg_len ? responseData->msg_len : responseData->dlen;
+    }
+    return event;
+}
+
+//! Fills file handle and range of SMBv2 READ and WRITE from request
+static inline void smb2_io(const NST::protocols::CIFSv2::MessageHeader* request, const uint32_t len, NST::API::OpRecord& record)
+{
+    using namespace NST::API::SMBv2;
+
+    const uint8_t* body{reinterpret_cast<const uint8_t*>(request + 1)};
+    switch(request->cmd_code)
+    {
+    case SMBv2Commands::READ:
+        if(len >= sizeof(*request) + offsetof(ReadRequest, minimumCount))
+        {
+            auto read     = reinterpret_cast<const ReadRequest*>(body);
+            record.fh     = NST::analysis::fnv1a(&read->persistentFileId, 2 * sizeof(uint64_t));
+            record.offset = read->offset;
+            record.count  = read->length;
+        }
+        break;
+    case SMBv2Commands::WRITE:
+        if(len >= sizeof(*request) + offsetof(WriteRequest, Channel))
+        {
+            auto write    = reinterpret_cast<const WriteRequest*>(body);
+            record.fh     = NST::analysis::fnv1a(&write->persistentFileId, 2 * sizeof(uint64_t));
+            record.offset = write->Offset;
+            record.count  = write->Length;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
 CIFSParser::CIFSParser(Analyzers& a)
     : analyzers(a)
 {
@@ -33,6 +92,23 @@ CIFSParser::CIFSParser(Analyzers& a)
 
 bool CIFSParser::parse_data(FilteredDataQueue::Ptr& data)
 {
+    using Protocol = utils::MessageDescriptor::Protocol;
+
+    sessions.sweep(data->timestamp);
+
+    // headers described by filtration are already validated
+    switch(data->descriptor.protocol)
+    {
+    case Protocol::CIFSv1:
+        parse_packet(reinterpret_cast<const CIFSv1::MessageHeader*>(data->data), std::move(data));
+        return true;
+    case Protocol::CIFSv2:
+        parse_packet(reinterpret_cast<const CIFSv2::MessageHeader*>(data->data), std::move(data));
+        return true;
+    default:
+        break;
+    }
+
     if(const CIFSv1::MessageHeader* header = CIFSv1::get_header(data->data))
     {
         parse_packet(header, std::move(data));
@@ -55,6 +131,12 @@ void CIFSParser::parse_packet(const CIFSv1::MessageHeader* header, NST::utils::F
     using namespace NST::API::SMBv1;
     using namespace NST::protocols::CIFSv1;
 
+    const AnalyzerSubscription& subscription{analyzers.subscription()};
+    if(!subscription.headers && !subscription.records && !subscription.subscribed(api_command(header->cmd_code)))
+    {
+        return; // nobody handles this command, so requests aren't kept for responses
+    }
+
     if(header->isFlag(Flags::REPLY))
     {
         // It is response
@@ -88,6 +170,12 @@ void CIFSParser::parse_packet(const CIFSv2::MessageHeader* header, utils::Filter
     using namespace NST::API::SMBv2;
     using namespace NST::protocols::CIFSv2;
 
+    const AnalyzerSubscription& subscription{analyzers.subscription()};
+    if(!subscription.headers && !subscription.records && !subscription.subscribed(header->cmd_code))
+    {
+        return; // nobody handles this command, so requests aren't kept for responses
+    }
+
     if(header->isFlag(Flags::SERVER_TO_REDIR))
     {
         // It is response
@@ -123,13 +211,36 @@ void CIFSParser::parse_packet(const CIFSv2::MessageHeader* header, utils::Filter
 
 void CIFSParser::analyse_operation(Session*                     session,
                                    const CIFSv1::MessageHeader* request,
-                                   const CIFSv1::MessageHeader* /*response*/,
+                                   const CIFSv1::MessageHeader* response,
                                    NST::utils::FilteredDataQueue::Ptr&& requestData,
                                    NST::utils::FilteredDataQueue::Ptr&& responseData)
 {
     using namespace NST::API::SMBv1;
     using namespace NST::protocols::CIFSv1;
 
+    const AnalyzerSubscription& subscription{analyzers.subscription()};
+    const SMBv1Commands         cmd{api_command(request->cmd_code)};
+    if((subscription.headers || subscription.records) && cmd != SMBv1Commands::CMD_COUNT)
+    {
+        // headers are passed before parsing of commands which modifies raw data
+        HeaderEvent event{header_event(response, *requestData, responseData.get(), session)};
+        event.protocol  = Protocol::SMBv1;
+        event.procedure = AnalyzerSubscription::index(cmd);
+        event.id        = static_cast<uint16_t>(request->sec.sequenceNumber);
+        if(subscription.headers)
+        {
+            analyzers(&IAnalyzer::IHeaderEvents::headerSMBv1, event);
+        }
+        if(subscription.records)
+        {
+            analyzers(make_record(event));
+        }
+    }
+    if(!subscription.subscribed(cmd))
+    {
+        return;
+    }
+
     switch(request->cmd_code)
     {
     case Commands::CREATE_DIRECTORY:
@@ -289,13 +400,37 @@ void CIFSParser::analyse_operation(Session*                     session,
 
 void CIFSParser::analyse_operation(Session*                     session,
                                    const CIFSv2::MessageHeader* request,
-                                   const CIFSv2::MessageHeader* /*response*/,
+                                   const CIFSv2::MessageHeader* response,
                                    NST::utils::FilteredDataQueue::Ptr&& requestData,
                                    NST::utils::FilteredDataQueue::Ptr&& responseData)
 {
     using namespace NST::API::SMBv2;
     using namespace NST::protocols::CIFSv2;
 
+    const AnalyzerSubscription& subscription{analyzers.subscription()};
+    if((subscription.headers || subscription.records) && AnalyzerSubscription::index(request->cmd_code) < AnalyzerSubscription::smbv2_count)
+    {
+        // headers are passed before parsing of commands which modifies raw data
+        HeaderEvent event{header_event(response, *requestData, responseData.get(), session)};
+        event.protocol  = Protocol::SMBv2;
+        event.procedure = AnalyzerSubscription::index(request->cmd_code);
+        event.id        = static_cast<uint64_t>(request->messageId);
+        if(subscription.headers)
+        {
+            analyzers(&IAnalyzer::IHeaderEvents::headerSMBv2, event);
+        }
+        if(subscription.records)
+        {
+            OpRecord record{make_record(event)};
+            smb2_io(request, requestData->dlen, record);
+            analyzers(record);
+        }
+    }
+    if(!subscription.subscribed(request->cmd_code))
+    {
+        return;
+    }
+
     switch(request->cmd_code)
     {
     case SMBv2Commands::CLOSE:
@@ -1,6 +1,6 @@
 //------------------------------------------------------------------------------
 // Author: Pavel Karneliuk
-// Description: Dumping pcap frames to a file.
+// Description: Batch of header-only events passed to analyzers at once
 // Copyright (c) 2013 EPAM Systems
 //------------------------------------------------------------------------------
 /*
@@ -19,60 +19,52 @@
     along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
 */
 //------------------------------------------------------------------------------
-#ifndef PACKET_DUMPER_H
-#define PACKET_DUMPER_H
+#ifndef HEADER_BATCH_H
+#define HEADER_BATCH_H
 //------------------------------------------------------------------------------
-#include <pcap/pcap.h>
+#include <cstddef>
 
-#include "filtration/pcap/pcap_error.h"
+#include "api/header_event.h"
 //------------------------------------------------------------------------------
 namespace NST
 {
-namespace filtration
+namespace analysis
 {
-namespace pcap
-{
-class PacketDumper
+/*! Contiguous array of header-only events.
+ * Events carry timestamps by value, so they stay valid after FilteredData
+ * of the messages is returned to the queue.
+ */
+class HeaderBatch
 {
+    using HeaderEvent = NST::API::HeaderEvent;
+
 public:
-    PacketDumper(pcap_t* handle, const char* path)
-        : dumper{pcap_dump_open(handle, path)}
-    {
-        if(dumper == nullptr)
-        {
-            throw PcapError{"pcap_dump_open", pcap_geterr(handle)};
-        }
-    }
-    PacketDumper(const PacketDumper&) = delete;
-    PacketDumper& operator=(const PacketDumper&) = delete;
-    ~PacketDumper()
-    {
-        pcap_dump_close(dumper);
-    }
+    static constexpr std::size_t capacity{256};
 
-    inline void dump(const pcap_pkthdr* h, const u_char* sp)
-    {
-        pcap_dump((u_char*)dumper, h, sp);
-    }
+    HeaderBatch() = default;
+    HeaderBatch(const HeaderBatch&) = delete;
+    HeaderBatch& operator=(const HeaderBatch&) = delete;
 
-    inline void           flush() { pcap_dump_flush(dumper); }
-    inline pcap_dumper_t* get_dumper() { return dumper; }
-    inline FILE*          get_stream() { return pcap_dump_file(dumper); }
-    void                  truncate_all_pcap_data_and_header()
+    /*! Appends copy of event
+     * \param event - header-only event
+     * \return True, if the batch is full and must be delivered
+     */
+    inline bool push(const HeaderEvent& event)
     {
-        pcap_dump_flush(dumper);
-        FILE* stream{pcap_dump_file(dumper)};
-        rewind(stream); // truncate a file to zero
-        pcap_dump_flush(dumper);
+        items[count++] = event;
+        return count == capacity;
     }
 
+    inline void clear() { count = 0; }
+    inline const HeaderEvent* events() const { return items; }
+    inline std::size_t        size() const { return count; }
 private:
-    pcap_dumper_t* dumper;
+    HeaderEvent items[capacity];
+    std::size_t count{0};
 };
 
-} // namespace pcap
-} // namespace filtration
+} // namespace analysis
 } // namespace NST
 //------------------------------------------------------------------------------
-#endif // PACKET_DUMPER_H
+#endif // HEADER_BATCH_H
 //------------------------------------------------------------------------------
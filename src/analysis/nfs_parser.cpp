@@ -20,6 +20,7 @@
 */
 //------------------------------------------------------------------------------
 #include "analysis/nfs_parser.h"
+#include "analysis/record_batch.h"
 #include "protocols/nfs/nfs_procedure.h"
 #include "protocols/rpc/rpc_header.h"
 #include "protocols/xdr/xdr_decoder.h"
@@ -34,6 +35,22 @@ namespace analysis
 bool NFSParser::parse_data(FilteredDataQueue::Ptr& ptr)
 {
     using namespace NST::protocols::rpc;
+    using Protocol = utils::MessageDescriptor::Protocol;
+
+    sessions.sweep(ptr->timestamp);
+
+    if(ptr->descriptor.protocol == Protocol::NFS) // header is validated by filtration
+    {
+        if(ptr->descriptor.reply)
+        {
+            parse_reply(ptr->descriptor.id, ptr);
+        }
+        else
+        {
+            parse_call(reinterpret_cast<const CallHeader*>(ptr->data), ptr);
+        }
+        return true;
+    }
 
     // TODO: refactor and generalize this code
     if(ptr->dlen < sizeof(MessageHeader))
@@ -55,11 +72,7 @@ bool NFSParser::parse_data(FilteredDataQueue::Ptr& ptr)
         if(RPCValidator::check(call) && (protocols::NFS4::Validator::check(call) ||
                                          protocols::NFS3::Validator::check(call)))
         {
-            Session* session = sessions.get_session(ptr->session, ptr->direction, MsgType::CALL);
-            if(session)
-            {
-                session->save_call_data(call->xid(), std::move(ptr));
-            }
+            parse_call(call, ptr);
             return true;
         }
     }
@@ -77,21 +90,40 @@ bool NFSParser::parse_data(FilteredDataQueue::Ptr& ptr)
             return false;
         }
 
-        Session* session = sessions.get_session(ptr->session, ptr->direction, MsgType::REPLY);
-        if(session)
-        {
-            FilteredDataQueue::Ptr&& call_data = session->get_call_data(reply->xid());
-            if(call_data)
-            {
-                analyze_nfs_procedure(std::move(call_data), std::move(ptr), session);
-            }
-            return true;
-        }
+        parse_reply(reply->xid(), ptr);
+        return true;
     }
     }
     return false;
 }
 
+void NFSParser::parse_call(const protocols::rpc::CallHeader* call, FilteredDataQueue::Ptr& ptr)
+{
+    if(!subscribed(call))
+    {
+        return; // nobody handles it, so don't keep the call for its reply
+    }
+
+    Session* session = sessions.get_session(ptr->session, ptr->direction, protocols::rpc::MsgType::CALL);
+    if(session)
+    {
+        session->save_call_data(call->xid(), std::move(ptr));
+    }
+}
+
+void NFSParser::parse_reply(const std::uint64_t xid, FilteredDataQueue::Ptr& ptr)
+{
+    Session* session = sessions.get_session(ptr->session, ptr->direction, protocols::rpc::MsgType::REPLY);
+    if(session)
+    {
+        FilteredDataQueue::Ptr&& call_data = session->get_call_data(xid);
+        if(call_data)
+        {
+            analyze_nfs_procedure(std::move(call_data), std::move(ptr), session);
+        }
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Forward declarations of internal functions used inside analyze_nfs_procedure
 // They're supposed to be used inside analyze_nfs_procedure only
@@ -137,73 +169,74 @@ void nfs4_ops_switch(Analyzers&                         analyzers,
 static inline void analyze_nfsv3_procedure(const uint32_t procedure, XDRDecoder&& c, XDRDecoder&& r, const Session* s, Analyzers& analyzers)
 {
     using namespace NST::protocols::NFS3;
+    const bool b{analyzers.subscription().bodies}; // arguments and results are decoded on demand
     switch(procedure)
     {
     case ProcEnumNFS3::NFS_NULL:
-        analyzers(&IAnalyzer::INFSv3rpcgen::null, NFSPROC3RPCGEN_NULL{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::null, NFSPROC3RPCGEN_NULL{c, r, s, b});
         break;
     case ProcEnumNFS3::GETATTR:
-        analyzers(&IAnalyzer::INFSv3rpcgen::getattr3, NFSPROC3RPCGEN_GETATTR{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::getattr3, NFSPROC3RPCGEN_GETATTR{c, r, s, b});
         break;
     case ProcEnumNFS3::SETATTR:
-        analyzers(&IAnalyzer::INFSv3rpcgen::setattr3, NFSPROC3RPCGEN_SETATTR{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::setattr3, NFSPROC3RPCGEN_SETATTR{c, r, s, b});
         break;
     case ProcEnumNFS3::LOOKUP:
-        analyzers(&IAnalyzer::INFSv3rpcgen::lookup3, NFSPROC3RPCGEN_LOOKUP{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::lookup3, NFSPROC3RPCGEN_LOOKUP{c, r, s, b});
         break;
     case ProcEnumNFS3::ACCESS:
-        analyzers(&IAnalyzer::INFSv3rpcgen::access3, NFSPROC3RPCGEN_ACCESS{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::access3, NFSPROC3RPCGEN_ACCESS{c, r, s, b});
         break;
     case ProcEnumNFS3::READLINK:
-        analyzers(&IAnalyzer::INFSv3rpcgen::readlink3, NFSPROC3RPCGEN_READLINK{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::readlink3, NFSPROC3RPCGEN_READLINK{c, r, s, b});
         break;
     case ProcEnumNFS3::READ:
-        analyzers(&IAnalyzer::INFSv3rpcgen::read3, NFSPROC3RPCGEN_READ{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::read3, NFSPROC3RPCGEN_READ{c, r, s, b});
         break;
     case ProcEnumNFS3::WRITE:
-        analyzers(&IAnalyzer::INFSv3rpcgen::write3, NFSPROC3RPCGEN_WRITE{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::write3, NFSPROC3RPCGEN_WRITE{c, r, s, b});
         break;
     case ProcEnumNFS3::CREATE:
-        analyzers(&IAnalyzer::INFSv3rpcgen::create3, NFSPROC3RPCGEN_CREATE{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::create3, NFSPROC3RPCGEN_CREATE{c, r, s, b});
         break;
     case ProcEnumNFS3::MKDIR:
-        analyzers(&IAnalyzer::INFSv3rpcgen::mkdir3, NFSPROC3RPCGEN_MKDIR{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::mkdir3, NFSPROC3RPCGEN_MKDIR{c, r, s, b});
         break;
     case ProcEnumNFS3::SYMLINK:
-        analyzers(&IAnalyzer::INFSv3rpcgen::symlink3, NFSPROC3RPCGEN_SYMLINK{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::symlink3, NFSPROC3RPCGEN_SYMLINK{c, r, s, b});
         break;
     case ProcEnumNFS3::MKNOD:
-        analyzers(&IAnalyzer::INFSv3rpcgen::mknod3, NFSPROC3RPCGEN_MKNOD{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::mknod3, NFSPROC3RPCGEN_MKNOD{c, r, s, b});
         break;
     case ProcEnumNFS3::REMOVE:
-        analyzers(&IAnalyzer::INFSv3rpcgen::remove3, NFSPROC3RPCGEN_REMOVE{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::remove3, NFSPROC3RPCGEN_REMOVE{c, r, s, b});
         break;
     case ProcEnumNFS3::RMDIR:
-        analyzers(&IAnalyzer::INFSv3rpcgen::rmdir3, NFSPROC3RPCGEN_RMDIR{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::rmdir3, NFSPROC3RPCGEN_RMDIR{c, r, s, b});
         break;
     case ProcEnumNFS3::RENAME:
-        analyzers(&IAnalyzer::INFSv3rpcgen::rename3, NFSPROC3RPCGEN_RENAME{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::rename3, NFSPROC3RPCGEN_RENAME{c, r, s, b});
         break;
     case ProcEnumNFS3::LINK:
-        analyzers(&IAnalyzer::INFSv3rpcgen::link3, NFSPROC3RPCGEN_LINK{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::link3, NFSPROC3RPCGEN_LINK{c, r, s, b});
         break;
     case ProcEnumNFS3::READDIR:
-        analyzers(&IAnalyzer::INFSv3rpcgen::readdir3, NFSPROC3RPCGEN_READDIR{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::readdir3, NFSPROC3RPCGEN_READDIR{c, r, s, b});
         break;
     case ProcEnumNFS3::READDIRPLUS:
-        analyzers(&IAnalyzer::INFSv3rpcgen::readdirplus3, NFSPROC3RPCGEN_READDIRPLUS{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::readdirplus3, NFSPROC3RPCGEN_READDIRPLUS{c, r, s, b});
         break;
     case ProcEnumNFS3::FSSTAT:
-        analyzers(&IAnalyzer::INFSv3rpcgen::fsstat3, NFSPROC3RPCGEN_FSSTAT{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::fsstat3, NFSPROC3RPCGEN_FSSTAT{c, r, s, b});
         break;
     case ProcEnumNFS3::FSINFO:
-        analyzers(&IAnalyzer::INFSv3rpcgen::fsinfo3, NFSPROC3RPCGEN_FSINFO{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::fsinfo3, NFSPROC3RPCGEN_FSINFO{c, r, s, b});
         break;
     case ProcEnumNFS3::PATHCONF:
-        analyzers(&IAnalyzer::INFSv3rpcgen::pathconf3, NFSPROC3RPCGEN_PATHCONF{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::pathconf3, NFSPROC3RPCGEN_PATHCONF{c, r, s, b});
         break;
     case ProcEnumNFS3::COMMIT:
-        analyzers(&IAnalyzer::INFSv3rpcgen::commit3, NFSPROC3RPCGEN_COMMIT{c, r, s});
+        analyzers(&IAnalyzer::INFSv3rpcgen::commit3, NFSPROC3RPCGEN_COMMIT{c, r, s, b});
         break;
     }
 }
@@ -223,7 +256,10 @@ static inline void analyze_nfsv4_procedure(const uint32_t procedure, XDRDecoder&
             break;
         case ProcEnumNFS4::COMPOUND:
             NFSPROC4RPCGEN_COMPOUND compound{c, r, s};
-            analyzers(&IAnalyzer::INFSv4rpcgen::compound4, compound);
+            if(analyzers.subscription().subscribed(ProcEnumNFS4::COMPOUND))
+            {
+                analyzers(&IAnalyzer::INFSv4rpcgen::compound4, compound);
+            }
             analyze_nfs40_operations(analyzers, compound);
             break;
         }
@@ -232,13 +268,237 @@ static inline void analyze_nfsv4_procedure(const uint32_t procedure, XDRDecoder&
         if(ProcEnumNFS41::COMPOUND == procedure)
         {
             NFSPROC41RPCGEN_COMPOUND compound{c, r, s};
-            analyzers(&IAnalyzer::INFSv41rpcgen::compound41, compound);
+            if(analyzers.subscription().subscribed(ProcEnumNFS41::COMPOUND))
+            {
+                analyzers(&IAnalyzer::INFSv41rpcgen::compound41, compound);
+            }
             analyze_nfs41_operations(analyzers, compound);
         }
         break;
     }
 }
 
+//! Reader of XDR words of raw message, it fails instead of reading beyond the message
+class XDRWords
+{
+public:
+    XDRWords(const std::uint8_t* begin, const std::uint8_t* end)
+        : it{begin}
+        , last{end}
+    {
+    }
+
+    inline bool get(uint32_t& value)
+    {
+        if(last - it < 4)
+        {
+            return false;
+        }
+        value = ntohl(*reinterpret_cast<const uint32_t*>(it));
+        it += 4;
+        return true;
+    }
+
+    inline bool get(uint64_t& value)
+    {
+        uint32_t high, low;
+        if(!get(high) || !get(low))
+        {
+            return false;
+        }
+        value = (uint64_t{high} << 32) | low;
+        return true;
+    }
+
+    inline bool skip(const uint64_t len)
+    {
+        const uint64_t padded{(len + 3) & ~uint64_t{3}};
+        if(uint64_t(last - it) < padded)
+        {
+            return false;
+        }
+        it += padded;
+        return true;
+    }
+
+    //! Skips opaque<> and returns pointer to its bytes or nullptr
+    inline const std::uint8_t* opaque(uint32_t& len)
+    {
+        const std::uint8_t* bytes{nullptr};
+        if(get(len))
+        {
+            bytes = it;
+            if(!skip(len))
+            {
+                bytes = nullptr;
+            }
+        }
+        return bytes;
+    }
+
+private:
+    const std::uint8_t* it;
+    const std::uint8_t* const last;
+};
+
+//! Fills file handle and range of NFSv4.x COMPOUND of SEQUENCE, PUTFH and I/O operation
+static void nfs4_io(XDRWords& args, OpRecord& record)
+{
+    uint32_t len, minorversion, count;
+    if(!args.opaque(len) || !args.get(minorversion) || !args.get(count)) // tag
+    {
+        return;
+    }
+
+    uint64_t offset{0};
+    uint32_t op, size{0};
+    for(uint32_t i = 0; i < count && args.get(op); ++i)
+    {
+        switch(op)
+        {
+        case ProcEnumNFS41::SEQUENCE:
+            if(!args.skip(32)) // sessionid, sequenceid, slotid, highest_slotid, cachethis
+            {
+                return;
+            }
+            continue;
+        case ProcEnumNFS4::PUTFH:
+            if(const std::uint8_t* fh = args.opaque(len))
+            {
+                record.fh = fnv1a(fh, len);
+                continue;
+            }
+            return;
+        case ProcEnumNFS4::READ:
+            if(args.skip(16) && args.get(offset) && args.get(size)) // stateid, offset, count
+            {
+                break;
+            }
+            return;
+        case ProcEnumNFS4::WRITE:
+            if(args.skip(16) && args.get(offset) && args.skip(4) && args.get(size)) // stateid, offset, stable, data
+            {
+                break;
+            }
+            return;
+        case ProcEnumNFS4::COMMIT:
+            if(args.get(offset) && args.get(size))
+            {
+                break;
+            }
+            return;
+        default:
+            return; // arguments of other operations aren't skipped
+        }
+        record.operation = op;
+        record.offset    = offset;
+        record.count     = size;
+        return;
+    }
+}
+
+//! Fills file handle and range of I/O of record from arguments of call
+static void nfs_io(const NST::utils::FilteredData& call, OpRecord& record)
+{
+    using namespace NST::protocols::rpc;
+
+    const uint32_t arguments{call_arguments(reinterpret_cast<const CallHeader*>(call.data), call.dlen)};
+    if(!arguments)
+    {
+        return;
+    }
+    XDRWords args{call.data + arguments, call.data + call.dlen};
+
+    if(record.protocol != Protocol::NFSv3)
+    {
+        if(record.procedure == ProcEnumNFS4::COMPOUND)
+        {
+            nfs4_io(args, record);
+        }
+        return;
+    }
+
+    uint32_t len;
+    const std::uint8_t* fh{record.procedure != ProcEnumNFS3::NFS_NULL ? args.opaque(len) : nullptr};
+    if(!fh) // nfs_fh3 is the first argument of all procedures except NULL
+    {
+        return;
+    }
+    record.fh = fnv1a(fh, len);
+
+    uint64_t offset;
+    uint32_t count;
+    switch(record.procedure)
+    {
+    case ProcEnumNFS3::READ:
+    case ProcEnumNFS3::WRITE:
+    case ProcEnumNFS3::COMMIT:
+        if(args.get(offset) && args.get(count))
+        {
+            record.offset = offset;
+            record.count  = count;
+        }
+        break;
+    }
+}
+
+static inline void analyze_nfs_headers(const NST::utils::FilteredData& call, const NST::utils::FilteredData& reply, const Session* s, Analyzers& analyzers)
+{
+    using namespace NST::protocols::rpc;
+
+    auto call_header  = reinterpret_cast<const CallHeader*>(call.data);
+    auto reply_header = reinterpret_cast<const ReplyHeader*>(reply.data);
+
+    HeaderEvent event;
+    event.session     = s;
+    event.call_time   = call.timestamp;
+    event.reply_time  = reply.timestamp;
+    event.procedure   = call_header->proc();
+    event.id          = call_header->xid();
+    event.program     = call_header->prog();
+    event.version     = call_header->vers();
+    event.reply_stat  = reply_header->stat();
+    event.accept_stat = AcceptStat::SUCCESS;
+    event.status      = 0;
+    event.call_size   = call.msg_len ? call.msg_len : call.dlen;
+    event.reply_size  = reply.msg_len ? reply.msg_len : reply.dlen;
+
+    AcceptStat accept;
+    if(reply_status(reply_header, reply.dlen, accept, event.status))
+    {
+        event.accept_stat = accept;
+    }
+
+    void (IAnalyzer::IHeaderEvents::*handle)(const HeaderEvent*);
+    if(NFS_V3 == event.version)
+    {
+        event.protocol = Protocol::NFSv3;
+        handle         = &IAnalyzer::IHeaderEvents::headerNFSv3;
+    }
+    else if(NFS_V41 == get_nfs4_compound_minor_version(event.procedure, call.data))
+    {
+        event.protocol = Protocol::NFSv41;
+        handle         = &IAnalyzer::IHeaderEvents::headerNFSv41;
+    }
+    else
+    {
+        event.protocol = Protocol::NFSv40;
+        handle         = &IAnalyzer::IHeaderEvents::headerNFSv40;
+    }
+
+    const AnalyzerSubscription& subscription{analyzers.subscription()};
+    if(subscription.headers)
+    {
+        analyzers(handle, event);
+    }
+    if(subscription.records)
+    {
+        OpRecord record{make_record(event)};
+        nfs_io(call, record);
+        analyzers(record);
+    }
+}
+
 void NFSParser::analyze_nfs_procedure(FilteredDataQueue::Ptr&& call,
                                       FilteredDataQueue::Ptr&& reply,
                                       Session*                 session)
@@ -248,11 +508,19 @@ void NFSParser::analyze_nfs_procedure(FilteredDataQueue::Ptr&& call,
     auto           header = reinterpret_cast<const CallHeader*>(call->data);
     const uint32_t major_version{header->vers()};
     const uint32_t procedure{header->proc()};
+    const Session* s{session->get_session()};
 
-    try
+    if(analyzers.subscription().headers || analyzers.subscription().records)
     {
-        const Session* s{session->get_session()};
+        analyze_nfs_headers(*call, *reply, s, this->analyzers);
+        if(!decoded(header))
+        {
+            return; // nobody needs procedure itself
+        }
+    }
 
+    try
+    {
         switch(major_version)
         {
         case NFS_V4:
@@ -315,6 +583,37 @@ static uint32_t get_nfs4_compound_minor_version(const uint32_t procedure, const
     return ntohl(*(uint32_t*)it);
 }
 
+bool NFSParser::subscribed(const protocols::rpc::CallHeader* call) const
+{
+    return analyzers.subscription().headers || analyzers.subscription().records || decoded(call);
+}
+
+bool NFSParser::decoded(const protocols::rpc::CallHeader* call) const
+{
+    const AnalyzerSubscription& subscription{analyzers.subscription()};
+    const uint32_t              procedure{call->proc()};
+
+    switch(call->vers())
+    {
+    case NFS_V3:
+        return subscription.subscribed(static_cast<ProcEnumNFS3::NFSProcedure>(procedure));
+    case NFS_V4:
+        if(ProcEnumNFS4::COMPOUND != procedure)
+        {
+            return subscription.subscribed(static_cast<ProcEnumNFS4::NFSProcedure>(procedure));
+        }
+        // COMPOUND is required if any procedure or operation of its minor version is handled
+        switch(get_nfs4_compound_minor_version(procedure, reinterpret_cast<const std::uint8_t*>(call)))
+        {
+        case NFS_V40:
+            return subscription.nfs4.any();
+        case NFS_V41:
+            return subscription.nfs41.any();
+        }
+    }
+    return false;
+}
+
 //! Common internal function for parsing NFSv4.x's COMPOUND procedure
 //! It's supposed to be used inside analyze_nfs_procedure only
 template <
@@ -428,6 +727,11 @@ void nfs4_ops_switch(Analyzers&                        analyzers,
     using res_t   = NST::API::NFS4::nfs_resop4_u_t;
 
     uint32_t nfs_op_num = arg ? arg->argop : res->resop;
+    if(!analyzers.subscription().subscribed(static_cast<ProcEnumNFS4::NFSProcedure>(nfs_op_num)))
+    {
+        return;
+    }
+
     switch(nfs_op_num)
     {
     case ProcEnumNFS4::ACCESS:
@@ -673,6 +977,11 @@ void nfs4_ops_switch(Analyzers&                         analyzers,
     using res_t   = NST::API::NFS41::nfs_resop4_u_t;
 
     uint32_t nfs_op_num = arg ? arg->argop : res->resop;
+    if(!analyzers.subscription().subscribed(static_cast<ProcEnumNFS41::NFSProcedure>(nfs_op_num)))
+    {
+        return;
+    }
+
     switch(nfs_op_num)
     {
     case ProcEnumNFS41::ACCESS:
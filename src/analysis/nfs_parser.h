@@ -26,6 +26,7 @@
 #include "analysis/rpc_sessions.h"
 #include "controller/running_status.h"
 #include "protocols/nfs/nfs_procedure.h"
+#include "protocols/rpc/rpc_header.h"
 #include "utils/filtered_data.h"
 //------------------------------------------------------------------------------
 namespace NST
@@ -41,6 +42,24 @@ class NFSParser
     Analyzers&        analyzers;
     Sessions<Session> sessions;
 
+    /*! Checks that some of analyzers handles the procedure
+     * \param call - header of validated RPC call
+     * \return True, if the call should be matched with its reply and decoded
+     */
+    bool subscribed(const protocols::rpc::CallHeader* call) const;
+
+    /*! Checks that some of analyzers handles arguments, results or operations of the procedure
+     * \param call - header of validated RPC call
+     * \return True, if the procedure should be decoded
+     */
+    bool decoded(const protocols::rpc::CallHeader* call) const;
+
+    //! Saves validated RPC call of NFS program till its reply
+    void parse_call(const protocols::rpc::CallHeader* call, FilteredDataQueue::Ptr& ptr);
+
+    //! Matches validated RPC reply with its call and analyzes them
+    void parse_reply(const std::uint64_t xid, FilteredDataQueue::Ptr& ptr);
+
 public:
     NFSParser(Analyzers& a)
         : analyzers(a)
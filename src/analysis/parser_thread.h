@@ -23,11 +23,13 @@
 #define NFS_PARSER_THREAD_H
 //------------------------------------------------------------------------------
 #include <atomic>
+#include <chrono>
 #include <thread>
 
 #include "analysis/analyzers.h"
 #include "controller/running_status.h"
 #include "utils/filtered_data.h"
+#include "utils/out.h"
 //------------------------------------------------------------------------------
 namespace NST
 {
@@ -63,6 +65,11 @@ public:
     {
         running.clear();
         parsing.join();
+
+        if(utils::Out message{})
+        {
+            print_throughput(message);
+        }
     }
 
 private:
@@ -74,11 +81,13 @@ private:
             {
                 // process all available items from queue
                 process_queue();
+                parser.flush();
 
                 // then sleep this thread
                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
             }
             process_queue(); // flush data from queue
+            parser.flush();
         }
         catch(...)
         {
@@ -97,11 +106,29 @@ private:
                 return; // list from queue is empty, break infinity loop
             }
 
+            const auto begin = std::chrono::steady_clock::now();
             do
             {
                 FilteredDataQueue::Ptr data = list.get_current();
                 parser.parse_data(data);
+                ++messages;
             } while(list);
+            parsing_time += std::chrono::steady_clock::now() - begin;
+        }
+    }
+
+    //! Prints amount of parsed messages and their rate for comparison of analyzers' costs
+    inline void print_throughput(std::ostream& out) const
+    {
+        using namespace std::chrono;
+
+        const double seconds = duration_cast<duration<double>>(parsing_time).count();
+
+        out << "Parsed messages: " << messages
+            << " in " << duration_cast<milliseconds>(parsing_time).count() << " ms";
+        if(seconds > 0.0)
+        {
+            out << " (" << static_cast<uint64_t>(messages / seconds) << " msg/s)";
         }
     }
 
@@ -111,6 +138,9 @@ private:
     std::thread      parsing;
     std::atomic_flag running;
     Parser           parser;
+
+    uint64_t                            messages{0};    //!< Amount of parsed messages
+    std::chrono::steady_clock::duration parsing_time{}; //!< Time spent in parsing and analyzers
 };
 
 } // namespace analysis
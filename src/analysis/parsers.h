@@ -36,26 +36,52 @@ namespace analysis
 class Parsers
 {
     using FilteredDataQueue = NST::utils::FilteredDataQueue;
+    Analyzers& analyzers;   //!< Analyzers of parser thread
     CIFSParser parser_cifs; //!< CIFS parser
     NFSParser  parser_nfs;  //!< NFS parser
 public:
     Parsers(Analyzers& a)
-        : parser_cifs(a)
+        : analyzers(a)
+        , parser_cifs(a)
         , parser_nfs(a)
     {
     }
 
     Parsers(Parsers& c)
-        : parser_cifs(c.parser_cifs)
+        : analyzers(c.analyzers)
+        , parser_cifs(c.parser_cifs)
         , parser_nfs(c.parser_nfs)
     {
     }
 
+    /*! Function which will be called by ParserThread class when its queue is drained
+     * Passes events accumulated in batches, so they aren't delayed by idle capture
+     */
+    inline void flush()
+    {
+        analyzers.deliver_batch();
+    }
+
     /*! Function which will be called by ParserThread class
      * \param data - packet
      */
     inline void parse_data(FilteredDataQueue::Ptr& data)
     {
+        using Protocol = utils::MessageDescriptor::Protocol;
+
+        switch(data->descriptor.protocol) // dispatch by protocol detected in filtration
+        {
+        case Protocol::NFS:
+            parser_nfs.parse_data(data);
+            return;
+        case Protocol::CIFSv1:
+        case Protocol::CIFSv2:
+            parser_cifs.parse_data(data);
+            return;
+        case Protocol::Unknown:
+            break;
+        }
+
         if(!parser_nfs.parse_data(data))
         {
             if(!parser_cifs.parse_data(data))
@@ -41,12 +41,45 @@ bool Plugin::isSilent()
     return false;
 }
 
+AnalyzerSubscription Plugin::subscription()
+{
+    if(const AnalyzerRequirements* r = requirements_of(requirements, version))
+    {
+        return r->subscription;
+    }
+    AnalyzerSubscription everything{}; // everything is handled by default
+    if(version < NST_PLUGIN_API_VERSION_0_5)
+    {
+        everything.headers = false; // old plugins have no IHeaderEvents
+    }
+    return everything;
+}
+
+AnalyzerThreading Plugin::threading()
+{
+    if(const AnalyzerRequirements* r = requirements_of(requirements, version))
+    {
+        return r->threading;
+    }
+    return AnalyzerThreading::Serialized; // plugins aren't thread-safe by default
+}
+
+AnalyzerOverflow Plugin::overflow()
+{
+    if(const AnalyzerRequirements* r = requirements_of(requirements, version))
+    {
+        return r->overflow;
+    }
+    return AnalyzerOverflow::Drop;
+}
+
 Plugin::Plugin(const std::string& path)
     : DynamicLoad{path}
     , usage{nullptr}
     , create{nullptr}
     , destroy{nullptr}
     , requirements{nullptr}
+    , version{0}
 {
     plugin_get_entry_points_func nst_get_entry_points{nullptr};
 
@@ -58,17 +91,17 @@ Plugin::Plugin(const std::string& path)
         throw std::runtime_error{path + ": can't load plugin entry points!"};
     }
 
-    switch(entry_points->vers)
+    version = entry_points->vers;
+    if(version < NST_PLUGIN_API_VERSION_0_4 || version > NST_PLUGIN_API_VERSION)
     {
-    // case NST_PLUGIN_API_VERSION_2_0:
-    // Add 2.0 specific initialization here
-    case NST_PLUGIN_API_VERSION:
-    default:
-        usage        = entry_points->usage;
-        create       = entry_points->create;
-        destroy      = entry_points->destroy;
-        requirements = entry_points->requirements;
+        throw std::runtime_error{path + ": unsupported plugin API version " + std::to_string(version)};
     }
+    // Plugins of 0.4.x have the same entry points, their requirements and
+    // subscription are limited by subscription() and others
+    usage        = entry_points->usage;
+    create       = entry_points->create;
+    destroy      = entry_points->destroy;
+    requirements = entry_points->requirements;
 
     if(!usage || !create || !destroy)
     {
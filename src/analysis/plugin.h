@@ -36,6 +36,16 @@ class Plugin : private NST::utils::DynamicLoad
 public:
     static const std::string usage_of(const std::string& path);
     bool isSilent();
+    AnalyzerSubscription subscription();
+    AnalyzerThreading threading();
+    AnalyzerOverflow overflow();
+
+    //! Requirements of plugin, nullptr if plugin API has no subscription, threading and overflow in them
+    static inline const AnalyzerRequirements* requirements_of(plugin_requirements_func requirements, uint32_t version)
+    {
+        // Requirements of 0.5 and later releases share layout, older ones have the silence member only
+        return requirements != nullptr && version >= NST_PLUGIN_API_VERSION_0_5 ? requirements() : nullptr;
+    }
 
 protected:
     explicit Plugin(const std::string& path);
@@ -46,6 +56,7 @@ protected:
     plugin_create_func       create;
     plugin_destroy_func      destroy;
     plugin_requirements_func requirements;
+    uint32_t                 version; // API version of plugin
 };
 
 class PluginInstance : private Plugin
@@ -58,6 +69,9 @@ public:
 
     inline IAnalyzer* instance() const { return analysis; }
     inline bool       silent() { return isSilent(); }
+    inline AnalyzerSubscription handles() { return subscription(); }
+    inline AnalyzerThreading    concurrency() { return threading(); }
+    inline AnalyzerOverflow     overflow_policy() { return overflow(); }
 private:
     IAnalyzer* analysis;
 };
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Batch of operation records passed to analyzers at once
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef RECORD_BATCH_H
+#define RECORD_BATCH_H
+//------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "api/header_event.h"
+#include "api/op_record.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace analysis
+{
+//! FNV-1a hash of bytes, it is used for file handles and sessions of records
+inline uint64_t fnv1a(const void* data, std::size_t len, uint64_t hash = 14695981039346656037ULL)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    for(std::size_t i = 0; i < len; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+//! Hash of addresses and ports of network session
+inline uint64_t session_hash(const NST::API::Session& session)
+{
+    uint64_t hash = fnv1a(session.port, sizeof(session.port));
+    if(session.ip_type == NST::API::Session::v4)
+    {
+        return fnv1a(session.ip.v4.addr, sizeof(session.ip.v4.addr), hash);
+    }
+    return fnv1a(session.ip.v6.addr, sizeof(session.ip.v6.addr), hash);
+}
+
+/*! Fills record from header-only event
+ * Fields of I/O are zeroed, parsers fill them if they are known.
+ */
+inline NST::API::OpRecord make_record(const NST::API::HeaderEvent& event)
+{
+    NST::API::OpRecord record{};
+    record.version    = NST::API::OP_RECORD_VERSION;
+    record.size       = sizeof(NST::API::OpRecord);
+    record.protocol   = event.protocol;
+    record.procedure  = event.procedure;
+    record.status     = event.status;
+    record.session    = session_hash(*event.session);
+    record.id         = event.id;
+    record.call_time  = event.call_time;
+    record.reply_time = event.reply_time;
+    record.call_size  = event.call_size;
+    record.reply_size = event.reply_size;
+    return record;
+}
+
+/*! Contiguous array of operation records.
+ * Records have no pointers, so the batch can be copied to other threads.
+ */
+class RecordBatch
+{
+    using OpRecord = NST::API::OpRecord;
+
+public:
+    static constexpr std::size_t capacity{256};
+
+    RecordBatch() = default;
+    RecordBatch(const RecordBatch&) = delete;
+    RecordBatch& operator=(const RecordBatch&) = delete;
+
+    /*! Appends copy of record
+     * \param record - operation record
+     * \return True, if the batch is full and must be delivered
+     */
+    inline bool push(const OpRecord& record)
+    {
+        items[count++] = record;
+        return count == capacity;
+    }
+
+    //! Copies records of other batch
+    inline void assign(const RecordBatch& other)
+    {
+        count = other.count;
+        std::copy(other.items, other.items + count, items);
+    }
+
+    inline void clear() { count = 0; }
+    inline const OpRecord* records() const { return items; }
+    inline std::size_t     size() const { return count; }
+private:
+    OpRecord    items[capacity];
+    std::size_t count{0};
+};
+
+} // namespace analysis
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // RECORD_BATCH_H
+//------------------------------------------------------------------------------
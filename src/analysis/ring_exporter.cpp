@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Built-in analyzer which publishes records to shared memory ring
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "analysis/ring_exporter.h"
+#include "utils/out.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace analysis
+{
+using NST::API::OpRingHeader;
+using NST::API::OpRingReaderSlot;
+using NST::API::OpRingSlot;
+
+RingExporter::RingExporter(const std::string& p, uint32_t capacity, uint32_t timeout_ms)
+    : path{p}
+{
+    uint32_t slots_count{2};
+    while(slots_count < capacity) slots_count <<= 1;
+    size = NST::API::op_ring_size(slots_count);
+    mask = slots_count - 1;
+
+    // readers of previous ring keep their mapping, new readers open the new file
+    unlink(path.c_str());
+    const int fd{open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644)};
+    if(fd < 0)
+    {
+        throw std::system_error{errno, std::system_category(), {"Error in creating ring: " + path}};
+    }
+    void* map{MAP_FAILED};
+    if(ftruncate(fd, size) == 0)
+    {
+        map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    const int err{errno};
+    close(fd);
+    if(map == MAP_FAILED)
+    {
+        unlink(path.c_str());
+        throw std::system_error{err, std::system_category(), {"Error in mapping ring: " + path}};
+    }
+
+    header  = static_cast<OpRingHeader*>(map); // the file is zeroed by ftruncate()
+    readers = reinterpret_cast<OpRingReaderSlot*>(header + 1);
+    slots   = reinterpret_cast<OpRingSlot*>(readers + NST::API::OP_RING_READERS);
+    header->version     = NST::API::OP_RING_VERSION;
+    header->record_size = sizeof(OpRecord);
+    header->slot_size   = sizeof(OpRingSlot);
+    header->capacity    = slots_count;
+    header->timeout_ms  = timeout_ms;
+    header->magic.store(NST::API::OP_RING_MAGIC, std::memory_order_release);
+}
+
+RingExporter::~RingExporter()
+{
+    munmap(header, size);
+    unlink(path.c_str());
+}
+
+void RingExporter::records(const OpRecord* batch, std::size_t count)
+{
+    if(attached() == 0)
+    {
+        return; // nobody reads the ring, killed readers are detached by timeout
+    }
+
+    for(const OpRecord* r = batch; r != batch + count; ++r)
+    {
+        OpRingSlot& slot = slots[++published & mask];
+        slot.number.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot.record, r, sizeof(OpRecord));
+        slot.number.store(published, std::memory_order_release);
+    }
+    header->head.store(published, std::memory_order_release);
+}
+
+void RingExporter::flush_statistics()
+{
+    utils::Out message;
+    message << "Ring " << path << " published " << published << " records to "
+            << attached() << " readers";
+}
+
+std::size_t RingExporter::attached() const
+{
+    const uint64_t now{NST::API::op_ring_clock()};
+    std::size_t    count{0};
+    for(uint32_t i = 0; i < NST::API::OP_RING_READERS; ++i)
+    {
+        if(NST::API::op_ring_alive(readers[i].heartbeat.load(std::memory_order_relaxed), now, header->timeout_ms))
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace analysis
+} // namespace NST
+//------------------------------------------------------------------------------
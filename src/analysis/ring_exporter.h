@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Built-in analyzer which publishes records to shared memory ring
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef RING_EXPORTER_H
+#define RING_EXPORTER_H
+//------------------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+
+#include "api/op_ring.h"
+#include "api/plugin_api.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace analysis
+{
+/*! Writer of the ring read by external processes with OpRingReader.
+ * The ring is a file mapped to memory, it is expected to be in /dev/shm.
+ * Records are copied only while some readers are attached, a reader is
+ * attached while it reads records more often than the timeout.
+ * It must be called by one parser thread at a time (serialized module).
+ */
+class RingExporter : public IAnalyzer
+{
+public:
+    static constexpr uint32_t default_capacity{65536}; //!< Slots of the ring, about 5.5 MBytes
+    static constexpr uint32_t default_timeout_ms{5000}; //!< Readers without reads for this time are detached
+
+    RingExporter(const std::string& path, uint32_t capacity = default_capacity, uint32_t timeout_ms = default_timeout_ms);
+    ~RingExporter();
+    RingExporter(const RingExporter&) = delete;
+    RingExporter& operator=(const RingExporter&) = delete;
+
+    void records(const OpRecord* batch, std::size_t count) override final;
+    void flush_statistics() override final;
+
+    //! Amount of readers which have read records recently
+    std::size_t attached() const;
+
+private:
+    const std::string           path;
+    NST::API::OpRingHeader*     header;
+    NST::API::OpRingReaderSlot* readers;
+    NST::API::OpRingSlot*       slots;
+    std::size_t             size;
+    uint64_t                mask;
+    uint64_t                published{0}; // number of the last published record
+};
+
+} // namespace analysis
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // RING_EXPORTER_H
+//------------------------------------------------------------------------------
@@ -23,16 +23,17 @@
 #define RPC_SESSIONS_H
 //------------------------------------------------------------------------------
 #include <cinttypes>
+#include <ctime>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
-#include <unordered_map>
 
 #include "protocols/rpc/rpc_header.h"
 #include "utils/filtered_data.h"
 #include "utils/log.h"
 #include "utils/out.h"
+#include "utils/pending_calls.h"
 #include "utils/sessions.h"
 //------------------------------------------------------------------------------
 namespace NST
@@ -44,48 +45,73 @@ class Session : public utils::ApplicationSession
     using FilteredDataQueue = NST::utils::FilteredDataQueue;
 
 public:
+    //! Requests older than this amount of seconds are treated as unmatched
+    static constexpr std::time_t expiration_timeout{120};
+    //! Period of sweeping requests which are waiting for responses, in seconds
+    static constexpr std::time_t expiration_period{10};
+
     Session(const utils::NetworkSession& s, utils::Session::Direction call_direction)
         : utils::ApplicationSession{s, call_direction}
     {
         utils::Out message;
         message << "Detect session " << str();
     }
-    ~Session()              = default;
+    ~Session()
+    {
+        if(const std::uint64_t n{unmatched_calls()})
+        {
+            utils::Out message;
+            message << "Session " << str() << " has " << n
+                    << " requests without responses, " << expired << " of them are expired";
+        }
+    }
     Session(const Session&) = delete;
     Session& operator=(const Session&) = delete;
 
     void save_call_data(const std::uint64_t xid, FilteredDataQueue::Ptr&& data)
     {
-        FilteredDataQueue::Ptr& e = operations[xid];
-        if(e) // xid call already exists
+        const std::time_t stamp{std::time_t(data->timestamp / 1000000000)};
+        if(operations.insert(xid, stamp, std::move(data))) // xid call already exists
         {
             LOG("replace RPC Call XID:%" PRIu64 " for %s", xid, str().c_str());
+            ++unmatched;
         }
-
-        e = std::move(data); // replace existing or set new
     }
     inline FilteredDataQueue::Ptr get_call_data(const std::uint64_t xid)
     {
-        auto i = operations.find(xid);
-        if(i != operations.end())
-        {
-            FilteredDataQueue::Ptr ptr{std::move(i->second)};
-            operations.erase(i);
-            return ptr;
-        }
-        else
+        FilteredDataQueue::Ptr ptr{operations.extract(xid)};
+        if(!ptr)
         {
             LOG("RPC Call XID:%" PRIu64 " is not found for %s", xid, str().c_str());
         }
-
-        return FilteredDataQueue::Ptr{};
+        return ptr;
     }
 
     inline const Session* get_session() const { return this; }
+    //! Amount of requests which have not got responses yet or were expired/replaced
+    inline std::uint64_t unmatched_calls() const { return unmatched + operations.size(); }
+
+    /*! Releases memory of requests which responses will never be seen
+     * \param now - time of the last packet in seconds
+     * \return amount of expired requests
+     */
+    std::size_t sweep(const std::time_t now)
+    {
+        const std::size_t n{operations.expire(now - expiration_timeout)};
+        if(n != 0)
+        {
+            LOG("%zu RPC Calls are expired without replies for %s", n, str().c_str());
+            unmatched += n;
+            expired += n;
+        }
+        return n;
+    }
+
 private:
-    // TODO: add custom allocator based on BlockAllocator
-    // to decrease cost of expensive insert/erase operations
-    std::unordered_map<std::uint64_t, FilteredDataQueue::Ptr> operations;
+    utils::PendingCalls<FilteredDataQueue::Ptr> operations;
+
+    std::uint64_t unmatched{0}; //!< Amount of expired and replaced requests
+    std::uint64_t expired{0};   //!< Amount of expired requests
 };
 
 template <typename Session>
@@ -115,8 +141,36 @@ public:
         return reinterpret_cast<Session*>(app->application);
     }
 
+    /*! Expires requests of all sessions, including idle and closed ones
+     * It is called for each message, sessions are swept once per Session::expiration_period.
+     * \param timestamp - time of message in nanoseconds since Epoch
+     */
+    void sweep(const std::int64_t timestamp)
+    {
+        const std::time_t now{std::time_t(timestamp / 1000000000)};
+        if(now < next_sweep)
+        {
+            return;
+        }
+        next_sweep = now + Session::expiration_period;
+
+        std::size_t   expired{0};
+        std::uint64_t unmatched{0};
+        for(const auto& s : sessions)
+        {
+            expired += s->sweep(now);
+            unmatched += s->unmatched_calls();
+        }
+        if(expired != 0)
+        {
+            LOG("%zu RPC Calls are expired without replies, %" PRIu64 " requests of %zu sessions are unmatched",
+                expired, unmatched, sessions.size());
+        }
+    }
+
 private:
     std::vector<std::unique_ptr<Session>> sessions;
+    std::time_t                           next_sweep{0};
 };
 
 } // namespace analysis
@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Set of 64-bit counters updated by analyzers without locked instructions
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef COUNTER_SET_H
+#define COUNTER_SET_H
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace API
+{
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Counters are read while they are written");
+
+/*! Set of counters which are written by many threads and read by others.
+ * Every writer thread has its own slot of counters aligned and padded to
+ * cache lines, so writers neither share lines with each other nor use locked
+ * instructions: a counter is incremented by plain load and store. The slot
+ * is guarded by a sequence (seqlock), readers sum slots and retry a slot
+ * which is being changed, so they never see a half-done batch of a writer.
+ * Threads beyond MaxWriters share one slot under mutex.
+ */
+class CounterSet
+{
+    static constexpr std::size_t LineSize{64};
+    static constexpr std::size_t LineWords{LineSize / sizeof(uint64_t)};
+
+public:
+    static constexpr std::size_t MaxWriters{64}; //!< Writer threads with own slots
+
+    //! Slot is opened for writes, it is closed by destructor
+    class Batch
+    {
+    public:
+        explicit Batch(CounterSet& set)
+        {
+            std::size_t writer{CounterSet::writer()};
+            if(writer >= MaxWriters)
+            {
+                writer = MaxWriters;
+                lock   = std::unique_lock<std::mutex>{set.shared};
+            }
+            slot = set.slot(writer);
+            slot[0].store(slot[0].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        ~Batch()
+        {
+            slot[0].store(slot[0].load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+        void add(std::size_t index, uint64_t value = 1)
+        {
+            std::atomic<uint64_t>& counter = slot[index + 1];
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+    private:
+        std::unique_lock<std::mutex> lock;
+        std::atomic<uint64_t>*       slot;
+    };
+
+    explicit CounterSet(std::size_t size)
+        : amount{size}
+        , words{(size + LineWords) / LineWords * LineWords} // sequence and counters
+    {
+        for(auto& s : slots)
+        {
+            s.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    ~CounterSet()
+    {
+        for(auto& s : slots)
+        {
+            std::free(s.load(std::memory_order_relaxed));
+        }
+    }
+    CounterSet(const CounterSet&) = delete;
+    CounterSet& operator=(const CounterSet&) = delete;
+
+    std::size_t size() const { return amount; }
+
+    //! Adds value to counter, use Batch for several counters
+    void add(std::size_t index, uint64_t value = 1)
+    {
+        Batch batch{*this};
+        batch.add(index, value);
+    }
+
+    /*! Sums counters of all writers
+     * \param values - vector for size() counters
+     */
+    void snapshot(std::vector<uint64_t>& values) const
+    {
+        values.assign(amount, 0);
+        std::vector<uint64_t> copy(amount);
+        for(const auto& s : slots)
+        {
+            const std::atomic<uint64_t>* slot{s.load(std::memory_order_acquire)};
+            if(slot != nullptr)
+            {
+                read(slot, copy);
+                for(std::size_t i = 0; i < amount; ++i)
+                {
+                    values[i] += copy[i];
+                }
+            }
+        }
+    }
+
+private:
+    //! Index of calling thread, indexes are not reused
+    static std::size_t writer()
+    {
+        static std::atomic<std::size_t> writers{0};
+        thread_local const std::size_t  index{writers.fetch_add(1, std::memory_order_relaxed)};
+        return index;
+    }
+
+    //! Slot of writer, it is allocated by its writer only
+    std::atomic<uint64_t>* slot(std::size_t writer)
+    {
+        std::atomic<uint64_t>* slot{slots[writer].load(std::memory_order_relaxed)};
+        if(slot == nullptr)
+        {
+            void* memory{nullptr};
+            if(posix_memalign(&memory, LineSize, words * sizeof(uint64_t)) != 0)
+            {
+                throw std::bad_alloc{};
+            }
+            slot = static_cast<std::atomic<uint64_t>*>(memory);
+            for(std::size_t i = 0; i < words; ++i)
+            {
+                new(&slot[i]) std::atomic<uint64_t>{0};
+            }
+            slots[writer].store(slot, std::memory_order_release);
+        }
+        return slot;
+    }
+
+    void read(const std::atomic<uint64_t>* slot, std::vector<uint64_t>& copy) const
+    {
+        for(;;)
+        {
+            const uint64_t sequence{slot[0].load(std::memory_order_acquire)};
+            if(sequence & 1) // the writer is in the middle of a batch
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for(std::size_t i = 0; i < amount; ++i)
+            {
+                copy[i] = slot[i + 1].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(slot[0].load(std::memory_order_relaxed) == sequence)
+            {
+                return;
+            }
+        }
+    }
+
+    const std::size_t                   amount;
+    const std::size_t                   words; // of a slot, including its sequence
+    std::atomic<std::atomic<uint64_t>*> slots[MaxWriters + 1]; // the last one is shared
+    std::mutex                          shared;
+};
+
+} // namespace API
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // COUNTER_SET_H
+//------------------------------------------------------------------------------
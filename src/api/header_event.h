@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Header-only description of request matched with its response
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef HEADER_EVENT_H
+#define HEADER_EVENT_H
+//------------------------------------------------------------------------------
+#include <cstdint>
+
+#include <sys/time.h>
+
+#include "session.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace API
+{
+//! Protocols of messages which can be passed to analyzers
+enum class Protocol : uint8_t
+{
+    NFSv3  = 0,
+    NFSv40 = 1,
+    NFSv41 = 2,
+    SMBv1  = 3,
+    SMBv2  = 4
+};
+
+/*! Description of request and its response built from their headers only.
+ * It is filled without decoding of arguments and results, so it is much
+ * cheaper than procedures passed to INFSv3rpcgen and others.
+ */
+struct HeaderEvent
+{
+    const struct Session* session;
+    int64_t               call_time;  //!< Timestamp of request in nanoseconds since Epoch
+    int64_t               reply_time; //!< Timestamp of response in nanoseconds since Epoch
+
+    Protocol protocol;
+    uint32_t procedure;   //!< NFS procedure or position of SMB command in SMBv1Commands/SMBv2Commands
+    uint64_t id;          //!< RPC xid or SMB message id
+    uint32_t program;     //!< RPC program, 0 for SMB
+    uint32_t version;     //!< RPC version of program, 0 for SMB
+    int32_t  reply_stat;  //!< RPC ReplyStat, MSG_ACCEPTED for SMB
+    int32_t  accept_stat; //!< RPC AcceptStat if reply is accepted, SUCCESS for SMB
+    uint32_t status;      //!< First word of results (nfsstat3, nfsstat4) or NT status of SMB response
+    uint32_t call_size;   //!< Length of request message
+    uint32_t reply_size;  //!< Length of response message, 0 if there is no response (async SMBv2 request)
+};
+
+} // namespace API
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // HEADER_EVENT_H
+//------------------------------------------------------------------------------
@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Top of clients and files which send the most operations
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef HEAVY_HITTERS_H
+#define HEAVY_HITTERS_H
+//------------------------------------------------------------------------------
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "header_event.h"
+#include "op_record.h"
+#include "top_keys.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace API
+{
+//! Address of client (source of session) of operation
+struct ClientAddress
+{
+    uint64_t words[2]; //!< IPv4 address is in the first word, the rest is 0
+    bool     v6;
+
+    explicit ClientAddress(const Session& session)
+        : words{0, 0}
+        , v6{session.ip_type == Session::IPType::v6}
+    {
+        if(v6)
+        {
+            std::memcpy(words, session.ip.v6.addr[Session::Source], sizeof(words));
+        }
+        else
+        {
+            words[0] = session.ip.v4.addr[Session::Source];
+        }
+    }
+
+    bool operator==(const ClientAddress& other) const
+    {
+        return words[0] == other.words[0] && words[1] == other.words[1] && v6 == other.v6;
+    }
+
+    std::string to_string() const
+    {
+        char buffer[INET6_ADDRSTRLEN];
+        inet_ntop(v6 ? AF_INET6 : AF_INET, words, buffer, sizeof(buffer));
+        return buffer;
+    }
+};
+
+struct ClientAddressHash
+{
+    std::size_t operator()(const ClientAddress& a) const
+    {
+        return std::hash<uint64_t>{}((a.words[0] ^ a.v6) * 0x9e3779b97f4a7c15ULL ^ a.words[1]);
+    }
+};
+
+//! Text of hash of file handle, as it is in OpRecord::fh
+inline std::string file_handle_hash(uint64_t fh)
+{
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016" PRIx64, fh);
+    return buffer;
+}
+
+/*! Clients and files (hashes of file handles) which send or receive
+ * the most operations recently. Both tops are bounded by capacity whatever
+ * amount of clients and files is seen, see TopKeys. Clients are accounted
+ * from headers of operations, files from records of operations which have
+ * file handle. Batches may be accounted by several threads concurrently.
+ */
+class HeavyHitters
+{
+public:
+    using Clients = TopKeys<ClientAddress, ClientAddressHash>;
+    using Files   = TopKeys<uint64_t>;
+
+    static constexpr std::size_t DefaultCapacity{1024};
+    static constexpr uint32_t    DefaultHalfLifeS{60};
+
+    /*! Creates empty tops
+     * \param capacity - maximal amount of monitored clients and files
+     * \param halfLifeS - half-life of counts of operations in seconds, 0 disables decay
+     */
+    HeavyHitters(std::size_t capacity, uint32_t halfLifeS)
+        : _clients{capacity, uint64_t{halfLifeS} * 1000000000ULL}
+        , _files{capacity, uint64_t{halfLifeS} * 1000000000ULL}
+    {
+    }
+    HeavyHitters(const HeavyHitters&) = delete;
+    HeavyHitters& operator=(const HeavyHitters&) = delete;
+
+    void account(const HeaderEvent* events, std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock{_clientsMutex};
+        for(const HeaderEvent* e = events; e != events + count; ++e)
+        {
+            _clients.add(ClientAddress{*e->session}, static_cast<uint64_t>(e->call_time));
+        }
+    }
+
+    void account(const OpRecord* records, std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock{_filesMutex};
+        for(const OpRecord* r = records; r != records + count; ++r)
+        {
+            if(r->fh != 0)
+            {
+                _files.add(r->fh, r->call_time);
+            }
+        }
+    }
+
+    void clients(std::size_t amount, std::vector<Clients::Entry>& entries) const
+    {
+        std::lock_guard<std::mutex> lock{_clientsMutex};
+        _clients.top(amount, entries);
+    }
+
+    void files(std::size_t amount, std::vector<Files::Entry>& entries) const
+    {
+        std::lock_guard<std::mutex> lock{_filesMutex};
+        _files.top(amount, entries);
+    }
+
+private:
+    mutable std::mutex _clientsMutex;
+    mutable std::mutex _filesMutex;
+    Clients            _clients;
+    Files              _files;
+};
+
+} // namespace API
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // HEAVY_HITTERS_H
+//------------------------------------------------------------------------------
@@ -24,11 +24,15 @@
 #ifndef IANALYZER_TYPE_H
 #define IANALYZER_TYPE_H
 //------------------------------------------------------------------------------
+#include <cstddef>
+
 #include "cifs_types.h"
+#include "header_event.h"
 #include "nfs3_types_rpcgen.h"
 #include "nfs41_types_rpcgen.h"
 #include "nfs4_types_rpcgen.h"
 #include "nfs_types.h"
+#include "op_record.h"
 #include "rpc_types.h"
 //------------------------------------------------------------------------------
 namespace NST
@@ -1793,10 +1797,74 @@ public:
     // clang-format on
 };
 
+/*! Abstract interface of plugin which collects statistics from headers of messages only
+ * These events are passed before procedures and commands of other interfaces
+ */
+class IHeaderEvents
+{
+public:
+    virtual ~IHeaderEvents() {}
+
+    /*! NFSv3 procedure "on receive" event handler
+     * \param event - headers of call and reply
+     */
+    virtual void headerNFSv3(const HeaderEvent*) {}
+
+    /*! NFSv4.0 procedure "on receive" event handler
+     * \param event - headers of call and reply
+     */
+    virtual void headerNFSv40(const HeaderEvent*) {}
+
+    /*! NFSv4.1 procedure "on receive" event handler
+     * \param event - headers of call and reply
+     */
+    virtual void headerNFSv41(const HeaderEvent*) {}
+
+    /*! SMBv1 command "on receive" event handler
+     * \param event - headers of request and response
+     */
+    virtual void headerSMBv1(const HeaderEvent*) {}
+
+    /*! SMBv2 command "on receive" event handler
+     * \param event - headers of request and response
+     */
+    virtual void headerSMBv2(const HeaderEvent*) {}
+
+    /*! Batch of header-only events, it is called instead of the handlers above
+     * if analyzer subscribes to batches (see AnalyzerSubscription::batches).
+     * By default each event is passed to the handler of its protocol.
+     * \param events - array of events, they are valid only during the call
+     * \param count - amount of events in the array
+     */
+    virtual void headers(const HeaderEvent* events, std::size_t count)
+    {
+        for(const HeaderEvent* e = events; e != events + count; ++e)
+        {
+            switch(e->protocol)
+            {
+            case Protocol::NFSv3:  headerNFSv3(e);  break;
+            case Protocol::NFSv40: headerNFSv40(e); break;
+            case Protocol::NFSv41: headerNFSv41(e); break;
+            case Protocol::SMBv1:  headerSMBv1(e);  break;
+            case Protocol::SMBv2:  headerSMBv2(e);  break;
+            }
+        }
+    }
+
+    /*! Batch of operation records, it is called if analyzer subscribes
+     * to records (see AnalyzerSubscription::records).
+     * \param records - array of records, they are valid only during the call
+     * \param count - amount of records in the array
+     */
+    virtual void records(const OpRecord* /*records*/, std::size_t /*count*/) {}
+};
+
 /*! Base interface for all nfstrace plugins.
- * Extends protocol interfaces: NFS3, NFS4, NFS41, SMBv1, SMBv2
+ * Extends protocol interfaces: NFS3, NFS4, NFS41, SMBv1, SMBv2 and headers-only events.
+ * IHeaderEvents is the last base, so layout of other bases and own virtual
+ * functions is the same as in plugins of 0.4.x which have no IHeaderEvents.
  */
-class IAnalyzer : public INFSv3rpcgen, public INFSv4rpcgen, public INFSv41rpcgen, public ISMBv1, public ISMBv2
+class IAnalyzer : public INFSv3rpcgen, public INFSv4rpcgen, public INFSv41rpcgen, public ISMBv1, public ISMBv2, public IHeaderEvents
 {
 public:
     virtual ~IAnalyzer() {}
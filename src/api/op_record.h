@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Fixed-size record of operation passed to plugins
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef OP_RECORD_H
+#define OP_RECORD_H
+//------------------------------------------------------------------------------
+#include <cstdint>
+
+#include "header_event.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace API
+{
+//! Version of OpRecord layout, it is increased when fields are added or changed
+constexpr uint16_t OP_RECORD_VERSION{1};
+
+/*! Self-contained record of request and its response.
+ * Unlike HeaderEvent it has no pointers, so records can be copied, stored
+ * or written to files as is. New fields are appended only, so readers
+ * check version and size before accessing them.
+ */
+struct OpRecord
+{
+    uint16_t version;    //!< OP_RECORD_VERSION
+    uint16_t size;       //!< sizeof(OpRecord)
+    Protocol protocol;   //!< Protocol of request and response
+    uint8_t  reserved1;  //!< Must be 0
+    uint16_t reserved2;  //!< Must be 0
+    uint32_t procedure;  //!< NFS procedure or position of SMB command in SMBv1Commands/SMBv2Commands
+    uint32_t status;     //!< First word of results (nfsstat3, nfsstat4) or NT status of SMB response
+    uint64_t session;    //!< Hash of addresses and ports of network session
+    uint64_t id;         //!< RPC xid or SMB message id
+    uint64_t call_time;  //!< Timestamp of request in nanoseconds since Epoch
+    uint64_t reply_time; //!< Timestamp of response in nanoseconds since Epoch
+    uint32_t call_size;  //!< Length of request message
+    uint32_t reply_size; //!< Length of response message, 0 if there is no response (async SMBv2 request)
+    uint64_t fh;         //!< Hash of file handle (SMBv2 FileId), 0 if it is unknown
+    uint64_t offset;     //!< Offset of READ/WRITE/COMMIT, 0 for other operations
+    uint32_t count;      //!< Bytes requested by READ/WRITE/COMMIT, 0 for other operations
+    uint32_t operation;  //!< NFSv4.x operation of COMPOUND which carries I/O, 0 if it is unknown
+} __attribute__((__packed__));
+
+static_assert(sizeof(OpRecord) == 80, "OpRecord layout is a part of plugin ABI");
+
+} // namespace API
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // OP_RECORD_H
+//------------------------------------------------------------------------------
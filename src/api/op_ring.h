@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Layout and reader of shared memory ring of operation records
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef OP_RING_H
+#define OP_RING_H
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "op_record.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace API
+{
+constexpr uint32_t OP_RING_MAGIC{0x4e53544f}; //!< "NSTO", it is written after the ring is initialized
+constexpr uint16_t OP_RING_VERSION{2};
+constexpr uint32_t OP_RING_READERS{16}; //!< Maximal amount of attached readers
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Counters of the ring are shared by processes");
+
+/*! Header of file mapped by nfstrace (the writer) and external readers.
+ * It is followed by OP_RING_READERS slots of readers and capacity slots of records.
+ * Records are numbered from 1, record N is stored in slot N % capacity.
+ */
+struct OpRingHeader
+{
+    std::atomic<uint32_t> magic;       //!< OP_RING_MAGIC, 0 while ring is initialized
+    uint16_t              version;     //!< OP_RING_VERSION
+    uint16_t              record_size; //!< sizeof(OpRecord) of the writer
+    uint32_t              slot_size;   //!< sizeof(OpRingSlot) of the writer
+    uint32_t              capacity;    //!< Amount of slots, it is a power of 2
+    std::atomic<uint64_t> head;        //!< Number of the last published record, 0 if there are none
+    uint32_t              timeout_ms;  //!< Reader is detached if it doesn't read records for this time
+    uint32_t              reserved;
+    char                  padding[32];
+};
+
+/*! Slot of attached reader, it is refreshed by each read of the reader.
+ * A reader which is killed leaves a stale heartbeat, so the writer and new
+ * readers treat its slot as free after OpRingHeader::timeout_ms.
+ */
+struct OpRingReaderSlot
+{
+    std::atomic<uint64_t> heartbeat; //!< CLOCK_MONOTONIC of the last read in nanoseconds, 0 if slot is free
+    char                  padding[56];
+};
+
+//! Slot of the ring, the writer overwrites the oldest record
+struct OpRingSlot
+{
+    std::atomic<uint64_t> number; //!< Number of stored record, 0 while it is being written
+    OpRecord              record;
+};
+
+static_assert(sizeof(OpRingHeader) == 64, "OpRingHeader layout is shared by processes");
+static_assert(sizeof(OpRingReaderSlot) == 64, "OpRingReaderSlot layout is shared by processes");
+
+//! Size of file of the ring with capacity slots
+inline std::size_t op_ring_size(uint32_t capacity)
+{
+    return sizeof(OpRingHeader) + OP_RING_READERS * sizeof(OpRingReaderSlot) + std::size_t{capacity} * sizeof(OpRingSlot);
+}
+
+//! Clock of heartbeats of readers, it is the same for all processes of the host
+inline uint64_t op_ring_clock()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec) * 1000000000 + uint64_t(now.tv_nsec);
+}
+
+//! Reader of the slot has read records recently
+inline bool op_ring_alive(uint64_t heartbeat, uint64_t now, uint32_t timeout_ms)
+{
+    return heartbeat != 0 && now - heartbeat < uint64_t{timeout_ms} * 1000000;
+}
+
+/*! Lossy reader of the ring published by nfstrace --ring=PATH.
+ * Reader gets records published after it is attached. If it is slower
+ * than the writer, overwritten records are skipped and counted as lost.
+ * Reader must call read() more often than OpRingHeader::timeout_ms,
+ * otherwise the writer treats it as detached and stops publishing.
+ */
+class OpRingReader
+{
+public:
+    explicit OpRingReader(const std::string& path)
+    {
+        // the file is opened for writing, because readers register themselves in their slots
+        const int fd{open(path.c_str(), O_RDWR)};
+        if(fd < 0)
+        {
+            throw std::system_error{errno, std::system_category(), {"Error in opening ring: " + path}};
+        }
+        struct stat st;
+        void*       map{MAP_FAILED};
+        if(fstat(fd, &st) == 0 && std::size_t(st.st_size) >= sizeof(OpRingHeader))
+        {
+            size = st.st_size;
+            map  = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if(map == MAP_FAILED)
+        {
+            throw std::system_error{EINVAL, std::system_category(), {"Error in mapping ring: " + path}};
+        }
+
+        header = static_cast<OpRingHeader*>(map);
+        if(header->magic.load(std::memory_order_acquire) != OP_RING_MAGIC ||
+           header->version != OP_RING_VERSION ||
+           header->slot_size != sizeof(OpRingSlot) ||
+           op_ring_size(header->capacity) > size)
+        {
+            munmap(map, size);
+            throw std::system_error{EINVAL, std::system_category(), {"Incompatible or uninitialized ring: " + path}};
+        }
+        capacity = header->capacity;
+        slots    = reinterpret_cast<const OpRingSlot*>(reinterpret_cast<OpRingReaderSlot*>(header + 1) + OP_RING_READERS);
+        if(!attach())
+        {
+            munmap(map, size);
+            throw std::system_error{EBUSY, std::system_category(), {"Too many readers of ring: " + path}};
+        }
+        next = header->head.load(std::memory_order_acquire) + 1;
+    }
+    ~OpRingReader()
+    {
+        reader->heartbeat.store(0, std::memory_order_relaxed);
+        munmap(header, size);
+    }
+    OpRingReader(const OpRingReader&) = delete;
+    OpRingReader& operator=(const OpRingReader&) = delete;
+
+    /*! Copies records published since previous call
+     * \param records - array for records
+     * \param max - size of the array
+     * \return Amount of copied records
+     */
+    std::size_t read(OpRecord* records, std::size_t max)
+    {
+        reader->heartbeat.store(op_ring_clock(), std::memory_order_relaxed);
+
+        const uint64_t head{header->head.load(std::memory_order_acquire)};
+        std::size_t    count{0};
+        while(count < max && next <= head)
+        {
+            if(head - next >= capacity) // overwritten already
+            {
+                skipped += head - capacity + 1 - next;
+                next = head - capacity + 1;
+            }
+            const OpRingSlot& slot = slots[next & (capacity - 1)];
+            if(slot.number.load(std::memory_order_acquire) == next)
+            {
+                std::memcpy(&records[count], &slot.record, sizeof(OpRecord));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if(slot.number.load(std::memory_order_relaxed) == next)
+                {
+                    ++count;
+                    ++next;
+                    continue;
+                }
+            }
+            ++skipped; // the writer has overwritten the slot while it was read
+            ++next;
+        }
+        return count;
+    }
+
+    //! Amount of records overwritten before they were read
+    uint64_t lost() const { return skipped; }
+private:
+    //! Takes a free slot or a slot of dead reader
+    bool attach()
+    {
+        OpRingReaderSlot* readers{reinterpret_cast<OpRingReaderSlot*>(header + 1)};
+        const uint64_t    now{op_ring_clock()};
+        for(uint32_t i = 0; i < OP_RING_READERS; ++i)
+        {
+            uint64_t heartbeat{readers[i].heartbeat.load(std::memory_order_relaxed)};
+            if(!op_ring_alive(heartbeat, now, header->timeout_ms) &&
+               readers[i].heartbeat.compare_exchange_strong(heartbeat, now, std::memory_order_relaxed))
+            {
+                reader = &readers[i];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    OpRingHeader*     header{nullptr};
+    OpRingReaderSlot* reader{nullptr};
+    const OpRingSlot* slots{nullptr};
+    std::size_t       size{0};
+    uint64_t          capacity{0};
+    uint64_t          next{1};    // number of record expected by reader
+    uint64_t          skipped{0}; // lost records
+};
+
+} // namespace API
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // OP_RING_H
+//------------------------------------------------------------------------------
@@ -22,6 +22,8 @@
 #ifndef PROCEDURE_H
 #define PROCEDURE_H
 //------------------------------------------------------------------------------
+#include <cstdint>
+
 #include <sys/time.h>
 
 #include "session.h"
@@ -37,8 +39,11 @@ struct Procedure
     ProcedureType reply;
 
     const struct Session* session;
-    const struct timeval* ctimestamp;
-    const struct timeval* rtimestamp;
+    const struct timeval* ctimestamp; //!< Timestamp of call in microseconds, kept for old plugins
+    const struct timeval* rtimestamp; //!< Timestamp of reply in microseconds, kept for old plugins
+
+    int64_t call_time;  //!< Timestamp of call in nanoseconds since Epoch
+    int64_t reply_time; //!< Timestamp of reply in nanoseconds since Epoch
 };
 
 } // namespace API
@@ -64,6 +64,8 @@ struct Session
             uint32_t addr_uint32[2][4];
         } __attribute__((__packed__)) v6;
     } ip;
+
+    uint32_t id; // compact id of application session, unique within nfstrace process
 };
 
 } // namespace API
@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Bounded top of most frequent keys with time decay (Space-Saving)
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef TOP_KEYS_H
+#define TOP_KEYS_H
+//------------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace API
+{
+/*! Approximate top of most frequent keys in bounded memory.
+ * It is Space-Saving algorithm: at most capacity keys are monitored, a new key
+ * replaces the least frequent one and inherits its count as an error. Every key
+ * which has more than total/capacity of weight is monitored, and its count is
+ * overestimated by its error at most.
+ * Weights decay exponentially with half-life by time of events (forward decay):
+ * a weight is scaled up by age of event since a landmark instead of scaling
+ * down all counts, the counts are rescaled rarely when the scale becomes large.
+ * It isn't thread-safe.
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class TopKeys
+{
+public:
+    struct Entry
+    {
+        Key    key;
+        double count; //!< Decayed weight of key, it may be overestimated by error
+        double error; //!< Maximal overestimation of count
+    };
+
+    /*! Creates empty top
+     * \param capacity - maximal amount of monitored keys
+     * \param halfLifeNs - half-life of weights, 0 disables decay
+     */
+    TopKeys(std::size_t capacity, uint64_t halfLifeNs)
+        : _capacity{capacity != 0 ? capacity : 1}
+        , _halfLifeNs{halfLifeNs}
+        , _landmark{0}
+        , _now{0}
+    {
+        _heap.reserve(_capacity);
+        _positions.reserve(_capacity);
+    }
+
+    std::size_t size() const { return _heap.size(); }
+    std::size_t capacity() const { return _capacity; }
+
+    /*! Accounts weight of key
+     * \param key - key of event
+     * \param timeNs - time of event, events may be slightly out of order
+     * \param weight - weight of event
+     */
+    void add(const Key& key, uint64_t timeNs, double weight = 1.0)
+    {
+        if(_heap.empty() && _landmark == 0)
+        {
+            _landmark = timeNs;
+        }
+        _now = std::max(_now, timeNs);
+        double scaled{weight * scale(timeNs)};
+        if(scaled > MaxScale) // keep counts far from overflow of precision
+        {
+            rescale(timeNs);
+            scaled = weight * scale(timeNs);
+        }
+
+        auto i = _positions.find(key);
+        if(i != _positions.end())
+        {
+            _heap[i->second].count += scaled;
+            down(i->second);
+        }
+        else if(_heap.size() < _capacity)
+        {
+            _heap.push_back(Node{key, scaled, 0.0});
+            _positions.emplace(key, _heap.size() - 1);
+            up(_heap.size() - 1);
+        }
+        else // the least frequent key is replaced
+        {
+            Node& least = _heap.front();
+            _positions.erase(least.key);
+            least.key   = key;
+            least.error = least.count;
+            least.count += scaled;
+            _positions.emplace(key, 0);
+            down(0);
+        }
+    }
+
+    /*! Copies the most frequent keys decayed to time of the last event
+     * \param amount - maximal amount of keys
+     * \param entries - replaced by keys in descending order of counts
+     */
+    void top(std::size_t amount, std::vector<Entry>& entries) const
+    {
+        std::vector<const Node*> nodes;
+        nodes.reserve(_heap.size());
+        for(const Node& n : _heap)
+        {
+            nodes.push_back(&n);
+        }
+        amount = std::min(amount, nodes.size());
+        std::partial_sort(nodes.begin(), nodes.begin() + amount, nodes.end(), [](const Node* a, const Node* b) {
+            return a->count > b->count;
+        });
+
+        const double factor{1.0 / scale(_now)};
+        entries.clear();
+        for(std::size_t i = 0; i < amount; ++i)
+        {
+            entries.push_back(Entry{nodes[i]->key, nodes[i]->count * factor, nodes[i]->error * factor});
+        }
+    }
+
+private:
+    static constexpr double MaxScale{4294967296.0}; // 2^32
+
+    struct Node
+    {
+        Key    key;
+        double count; // scaled by landmark
+        double error;
+    };
+
+    double scale(uint64_t timeNs) const
+    {
+        if(_halfLifeNs == 0)
+        {
+            return 1.0;
+        }
+        const double age{timeNs >= _landmark ? double(timeNs - _landmark) : -double(_landmark - timeNs)};
+        return std::exp2(age / double(_halfLifeNs));
+    }
+
+    //! Moves landmark, order of counts is kept
+    void rescale(uint64_t landmark)
+    {
+        const double factor{1.0 / scale(landmark)};
+        for(Node& n : _heap)
+        {
+            n.count *= factor;
+            n.error *= factor;
+        }
+        _landmark = landmark;
+    }
+
+    void swap(std::size_t a, std::size_t b)
+    {
+        std::swap(_heap[a], _heap[b]);
+        _positions[_heap[a].key] = a;
+        _positions[_heap[b].key] = b;
+    }
+
+    void up(std::size_t i)
+    {
+        while(i > 0 && _heap[i].count < _heap[(i - 1) / 2].count)
+        {
+            swap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void down(std::size_t i)
+    {
+        for(;;)
+        {
+            std::size_t least{i};
+            for(std::size_t child = 2 * i + 1; child <= 2 * i + 2 && child < _heap.size(); ++child)
+            {
+                if(_heap[child].count < _heap[least].count)
+                {
+                    least = child;
+                }
+            }
+            if(least == i)
+            {
+                return;
+            }
+            swap(i, least);
+            i = least;
+        }
+    }
+
+    const std::size_t                          _capacity;
+    const uint64_t                             _halfLifeNs;
+    uint64_t                                   _landmark; // time when scale of weights is 1
+    uint64_t                                   _now;      // time of the latest event
+    std::vector<Node>                          _heap;     // min-heap by counts
+    std::unordered_map<Key, std::size_t, Hash> _positions; // indexes of keys in the heap
+};
+
+} // namespace API
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // TOP_KEYS_H
+//------------------------------------------------------------------------------
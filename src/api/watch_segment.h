@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Layout and reader of shared memory segment of watch counters
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef WATCH_SEGMENT_H
+#define WATCH_SEGMENT_H
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace API
+{
+constexpr uint32_t WATCH_SEGMENT_MAGIC{0x4e535457}; //!< "NSTW", it is written after the segment is initialized
+constexpr uint16_t WATCH_SEGMENT_VERSION{1};
+constexpr uint32_t WATCH_SEGMENT_GROUPS{5};       //!< Maximal amount of groups of counters of a protocol
+constexpr uint32_t WATCH_SEGMENT_NAME_SIZE{32};   //!< Size of names of protocols and counters, including '\0'
+constexpr uint32_t WATCH_SEGMENT_PUBLISH_MS{1000}; //!< Time of publishing after which the writer is considered dead
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Counters of the segment are shared by processes");
+
+/*! Header of file mapped by watch plugin (the writer) and viewers.
+ * It is followed by descriptors of protocols, names of counters and counters.
+ * The writer publishes all counters at once, the sequence is odd meanwhile.
+ */
+struct WatchSegmentHeader
+{
+    std::atomic<uint32_t> magic;      //!< WATCH_SEGMENT_MAGIC, 0 while segment is initialized
+    uint16_t              version;    //!< WATCH_SEGMENT_VERSION
+    uint16_t              protocols;  //!< Amount of protocols
+    uint32_t              counters;   //!< Amount of counters of all protocols
+    uint32_t              refresh_ms; //!< Interval of publishing
+    std::atomic<uint64_t> sequence;   //!< Incremented before and after counters are written
+    std::atomic<uint64_t> published;  //!< Time of the last publishing, in nanoseconds since Epoch
+    std::atomic<uint32_t> running;    //!< 0 after the writer has stopped
+    uint32_t              reserved;
+    char                  padding[24];
+};
+
+//! Descriptor of protocol, its counters are numbered in groups
+struct WatchSegmentProtocol
+{
+    char     name[WATCH_SEGMENT_NAME_SIZE];
+    uint32_t first;  //!< Index of the first counter of protocol
+    uint32_t amount; //!< Amount of counters of protocol
+    uint32_t groups; //!< Amount of groups of counters
+    uint32_t group_begins[WATCH_SEGMENT_GROUPS]; //!< Index of first counter of each group within protocol
+};
+
+static_assert(sizeof(WatchSegmentHeader) == 64, "WatchSegmentHeader layout is shared by processes");
+static_assert(sizeof(WatchSegmentProtocol) == 64, "WatchSegmentProtocol layout is shared by processes");
+
+//! Offset of names of counters
+inline std::size_t watch_segment_names(uint32_t protocols)
+{
+    return sizeof(WatchSegmentHeader) + std::size_t{protocols} * sizeof(WatchSegmentProtocol);
+}
+
+//! Offset of counters, they are aligned to cache line
+inline std::size_t watch_segment_counters(uint32_t protocols, uint32_t counters)
+{
+    const std::size_t end{watch_segment_names(protocols) + std::size_t{counters} * WATCH_SEGMENT_NAME_SIZE};
+    return (end + 63) / 64 * 64;
+}
+
+//! Size of file of the segment
+inline std::size_t watch_segment_size(uint32_t protocols, uint32_t counters)
+{
+    return watch_segment_counters(protocols, counters) + std::size_t{counters} * sizeof(uint64_t);
+}
+
+/*! Reader of the segment published by libwatch.so#segment=PATH.
+ * The file is mapped read-only, so any amount of viewers don't affect the writer.
+ */
+class WatchSegmentReader
+{
+public:
+    explicit WatchSegmentReader(const std::string& path)
+    {
+        const int fd{open(path.c_str(), O_RDONLY)};
+        if(fd < 0)
+        {
+            throw std::system_error{errno, std::system_category(), {"Error in opening watch segment: " + path}};
+        }
+        struct stat st;
+        void*       map{MAP_FAILED};
+        if(fstat(fd, &st) == 0 && std::size_t(st.st_size) >= sizeof(WatchSegmentHeader))
+        {
+            size = st.st_size;
+            map  = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if(map == MAP_FAILED)
+        {
+            throw std::system_error{EINVAL, std::system_category(), {"Error in mapping watch segment: " + path}};
+        }
+
+        base   = static_cast<const char*>(map);
+        header = static_cast<const WatchSegmentHeader*>(map);
+        if(header->magic.load(std::memory_order_acquire) != WATCH_SEGMENT_MAGIC ||
+           header->version != WATCH_SEGMENT_VERSION ||
+           watch_segment_size(header->protocols, header->counters) > size)
+        {
+            munmap(map, size);
+            throw std::system_error{EINVAL, std::system_category(), {"Incompatible or uninitialized watch segment: " + path}};
+        }
+        descriptors = reinterpret_cast<const WatchSegmentProtocol*>(header + 1);
+        counters    = reinterpret_cast<const std::atomic<uint64_t>*>(base + watch_segment_counters(header->protocols, header->counters));
+    }
+    ~WatchSegmentReader()
+    {
+        munmap(const_cast<char*>(base), size);
+    }
+    WatchSegmentReader(const WatchSegmentReader&) = delete;
+    WatchSegmentReader& operator=(const WatchSegmentReader&) = delete;
+
+    std::size_t                 protocols() const { return header->protocols; }
+    const WatchSegmentProtocol& protocol(std::size_t i) const { return descriptors[i]; }
+    uint32_t                    refresh_ms() const { return header->refresh_ms; }
+    bool                        running() const { return header->running.load(std::memory_order_relaxed) != 0; }
+
+    //! Name of counter, empty if it has no name
+    const char* counter_name(std::size_t counter) const
+    {
+        return base + watch_segment_names(header->protocols) + counter * WATCH_SEGMENT_NAME_SIZE;
+    }
+
+    /*! Copies counters of all protocols published at once
+     * The writer may die in the middle of publishing, so it is awaited for
+     * WATCH_SEGMENT_PUBLISH_MS at most, or until it has stopped.
+     * \param values - vector for counters
+     * \param stale - set to true if publishing hasn't been finished, values may be inconsistent then
+     * \return Time of publishing, in nanoseconds since Epoch
+     */
+    uint64_t read(std::vector<uint64_t>& values, bool& stale) const
+    {
+        using Clock = std::chrono::steady_clock;
+
+        values.resize(header->counters);
+        stale = false;
+        Clock::time_point deadline{};
+        for(;;)
+        {
+            const uint64_t sequence{header->sequence.load(std::memory_order_acquire)};
+            if(sequence & 1) // the writer is publishing counters
+            {
+                if(deadline == Clock::time_point{})
+                {
+                    deadline = Clock::now() + std::chrono::milliseconds{WATCH_SEGMENT_PUBLISH_MS};
+                }
+                else if(!running() || Clock::now() > deadline)
+                {
+                    stale = true;
+                }
+                if(!stale)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+            }
+            for(std::size_t i = 0; i < values.size(); ++i)
+            {
+                values[i] = counters[i].load(std::memory_order_relaxed);
+            }
+            const uint64_t published{header->published.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(stale || header->sequence.load(std::memory_order_relaxed) == sequence)
+            {
+                return published;
+            }
+        }
+    }
+
+private:
+    const char*                  base{nullptr};
+    const WatchSegmentHeader*    header{nullptr};
+    const WatchSegmentProtocol*  descriptors{nullptr};
+    const std::atomic<uint64_t>* counters{nullptr};
+    std::size_t                  size{0};
+};
+
+} // namespace API
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // WATCH_SEGMENT_H
+//------------------------------------------------------------------------------
@@ -53,7 +53,9 @@ struct Args
         ArgEnum,
         ArgMSize,
         ArgQSize,
+        ArgParsers,
         ArgTrace,
+        ArgRing,
         ArgDropRoot,
         ArgVerbose,
         ArgHelp,
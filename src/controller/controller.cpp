@@ -74,7 +74,7 @@ Controller::Controller(const Parameters& params) try
         if(analysis->isSilent())
             utils::Out::Global::set_level(utils::Out::Level::Silent);
 
-        filtration->add_online_analysis(params, analysis->get_queue());
+        filtration->add_online_analysis(params, analysis->get_queues());
     }
     break;
     case RunningMode::Dumping:
@@ -89,7 +89,7 @@ Controller::Controller(const Parameters& params) try
             utils::Out::Global::set_level(utils::Out::Level::Silent);
 
         filtration->add_offline_analysis(params.input_file(),
-                                         analysis->get_queue());
+                                         analysis->get_queues());
     }
     break;
     case RunningMode::Draining:
@@ -130,7 +130,7 @@ int Controller::run()
                 {
                     glog.reopen();
                 }
-                else if(s.signal_number == SIGWINCH)
+                else if(s.signal_number == SIGWINCH || s.signal_number == SIGUSR1)
                 {
                     analysis->on_unix_signal(s.signal_number);
                 }
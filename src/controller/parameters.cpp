@@ -275,10 +275,26 @@ unsigned short Parameters::queue_capacity() const
     return capacity;
 }
 
+unsigned short Parameters::parser_threads() const
+{
+    const int threads = impl->get(CLI::ArgParsers).to_int();
+    if(threads < 1 || threads > 64)
+    {
+        throw cmdline::CLIError(std::string{"Invalid amount of parser threads: "} + impl->get(CLI::ArgParsers).to_cstr());
+    }
+
+    return threads;
+}
+
 bool Parameters::trace() const
 {
-    // enable tracing if no analysis module was passed
-    return impl->get(CLI::ArgTrace).to_bool() || impl->analysis_modules.empty();
+    // enable tracing if no analysis module or ring was passed
+    return impl->get(CLI::ArgTrace).to_bool() || (impl->analysis_modules.empty() && ring_path().empty());
+}
+
+const std::string Parameters::ring_path() const
+{
+    return impl->get(CLI::ArgRing);
 }
 
 int Parameters::verbose_level() const
@@ -88,7 +88,9 @@ public:
     const std::string           dropuser() const;
     const std::string           log_path() const;
     unsigned short              queue_capacity() const;
+    unsigned short              parser_threads() const;
     bool                        trace() const;
+    const std::string           ring_path() const;
     int                         verbose_level() const;
     const CaptureParams         capture_params() const;
     const DumpingParams         dumping_params() const;
@@ -101,6 +101,7 @@ SignalHandler::SignalHandler(RunningStatus& s)
     ::sigaddset(&mask, SIGCHLD);  // stop sigwait-thread and wait children
     ::sigaddset(&mask, SIGHUP);   // signal for losing terminal
     ::sigaddset(&mask, SIGWINCH); // signal for changing terminal size
+    ::sigaddset(&mask, SIGUSR1);  // signal for printing recent statistics by analyzers
     const int err = ::pthread_sigmask(SIG_BLOCK, &mask, nullptr);
     if(err != 0)
     {
@@ -126,12 +126,14 @@ public:
             {
                 BaseImpl::setMsgLen(length);
                 set_msg_size(header, length);
+                set_descriptor(header);
                 return BaseImpl::read_message(info);
             }
             else if(const CIFSv2::MessageHeader* header = CIFSv2::get_header(collection.data() + sizeof(NetBIOS::MessageHeader)))
             {
                 BaseImpl::setMsgLen(length);
                 set_msg_size(header, length);
+                set_descriptor(header);
                 return BaseImpl::read_message(info);
             }
         }
@@ -139,6 +141,20 @@ public:
     }
 
 private:
+    using Protocol = utils::MessageDescriptor::Protocol;
+
+    inline void set_descriptor(const CIFSv1::MessageHeader* header)
+    {
+        const bool reply{header->isFlag(CIFSv1::Flags::REPLY)};
+        BaseImpl::setDescriptor({Protocol::CIFSv1, reply, 0, 0, static_cast<uint32_t>(header->cmd_code), static_cast<uint64_t>(header->sec.sequenceNumber)});
+    }
+
+    inline void set_descriptor(const CIFSv2::MessageHeader* header)
+    {
+        const bool reply{header->isFlag(CIFSv2::Flags::SERVER_TO_REDIR)};
+        BaseImpl::setDescriptor({Protocol::CIFSv2, reply, 0, 0, static_cast<uint32_t>(header->cmd_code), static_cast<uint64_t>(header->messageId)});
+    }
+
     inline void set_msg_size(const CIFSv1::MessageHeader* header, const size_t length)
     {
         if((header->cmd_code == CIFSv1::Commands::READ) || (header->cmd_code == CIFSv1::Commands::WRITE))
@@ -32,35 +32,24 @@ namespace NST
 namespace filtration
 {
 Dumping::Dumping(pcap_t* const h, const Params& params)
-    : handle{h}
-    , base{params.output_file}
-    , name{params.output_file}
-    , command{params.command}
+    : command{params.command}
     , limit{params.size_limit}
-    , part{0}
     , size{0}
 {
-    open_dumping_file(name);
+    bool nano{false};
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+    nano = pcap_get_tstamp_precision(h) == PCAP_TSTAMP_PRECISION_NANO;
+#endif
+    // the command is executed by writer thread for every written file
+    writer.reset(new pcap::DumpWriter{params.output_file, pcap_datalink(h), pcap_snapshot(h), nano, limit != 0,
+                                      [this](const std::string& file) { exec_command(file); }});
 }
 Dumping::~Dumping()
 {
-    close_dumping_file();
+    writer.reset(); // write the rest of packets and close files
 }
 
-void Dumping::open_dumping_file(const std::string& file_path)
-{
-    const char* path{file_path.c_str()};
-    LOG("Dumping packets to file:%s", path);
-    dumper.reset(new pcap::PacketDumper{handle, path});
-}
-
-void Dumping::close_dumping_file()
-{
-    dumper.reset(); // close current dumper
-    exec_command();
-}
-
-void Dumping::exec_command() const
+void Dumping::exec_command(const std::string& name) const
 {
     if(command.empty()) return;
 
@@ -29,7 +29,8 @@
 #include <sys/time.h>
 
 #include "filtration/packet.h"
-#include "filtration/pcap/packet_dumper.h"
+#include "filtration/pcap/dump_writer.h"
+#include "utils/filtered_data.h"
 #include "utils/log.h"
 #include "utils/sessions.h"
 //------------------------------------------------------------------------------
@@ -121,6 +122,14 @@ public:
         {
         }
 
+        inline void set_msg_len(const uint32_t /*len*/)
+        {
+        }
+
+        inline void set_descriptor(const utils::MessageDescriptor& /*descriptor*/)
+        {
+        }
+
         inline void complete(const PacketInfo& /*info*/)
         {
             assert(dumper);
@@ -151,44 +160,32 @@ public:
     Dumping(const Dumping&) = delete;
     Dumping& operator=(const Dumping&) = delete;
 
+    //! Packets are copied to chunks, files are written and rotated by own thread of writer
     inline void dump(const pcap_pkthdr* header, const u_char* packet)
     {
         if(limit)
         {
-            if((size + sizeof(pcap_pkthdr) + header->caplen) > limit)
+            const std::size_t length{pcap::DumpWriter::record_size(header)};
+            if((size + length) > limit)
             {
-                close_dumping_file();
-
-                ++part;
-                char suffix[64];
-                sprintf(suffix, "-%u", part);
-                name = base + /*'-' + std::to_string(part)*/ suffix;
-                size = 0;
-                open_dumping_file(name);
-
                 // new part of dump file shouldn't have ./pcap header
-                dumper->truncate_all_pcap_data_and_header();
+                writer->rotate();
+                size = 0;
             }
-            size += sizeof(pcap_pkthdr) + header->caplen;
+            size += length;
         }
 
-        dumper->dump(header, packet);
+        writer->dump(header, packet);
     }
 
 private:
-    void open_dumping_file(const std::string& file_path);
-    void close_dumping_file();
-    void exec_command() const;
-
-    std::unique_ptr<pcap::PacketDumper> dumper;
+    void exec_command(const std::string& name) const;
 
-    pcap_t* const     handle;
-    const std::string base;
-    std::string       name;
     const std::string command;
     const uint32_t    limit;
-    uint32_t          part;
     uint32_t          size;
+
+    std::unique_ptr<pcap::DumpWriter> writer;
 };
 
 std::ostream& operator<<(std::ostream& out, const Dumping::Params& params);
@@ -37,9 +37,9 @@ namespace filtration
 using CaptureReader = NST::filtration::pcap::CaptureReader;
 using FileReader    = NST::filtration::pcap::FileReader;
 
-using Parameters        = NST::controller::Parameters;
-using RunningStatus     = NST::controller::RunningStatus;
-using FilteredDataQueue = NST::utils::FilteredDataQueue;
+using Parameters         = NST::controller::Parameters;
+using RunningStatus      = NST::controller::RunningStatus;
+using FilteredDataQueues = NST::utils::FilteredDataQueues;
 
 namespace // unnamed
 {
@@ -159,26 +159,26 @@ void FiltrationManager::add_offline_dumping(const Parameters& params)
     threads.emplace_back(create_thread(reader, writer, status));
 }
 
-// capture from network interface and pass to queue - OnlineAnalysis(Profiling)
-void FiltrationManager::add_online_analysis(const Parameters&  params,
-                                            FilteredDataQueue& queue)
+// capture from network interface and pass to queues - OnlineAnalysis(Profiling)
+void FiltrationManager::add_online_analysis(const Parameters&   params,
+                                            FilteredDataQueues& queues)
 {
     std::unique_ptr<CaptureReader> reader{create_capture_reader(params)};
-    std::unique_ptr<Queueing>      writer{new Queueing{queue}};
+    std::unique_ptr<Queueing>      writer{new Queueing{queues}};
 
     threads.emplace_back(create_thread(reader, writer, status));
 }
 
-// read from file and pass to queue - OfflineAnalysis(Analysis)
-void FiltrationManager::add_offline_analysis(const std::string& ifile,
-                                             FilteredDataQueue& queue)
+// read from file and pass to queues - OfflineAnalysis(Analysis)
+void FiltrationManager::add_offline_analysis(const std::string&  ifile,
+                                             FilteredDataQueues& queues)
 {
     std::unique_ptr<FileReader> reader{new FileReader{ifile}};
     if(utils::Out message{}) // print parameters to user
     {
         message << *reader;
     }
-    std::unique_ptr<Queueing> writer{new Queueing{queue}};
+    std::unique_ptr<Queueing> writer{new Queueing{queues}};
 
     threads.emplace_back(create_thread(reader, writer, status));
 }
@@ -37,7 +37,7 @@ class FiltrationManager
 {
     using Parameters        = NST::controller::Parameters;
     using RunningStatus     = NST::controller::RunningStatus;
-    using FilteredDataQueue = NST::utils::FilteredDataQueue;
+    using FilteredDataQueues = NST::utils::FilteredDataQueues;
 
 public:
     FiltrationManager(RunningStatus&);
@@ -45,10 +45,10 @@ public:
     FiltrationManager(const FiltrationManager&) = delete;
     FiltrationManager& operator=(const FiltrationManager&) = delete;
 
-    void add_online_dumping(const Parameters& params);                             // dump to file
-    void add_offline_dumping(const Parameters& params);                            // dump to file from input file
-    void add_online_analysis(const Parameters& params, FilteredDataQueue& queue);  // capture to queue
-    void add_offline_analysis(const std::string& ifile, FilteredDataQueue& queue); // read file to queue
+    void add_online_dumping(const Parameters& params);                               // dump to file
+    void add_offline_dumping(const Parameters& params);                              // dump to file from input file
+    void add_online_analysis(const Parameters& params, FilteredDataQueues& queues);  // capture to queues
+    void add_offline_analysis(const std::string& ifile, FilteredDataQueues& queues); // read file to queues
 
     void start();
     void stop();
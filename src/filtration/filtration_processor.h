@@ -38,6 +38,7 @@
 #include "protocols/nfs3/nfs3_utils.h"
 #include "protocols/nfs4/nfs4_utils.h"
 #include "protocols/rpc/rpc_header.h"
+#include "utils/filtered_data.h"
 #include "utils/log.h"
 #include "utils/out.h"
 #include "utils/profiler.h"
@@ -77,8 +78,11 @@ public:
     void collect(PacketInfo& info)
     {
         // TODO: this code must be generalized with RPCFiltrator class
-        uint32_t hdr_len{0};
-        auto     msg = reinterpret_cast<const MessageHeader* const>(info.data);
+        using Protocol = utils::MessageDescriptor::Protocol;
+
+        uint32_t                 hdr_len{0};
+        utils::MessageDescriptor descriptor;
+        auto                     msg = reinterpret_cast<const MessageHeader* const>(info.data);
         switch(msg->type())
         {
         case MsgType::CALL:
@@ -108,6 +112,7 @@ public:
                 {
                     return;
                 }
+                descriptor = {Protocol::NFS, false, call->prog(), call->vers(), call->proc(), call->xid()};
             }
             else
             {
@@ -128,6 +133,7 @@ public:
                 }
                 else
                     hdr_len = info.dlen;
+                descriptor = {Protocol::NFS, true, 0, 0, 0, reply->xid()};
             }
             else // isn't RPC reply, stream is corrupt
             {
@@ -143,6 +149,8 @@ public:
 
         collection.push(info, hdr_len);
 
+        collection.set_msg_len(info.dlen);
+        collection.set_descriptor(descriptor);
         collection.complete(info);
     }
 
@@ -410,7 +418,8 @@ public:
         , ipv6_udp_sessions{writer.get()}
     {
         // check datalink layer
-        datalink = reader->datalink();
+        datalink        = reader->datalink();
+        timestamp_scale = reader->timestamp_scale();
         if(datalink != DLT_EN10MB)
         {
             throw std::runtime_error(std::string("Unsupported Data Link Layer: ") + Reader::datalink_description(datalink));
@@ -441,7 +450,7 @@ public:
         PROF; // Calc how much time was spent in this func
         auto processor = reinterpret_cast<FiltrationProcessor*>(user);
 
-        PacketInfo info(pkthdr, packet, processor->datalink);
+        PacketInfo info(pkthdr, packet, processor->datalink, processor->timestamp_scale);
 
         if(info.tcp)
         {
@@ -489,7 +498,8 @@ private:
     SessionsHash<IPv6TCPMapper, TCPSession<Filtrator>, Writer> ipv6_tcp_sessions;
     SessionsHash<IPv6UDPMapper, UDPSession<Writer>, Writer>    ipv6_udp_sessions;
 
-    int datalink;
+    int     datalink;
+    int64_t timestamp_scale; // nanoseconds in unit of pcap_pkthdr::ts.tv_usec
 };
 
 } // namespace filtration
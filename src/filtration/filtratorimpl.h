@@ -24,6 +24,7 @@
 #define IFILTRATOR_H
 //------------------------------------------------------------------------------
 #include "filtration/packet.h"
+#include "utils/filtered_data.h"
 #include "utils/log.h"
 //------------------------------------------------------------------------------
 namespace NST
@@ -38,7 +39,8 @@ namespace filtration
 template <typename Filtrator, typename Writer>
 class FiltratorImpl
 {
-    size_t msg_len;                                 //!< length of current message
+    size_t msg_len;                                 //!< length of unread part of current message
+    size_t msg_size;                                //!< length of current message
     size_t to_be_copied;                            //!<  length of readable piece of message. Initially msg_len or 0 in case of unknown msg
     using Collection = typename Writer::Collection; //!< Type of collection
     Collection collection;                          //!< storage for collection packet data
@@ -66,6 +68,7 @@ public:
     inline void reset()
     {
         msg_len      = 0;
+        msg_size     = 0;
         to_be_copied = 0;
         collection.reset();
     }
@@ -179,6 +182,7 @@ public:
                         to_be_copied = 0;
 
                         collection.skip_first(Filtrator::lengthOfFirstSkipedPart());
+                        collection.set_msg_len(msg_size - Filtrator::lengthOfFirstSkipedPart());
                         collection.complete(info); // push complete message to queue
                     }
                 }
@@ -239,7 +243,8 @@ public:
 protected:
     inline void setMsgLen(size_t value)
     {
-        msg_len = value;
+        msg_len  = value;
+        msg_size = value;
     }
 
     inline void setToBeCopied(size_t value)
@@ -247,6 +252,12 @@ protected:
         to_be_copied = value;
     }
 
+    //! Passes description of validated header of current message to parsers
+    inline void setDescriptor(const utils::MessageDescriptor& descriptor)
+    {
+        collection.set_descriptor(descriptor);
+    }
+
     inline void setWriterImpl(utils::NetworkSession* session_ptr, Writer* w, uint32_t)
     {
         assert(w);
@@ -309,6 +320,7 @@ protected:
         // Next find message call will finding next message
         {
             collection.skip_first(filtrator->lengthOfFirstSkipedPart());
+            collection.set_msg_len(msg_size - filtrator->lengthOfFirstSkipedPart());
             collection.complete(info);
         }
         return true;
@@ -68,8 +68,10 @@ struct PacketInfo
 
     inline PacketInfo(const pcap_pkthdr* h,
                       const uint8_t*     p,
-                      const uint32_t     datalink)
+                      const uint32_t     datalink,
+                      const int64_t      tstamp_scale = 1000) // nanoseconds in unit of header->ts.tv_usec
         : header{h}
+        , timestamp{int64_t(h->ts.tv_sec) * 1000000000 + int64_t(h->ts.tv_usec) * tstamp_scale}
         , packet{p}
         , eth{nullptr}
         , ipv4{nullptr}
@@ -295,7 +297,8 @@ struct PacketInfo
 
     // libpcap structures
     const pcap_pkthdr* header;
-    const uint8_t*     packet; // real length is in header->caplen
+    int64_t            timestamp; // header->ts in nanoseconds since Epoch
+    const uint8_t*     packet;    // real length is in header->caplen
 
     // all pointers point to packet array
 
@@ -349,8 +352,9 @@ struct Packet : public PacketInfo
         *header = *info.header;                           // copy packet header
         memcpy(packet, info.packet, info.header->caplen); // copy packet data
 
-        fragment->header = header;
-        fragment->packet = packet;
+        fragment->header    = header;
+        fragment->timestamp = info.timestamp;
+        fragment->packet    = packet;
 
         // fix pointers from PacketInfo to point to owned copy of packet data
         fragment->eth  = info.eth ? (const ethernet::EthernetHeader*)(packet + (((const uint8_t*)info.eth) - info.packet)) : nullptr;
@@ -22,6 +22,7 @@
 #ifndef BASE_READER_H
 #define BASE_READER_H
 //------------------------------------------------------------------------------
+#include <cstdint>
 #include <ostream>
 #include <string>
 
@@ -69,6 +70,16 @@ public:
     inline void               break_loop() { pcap_breakloop(handle); }
     inline pcap_t*&           get_handle() { return handle; }
     inline int                datalink() const { return pcap_datalink(handle); }
+
+    // Nanoseconds in unit of pcap_pkthdr::ts.tv_usec of captured packets
+    inline int64_t timestamp_scale() const
+    {
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+        if(pcap_get_tstamp_precision(handle) == PCAP_TSTAMP_PRECISION_NANO) return 1;
+#endif
+        return 1000;
+    }
+
     inline static const char* datalink_name(const int dlt) { return pcap_datalink_val_to_name(dlt); }
     inline static const char* datalink_description(const int dlt) { return pcap_datalink_val_to_description(dlt); }
     virtual void print_statistic(std::ostream& out) const = 0;
@@ -60,6 +60,11 @@ CaptureReader::CaptureReader(const Params& params)
         throw PcapError("pcap_set_buffer_size", pcap_statustostr(status));
     }
 
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+    // not all devices support it, microseconds are used then
+    pcap_set_tstamp_precision(handle, PCAP_TSTAMP_PRECISION_NANO);
+#endif
+
     if(int status{pcap_activate(handle)})
     {
         throw PcapError("pcap_activate", pcap_statustostr(status));
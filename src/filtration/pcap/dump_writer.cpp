@@ -0,0 +1,316 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Writing pcap frames to files by own thread.
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cerrno>
+#include <cstdio>
+#include <chrono>
+#include <new>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "filtration/pcap/dump_writer.h"
+#include "utils/log.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace filtration
+{
+namespace pcap
+{
+namespace
+{
+//! Header of pcap file
+struct FileHeader
+{
+    uint32_t magic;
+    uint16_t version_major;
+    uint16_t version_minor;
+    int32_t  thiszone;
+    uint32_t sigfigs;
+    uint32_t snaplen;
+    uint32_t linktype;
+};
+
+constexpr uint32_t magic_micro{0xa1b2c3d4};
+constexpr uint32_t magic_nano{0xa1b23c4d};
+
+//! Writes whole buffer, O_DIRECT is turned off if file system rejects it
+void write_all(int fd, bool& direct, const uint8_t* data, std::size_t size)
+{
+    while(size != 0)
+    {
+        const ssize_t written{::write(fd, data, size)};
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            if(errno == EINVAL && direct) // some file systems open files with O_DIRECT but don't write them
+            {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT);
+                direct = false;
+                continue;
+            }
+            throw std::system_error{errno, std::system_category(), "write() to dump file"};
+        }
+        data += written;
+        size -= written;
+    }
+}
+} // unnamed namespace
+
+DumpWriter::DumpWriter(const std::string& path, int linktype, int snaplen, bool nano, bool r, Closed c)
+    : base{path}
+    , rotation{r}
+    , closed{std::move(c)}
+    , ring{ring_size}
+    , running{ATOMIC_FLAG_INIT}
+{
+    open(file, 0, file_name(0)); // errors of the first file are reported to user at once
+    LOG("Dumping packets to file:%s", file.path.c_str());
+
+    const FileHeader header{nano ? magic_nano : magic_micro, 2, 4, 0, 0,
+                            static_cast<uint32_t>(snaplen), static_cast<uint32_t>(linktype)};
+    append(&header, sizeof(header));
+
+    running.test_and_set();
+    writer = std::thread(&DumpWriter::thread, this);
+}
+
+DumpWriter::~DumpWriter()
+{
+    if(current != nullptr && current->size != 0 && !failed)
+    {
+        ring.push(); // the last chunk
+    }
+    running.clear();
+    writer.join();
+    if(failed)
+    {
+        try
+        {
+            std::rethrow_exception(error);
+        }
+        catch(std::exception& e)
+        {
+            LOG("Dumping packets failed: %s", e.what());
+        }
+    }
+    LOG("Dumping packets waited for disk %lu times", static_cast<unsigned long>(waits));
+}
+
+void DumpWriter::rotate()
+{
+    if(current != nullptr && current->size != 0)
+    {
+        submit();
+    }
+    ++part;
+    if(current != nullptr) // empty chunk is acquired already
+    {
+        current->part = part;
+    }
+}
+
+std::string DumpWriter::file_name(uint32_t n) const
+{
+    return n == 0 ? base : base + '-' + std::to_string(n);
+}
+
+//! Gets free chunk, capture thread waits only if all chunks are waiting for disk
+void DumpWriter::acquire()
+{
+    Chunk* chunk{ring.slot()};
+    if(chunk == nullptr)
+    {
+        ++waits;
+        do
+        {
+            if(failed)
+            {
+                std::rethrow_exception(error);
+            }
+            std::this_thread::yield();
+            chunk = ring.slot();
+        } while(chunk == nullptr);
+    }
+    if(!chunk->data)
+    {
+        void* memory{nullptr};
+        if(posix_memalign(&memory, alignment, chunk_size) != 0)
+        {
+            throw std::bad_alloc{};
+        }
+        chunk->data.reset(static_cast<uint8_t*>(memory));
+    }
+    chunk->size = 0;
+    chunk->part = part;
+    current     = chunk;
+}
+
+void DumpWriter::submit()
+{
+    if(failed)
+    {
+        std::rethrow_exception(error);
+    }
+    ring.push();
+    current = nullptr;
+}
+
+void DumpWriter::thread()
+{
+    try
+    {
+        if(rotation)
+        {
+            open(spare, 1, file_name(1) + ".tmp");
+        }
+        while(running.test_and_set())
+        {
+            if(!write_chunks())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        write_chunks(); // flush the ring
+        close(file);
+        discard(spare);
+    }
+    catch(...)
+    {
+        error = std::current_exception();
+        failed = true; // capture thread doesn't wait for chunks anymore
+    }
+}
+
+//! Writes all passed chunks, returns false if there were none
+bool DumpWriter::write_chunks()
+{
+    bool written{false};
+    while(const Chunk* chunk = ring.front())
+    {
+        if(chunk->part != file.part) // the file is rotated
+        {
+            close(file);
+            if(spare.fd >= 0 && spare.part == chunk->part)
+            {
+                // file of the same name is replaced only when rotation reaches it
+                std::swap(file, spare);
+                const std::string path{file_name(file.part)};
+                if(rename(file.path.c_str(), path.c_str()) != 0)
+                {
+                    throw std::system_error{errno, std::system_category(), "rename() of dump file " + file.path};
+                }
+                file.path = path;
+            }
+            else
+            {
+                open(file, chunk->part, file_name(chunk->part));
+            }
+            LOG("Dumping packets to file:%s", file.path.c_str());
+            if(rotation)
+            {
+                open(spare, chunk->part + 1, file_name(chunk->part + 1) + ".tmp");
+            }
+        }
+        write(file, *chunk);
+        ring.pop();
+        written = true;
+    }
+    return written;
+}
+
+void DumpWriter::write(File& f, const Chunk& chunk)
+{
+    std::size_t size{chunk.size};
+    if(f.direct && size % alignment != 0) // the last chunk of file, its tail is written through page cache
+    {
+        const std::size_t aligned{size - size % alignment};
+        write_all(f.fd, f.direct, chunk.data.get(), aligned);
+        fcntl(f.fd, F_SETFL, fcntl(f.fd, F_GETFL) & ~O_DIRECT);
+        f.direct = false;
+        write_all(f.fd, f.direct, chunk.data.get() + aligned, size - aligned);
+        return;
+    }
+    write_all(f.fd, f.direct, chunk.data.get(), size);
+}
+
+void DumpWriter::open(File& f, uint32_t n, const std::string& path)
+{
+    f.part = n;
+    f.path = path;
+    if(f.path == "-") // stdout, as in libpcap
+    {
+        f.fd     = STDOUT_FILENO;
+        f.direct = false;
+        return;
+    }
+    f.direct = true;
+    f.fd     = ::open(f.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0666);
+    if(f.fd < 0 && errno == EINVAL) // file system doesn't support O_DIRECT
+    {
+        f.direct = false;
+        f.fd     = ::open(f.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    }
+    if(f.fd < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "open() of dump file " + f.path};
+    }
+}
+
+void DumpWriter::close(File& f)
+{
+    if(f.fd < 0)
+    {
+        return;
+    }
+    if(f.fd != STDOUT_FILENO)
+    {
+        ::close(f.fd);
+    }
+    f.fd = -1;
+    if(closed)
+    {
+        closed(f.path);
+    }
+}
+
+//! Removes the next file of rotation which isn't used
+void DumpWriter::discard(File& f)
+{
+    if(f.fd < 0)
+    {
+        return;
+    }
+    ::close(f.fd);
+    unlink(f.path.c_str());
+    f.fd = -1;
+}
+
+} // namespace pcap
+} // namespace filtration
+} // namespace NST
+//------------------------------------------------------------------------------
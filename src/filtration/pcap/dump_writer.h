@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Writing pcap frames to files by own thread.
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef DUMP_WRITER_H
+#define DUMP_WRITER_H
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <pcap/pcap.h>
+
+#include "utils/spsc_ring.h"
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace filtration
+{
+namespace pcap
+{
+/*! Writer of packets to pcap files by own thread.
+ * Capture thread copies packets into large page-aligned chunks and passes
+ * full chunks to writer thread through a ring, so disk latency and rotation
+ * of files don't stall capture until all chunks are waiting for disk.
+ * Files are written with O_DIRECT if file system supports it: all chunks but
+ * the last one of a file are full, so their offsets and lengths are aligned.
+ * If files are rotated, writer thread opens the next file in advance under
+ * temporary name, it is renamed only when packets are written to it.
+ */
+class DumpWriter
+{
+public:
+    static constexpr std::size_t chunk_size{4 * 1024 * 1024}; //!< Multiple of alignment
+    static constexpr std::size_t ring_size{8};                 //!< Chunks in flight to disk
+    static constexpr std::size_t alignment{4096};              //!< Of memory, offsets and lengths of direct writes
+
+    //! Header of packet in pcap file
+    struct Record
+    {
+        uint32_t ts_sec;
+        uint32_t ts_frac; //!< Microseconds or nanoseconds
+        uint32_t caplen;
+        uint32_t len;
+    };
+
+    //! Called by writer thread after a file is written and closed
+    using Closed = std::function<void(const std::string& path)>;
+
+    /*! Opens the first file and starts writer thread
+     * \param path - the first file, '-' is stdout; next files of rotation get suffix -N
+     * \param linktype - DLT of packets
+     * \param snaplen - max length of packets
+     * \param nano - timestamps of packets are in nanoseconds
+     * \param rotation - files are rotated, so the next one is opened in advance
+     * \param closed - handler of closed files
+     */
+    DumpWriter(const std::string& path, int linktype, int snaplen, bool nano, bool rotation, Closed closed);
+    ~DumpWriter();
+    DumpWriter(const DumpWriter&) = delete;
+    DumpWriter& operator=(const DumpWriter&) = delete;
+
+    //! Size of packet in file
+    static inline std::size_t record_size(const pcap_pkthdr* header)
+    {
+        return sizeof(Record) + header->caplen;
+    }
+
+    inline void dump(const pcap_pkthdr* header, const u_char* packet)
+    {
+        const Record record{static_cast<uint32_t>(header->ts.tv_sec),
+                            static_cast<uint32_t>(header->ts.tv_usec),
+                            header->caplen,
+                            header->len};
+        append(&record, sizeof(record));
+        append(packet, header->caplen);
+    }
+
+    //! Following packets are written to the next file, it has no pcap header
+    void rotate();
+
+    //! Name of file of rotation
+    std::string file_name(uint32_t part) const;
+
+private:
+    struct Free
+    {
+        void operator()(uint8_t* memory) const { std::free(memory); }
+    };
+
+    //! Chunk of file, it is filled by capture thread and written by writer thread
+    struct Chunk
+    {
+        std::unique_ptr<uint8_t, Free> data;
+        std::size_t                    size{0};
+        uint32_t                       part{0}; //!< Number of file
+    };
+
+    struct File
+    {
+        int         fd{-1};
+        bool        direct{false}; // opened with O_DIRECT
+        uint32_t    part{0};
+        std::string path;
+    };
+
+    //! Copies data into chunks, a packet may be split between chunks
+    inline void append(const void* data, std::size_t length)
+    {
+        const uint8_t* bytes{static_cast<const uint8_t*>(data)};
+        while(length != 0)
+        {
+            if(current == nullptr)
+            {
+                acquire();
+            }
+            const std::size_t left{chunk_size - current->size};
+            const std::size_t amount{length < left ? length : left};
+            std::memcpy(current->data.get() + current->size, bytes, amount);
+            current->size += amount;
+            bytes += amount;
+            length -= amount;
+            if(current->size == chunk_size)
+            {
+                submit();
+            }
+        }
+    }
+
+    void acquire();
+    void submit();
+    void thread();
+    bool write_chunks();
+    void write(File& file, const Chunk& chunk);
+    void open(File& file, uint32_t part, const std::string& path);
+    void close(File& file);
+    void discard(File& file);
+
+    const std::string base;
+    const bool        rotation;
+    const Closed      closed;
+
+    // used by capture thread
+    Chunk*   current{nullptr};
+    uint32_t part{0};
+    uint64_t waits{0}; // times capture thread waited for free chunk
+
+    // used by writer thread
+    File file;
+    File spare; // the next file of rotation, it is opened in advance under temporary name
+
+    utils::SPSCRing<Chunk> ring;
+    std::atomic<bool>      failed{false};
+    std::exception_ptr     error; // set by writer thread before failed
+    std::atomic_flag       running;
+    std::thread            writer;
+};
+
+} // namespace pcap
+} // namespace filtration
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // DUMP_WRITER_H
+//------------------------------------------------------------------------------
@@ -33,8 +33,13 @@ FileReader::FileReader(const std::string& file)
 {
     char errbuf[PCAP_ERRBUF_SIZE];
 
-    // open pcap device for reading from file in file system
+    // open pcap device for reading from file in file system,
+    // timestamps of microsecond captures are scaled by libpcap
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+    handle = pcap_open_offline_with_tstamp_precision(file.c_str(), PCAP_TSTAMP_PRECISION_NANO, errbuf);
+#else
     handle = pcap_open_offline(file.c_str(), errbuf);
+#endif
     if(!handle)
     {
         throw PcapError("pcap_open_offline", errbuf);
@@ -22,6 +22,7 @@
 #ifndef QUEUING_H
 #define QUEUING_H
 //------------------------------------------------------------------------------
+#include <cstdint>
 #include <string>
 
 #include "utils/filtered_data.h"
@@ -34,8 +35,9 @@ namespace filtration
 {
 class Queueing
 {
-    using Queue = NST::utils::FilteredDataQueue;
-    using Data  = NST::utils::FilteredData;
+    using Queue  = NST::utils::FilteredDataQueue;
+    using Queues = NST::utils::FilteredDataQueues;
+    using Data   = NST::utils::FilteredData;
 
 public:
     class Collection
@@ -48,7 +50,7 @@ public:
         {
         }
         inline Collection(Queueing* q, utils::NetworkSession* s) noexcept
-            : queue{&q->queue}
+            : queue{q->select(s)}
             , ptr{nullptr}
             , session{s}
         {
@@ -66,7 +68,7 @@ public:
 
         inline void set(Queueing& q, utils::NetworkSession* s)
         {
-            queue   = &q.queue;
+            queue   = q.select(s);
             session = s;
         }
 
@@ -131,6 +133,20 @@ public:
             ptr->data += len;
         }
 
+        inline void set_msg_len(const uint32_t len)
+        {
+            assert(nullptr != ptr);
+
+            ptr->msg_len = len;
+        }
+
+        inline void set_descriptor(const utils::MessageDescriptor& descriptor)
+        {
+            assert(nullptr != ptr);
+
+            ptr->descriptor = descriptor;
+        }
+
         void complete(const PacketInfo& info)
         {
             assert(ptr);
@@ -139,7 +155,7 @@ public:
             assert(info.direction != utils::Session::Direction::Unknown);
 
             ptr->session   = session;
-            ptr->timestamp = info.header->ts;
+            ptr->timestamp = info.timestamp;
             ptr->direction = info.direction;
 
             queue->push(ptr);
@@ -156,8 +172,8 @@ public:
         utils::NetworkSession* session;
     };
 
-    Queueing(Queue& q)
-        : queue(q)
+    Queueing(Queues& q)
+        : queues(q)
     {
     }
     ~Queueing()
@@ -168,7 +184,19 @@ public:
     Queueing& operator=(const Queueing&) = delete;
 
 private:
-    Queue& queue;
+    //! Messages of a session are passed to the same parser thread for matching calls with replies
+    inline Queue* select(const utils::NetworkSession* s) const
+    {
+        if(queues.size() == 1)
+        {
+            return queues.front().get();
+        }
+        // Fibonacci hashing of address of session
+        const uint64_t hash{(reinterpret_cast<std::uintptr_t>(s) * 0x9E3779B97F4A7C15ULL) >> 32};
+        return queues[hash % queues.size()].get();
+    }
+
+    Queues& queues;
 };
 
 } // namespace filtration
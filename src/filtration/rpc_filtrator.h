@@ -145,11 +145,13 @@ public:
                         }
                         BaseImpl::setToBeCopied(len);
                     }
+                    set_descriptor(call);
                     //TRACE("%p| MATCH RPC Call  xid:%u len: %u procedure: %u", this, call->xid(), msg_len, call->proc());
                 }
                 else if(protocols::NFS4::Validator::check(call))
                 {
                     BaseImpl::setToBeCopied(len);
+                    set_descriptor(call);
                 }
                 else
                 {
@@ -181,6 +183,7 @@ public:
                 {
                     BaseImpl::setToBeCopied(len); // length of current RPC message
                 }
+                BaseImpl::setDescriptor({Protocol::NFS, true, 0, 0, 0, reply->xid()});
                 //TRACE("%p| MATCH RPC Reply xid:%u len: %u", this, reply->xid(), msg_len);
                 return true;
             }
@@ -203,6 +206,13 @@ public:
     }
 
 private:
+    using Protocol = utils::MessageDescriptor::Protocol;
+
+    inline void set_descriptor(const CallHeader* const call)
+    {
+        BaseImpl::setDescriptor({Protocol::NFS, false, call->prog(), call->vers(), call->proc(), call->xid()});
+    }
+
     size_t     nfs3_rw_hdr_max{512}; // limit for NFSv3 to truncate WRITE call and READ reply messages
     MessageSet nfs3_read_match;
 };
@@ -60,6 +60,57 @@ bool MessageHeader::isFlag(const Flags flag) const
     return static_cast<const uint8_t>(flag) & static_cast<const uint8_t>(flags);
 }
 
+SMBv1Commands NST::protocols::CIFSv1::api_command(Commands cmd_code)
+{
+    // Commands and SMBv1Commands list the same commands in the same order
+    static const struct Table
+    {
+        Table()
+        {
+            // clang-format off
+            static const Commands codes[] =
+            {
+                Commands::CREATE_DIRECTORY,       Commands::DELETE_DIRECTORY,       Commands::OPEN,
+                Commands::CREATE,                 Commands::CLOSE,                  Commands::FLUSH,
+                Commands::DELETE,                 Commands::RENAME,                 Commands::QUERY_INFORMATION,
+                Commands::SET_INFORMATION,        Commands::READ,                   Commands::WRITE,
+                Commands::LOCK_BYTE_RANGE,        Commands::UNLOCK_BYTE_RANGE,      Commands::CREATE_TEMPORARY,
+                Commands::CREATE_NEW,             Commands::CHECK_DIRECTORY,        Commands::PROCESS_EXIT,
+                Commands::SEEK,                   Commands::LOCK_AND_READ,          Commands::WRITE_AND_UNLOCK,
+                Commands::READ_RAW,               Commands::READ_MPX,               Commands::READ_MPX_SECONDARY,
+                Commands::WRITE_RAW,              Commands::WRITE_MPX,              Commands::WRITE_MPX_SECONDARY,
+                Commands::WRITE_COMPLETE,         Commands::QUERY_SERVER,           Commands::SET_INFORMATION2,
+                Commands::QUERY_INFORMATION2,     Commands::LOCKING_ANDX,           Commands::TRANSACTION,
+                Commands::TRANSACTION_SECONDARY,  Commands::IOCTL,                  Commands::IOCTL_SECONDARY,
+                Commands::COPY,                   Commands::MOVE,                   Commands::ECHO,
+                Commands::WRITE_AND_CLOSE,        Commands::OPEN_ANDX,              Commands::READ_ANDX,
+                Commands::WRITE_ANDX,             Commands::NEW_FILE_SIZE,          Commands::CLOSE_AND_TREE_DISC,
+                Commands::TRANSACTION2,           Commands::TRANSACTION2_SECONDARY, Commands::FIND_CLOSE2,
+                Commands::FIND_NOTIFY_CLOSE,      Commands::TREE_CONNECT,           Commands::TREE_DISCONNECT,
+                Commands::NEGOTIATE,              Commands::SESSION_SETUP_ANDX,     Commands::LOGOFF_ANDX,
+                Commands::TREE_CONNECT_ANDX,      Commands::SECURITY_PACKAGE_ANDX,  Commands::QUERY_INFORMATION_DISK,
+                Commands::SEARCH,                 Commands::FIND,                   Commands::FIND_UNIQUE,
+                Commands::FIND_CLOSE,             Commands::NT_TRANSACT,            Commands::NT_TRANSACT_SECONDARY,
+                Commands::NT_CREATE_ANDX,         Commands::NT_CANCEL,              Commands::NT_RENAME,
+                Commands::OPEN_PRINT_FILE,        Commands::WRITE_PRINT_FILE,       Commands::CLOSE_PRINT_FILE,
+                Commands::GET_PRINT_QUEUE,        Commands::READ_BULK,              Commands::WRITE_BULK,
+                Commands::WRITE_BULK_DATA,        Commands::INVALID,                Commands::NO_ANDX_COMMAND
+            };
+            // clang-format on
+            static_assert(sizeof(codes) / sizeof(codes[0]) == static_cast<size_t>(SMBv1Commands::CMD_COUNT), "Commands and SMBv1Commands mismatch");
+
+            for(auto& c : commands) c = SMBv1Commands::CMD_COUNT;
+            for(size_t i = 0; i < sizeof(codes) / sizeof(codes[0]); ++i)
+            {
+                commands[static_cast<uint8_t>(codes[i])] = static_cast<SMBv1Commands>(i);
+            }
+        }
+        SMBv1Commands commands[256];
+    } table;
+
+    return table.commands[static_cast<uint8_t>(cmd_code)];
+}
+
 extern "C" NST_PUBLIC const char* print_cifs1_procedures(SMBv1Commands cmd_code)
 {
     assert(cmd_code < SMBv1Commands::CMD_COUNT);
@@ -204,6 +204,12 @@ struct MessageHeader : public RawMessageHeader
  */
 const MessageHeader* get_header(const uint8_t* data);
 
+/*! Converts code of command from message header to API's command
+ * \param cmd_code - code of SMB command
+ * \return API's command or SMBv1Commands::CMD_COUNT for unknown code
+ */
+SMBv1Commands api_command(Commands cmd_code);
+
 /*! Constructs new command for API from raw message
  * \param request - Call's header
  * \param response - Reply's header
@@ -215,8 +221,10 @@ inline const Cmd command(Data& request, Data& response, Session* session)
     Cmd cmd;
     cmd.session = session;
     // Set time stamps
-    cmd.ctimestamp = &request->timestamp;
-    cmd.rtimestamp = &response->timestamp;
+    cmd.ctimestamp = request->legacy_timestamp();
+    cmd.rtimestamp = response->legacy_timestamp();
+    cmd.call_time  = request->timestamp;
+    cmd.reply_time = response->timestamp;
 
     return cmd;
 }
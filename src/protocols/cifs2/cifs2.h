@@ -171,8 +171,10 @@ inline const Cmd command(Data& request, Data& response, Session* session)
     Cmd cmd;
     cmd.session = session;
     // Set time stamps
-    cmd.ctimestamp = &request->timestamp;
-    cmd.rtimestamp = response ? &response->timestamp : &request->timestamp;
+    cmd.ctimestamp = request->legacy_timestamp();
+    cmd.rtimestamp = response ? response->legacy_timestamp() : cmd.ctimestamp;
+    cmd.call_time  = request->timestamp;
+    cmd.reply_time = response ? response->timestamp : request->timestamp;
 
     //
     // Since we have to modify structures before command creation
@@ -45,9 +45,10 @@ template <
 class NFSProcedure : public NST::API::RPCProcedure
 {
 public:
-    inline NFSProcedure(xdr::XDRDecoder& c, xdr::XDRDecoder& r, const Session* s)
-        : parg{&arg} // set pointer to argument
-        , pres{&res} // set pointer to result
+    //! Decodes RPC headers and, if bodies are required, procedure arguments and results
+    inline NFSProcedure(xdr::XDRDecoder& c, xdr::XDRDecoder& r, const Session* s, const bool bodies = true)
+        : parg{bodies ? &arg : nullptr} // set pointer to argument
+        , pres{bodies ? &res : nullptr} // set pointer to result
     {
         memset(&call, 0, sizeof(call));
         memset(&reply, 0, sizeof(reply));
@@ -62,7 +63,7 @@ public:
         }
 
         // fill call arguments
-        if(!proc_t_of(arg)(c.xdr(), &arg))
+        if(parg && !proc_t_of(arg)(c.xdr(), &arg))
         {
             xdr_free((xdrproc_t)proc_t_of(arg), (char*)&arg);
             xdr_free((xdrproc_t)xdr_callmsg, (char*)&call);
@@ -75,12 +76,13 @@ public:
         if(!xdr_replymsg(r.xdr(), &reply))
         {
             xdr_free((xdrproc_t)xdr_replymsg, (char*)&reply);
-            xdr_free((xdrproc_t)proc_t_of(arg), (char*)&arg);
+            if(parg) xdr_free((xdrproc_t)proc_t_of(arg), (char*)&arg);
             xdr_free((xdrproc_t)xdr_callmsg, (char*)&call);
             throw xdr::XDRDecoderError{"XDRDecoder: cann't read reply data"};
         }
 
-        if(reply.ru.RM_rmb.rp_stat == reply_stat::MSG_ACCEPTED &&
+        if(pres &&
+           reply.ru.RM_rmb.rp_stat == reply_stat::MSG_ACCEPTED &&
            reply.ru.RM_rmb.ru.RP_ar.ar_stat == accept_stat::SUCCESS)
         {
             // fill reply results
@@ -88,7 +90,7 @@ public:
             {
                 xdr_free((xdrproc_t)proc_t_of(res), (char*)&res);
                 xdr_free((xdrproc_t)xdr_replymsg, (char*)&reply);
-                xdr_free((xdrproc_t)proc_t_of(arg), (char*)&arg);
+                if(parg) xdr_free((xdrproc_t)proc_t_of(arg), (char*)&arg);
                 xdr_free((xdrproc_t)xdr_callmsg, (char*)&call);
                 throw xdr::XDRDecoderError{"XDRDecoder: cann't read reply results"};
             }
@@ -100,15 +102,17 @@ public:
 
         session = s;
 
-        ctimestamp = &c.data().timestamp;
-        rtimestamp = &r.data().timestamp;
+        ctimestamp = c.data().legacy_timestamp();
+        rtimestamp = r.data().legacy_timestamp();
+        call_time  = c.data().timestamp;
+        reply_time = r.data().timestamp;
     }
 
     inline ~NFSProcedure()
     {
         if(pres) xdr_free((xdrproc_t)proc_t_of(res), (char*)&res);
         xdr_free((xdrproc_t)xdr_replymsg, (char*)&reply);
-        xdr_free((xdrproc_t)proc_t_of(arg), (char*)&arg);
+        if(parg) xdr_free((xdrproc_t)proc_t_of(arg), (char*)&arg);
         xdr_free((xdrproc_t)xdr_callmsg, (char*)&call);
     }
 
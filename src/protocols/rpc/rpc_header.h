@@ -75,6 +75,55 @@ private:
     uint32_t m_stat;
 };
 
+/*! Reads status of reply without decoding of its results
+ * \param reply  - header of reply message
+ * \param len    - length of available data of reply message
+ * \param accept - AcceptStat of accepted reply
+ * \param status - first word of results (nfsstat3, nfsstat4) or 0 if it is absent
+ * \return False, if reply is denied or is too short for reading AcceptStat
+ */
+inline bool reply_status(const ReplyHeader* const reply, const uint32_t len, AcceptStat& accept, uint32_t& status)
+{
+    if(reply->stat() != ReplyStat::MSG_ACCEPTED || len < sizeof(ReplyHeader) + 2 * sizeof(uint32_t))
+    {
+        return false;
+    }
+    auto it = reinterpret_cast<const uint32_t*>(reply + 1);
+
+    // skip flavor and opaque body of verifier
+    uint64_t offset = sizeof(ReplyHeader) + 2 * sizeof(uint32_t);
+    offset += (uint64_t{ntohl(it[1])} + 3) & ~uint64_t{3};
+    if(len < offset + sizeof(uint32_t))
+    {
+        return false;
+    }
+    it = reinterpret_cast<const uint32_t*>(reinterpret_cast<const uint8_t*>(reply) + offset);
+
+    accept = AcceptStat(ntohl(it[0]));
+    status = (accept == AcceptStat::SUCCESS && len >= offset + 2 * sizeof(uint32_t)) ? ntohl(it[1]) : 0;
+    return true;
+}
+
+/*! Finds arguments of procedure in call message without decoding of credentials and verifier
+ * \param call - header of call message
+ * \param len  - length of available data of call message
+ * \return Offset of arguments from the beginning of call, 0 if call is too short
+ */
+inline uint32_t call_arguments(const CallHeader* const call, const uint32_t len)
+{
+    uint64_t offset = sizeof(CallHeader);
+    for(int i = 0; i < 2; ++i) // skip flavor and opaque body of credentials and verifier
+    {
+        if(len < offset + 2 * sizeof(uint32_t))
+        {
+            return 0;
+        }
+        auto it = reinterpret_cast<const uint32_t*>(reinterpret_cast<const uint8_t*>(call) + offset);
+        offset += 2 * sizeof(uint32_t) + ((uint64_t{ntohl(it[1])} + 3) & ~uint64_t{3});
+    }
+    return offset <= len ? offset : 0;
+}
+
 struct RecordMark //  RFC 5531 section 11 Record Marking Standard
 {
     inline bool           is_last() const { return ntohl(mark) & 0x80000000; /*1st bit*/ }
@@ -24,6 +24,9 @@
 //------------------------------------------------------------------------------
 #include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 #include <sys/time.h>
 
@@ -34,18 +37,40 @@ namespace NST
 {
 namespace utils
 {
+//! Compact description of message filled by filtration, so parsers don't validate its header again
+struct MessageDescriptor
+{
+    enum class Protocol : uint8_t
+    {
+        Unknown = 0, // message isn't described, parsers have to detect protocol by header
+        NFS     = 1, // RPC call of NFS program or RPC reply
+        CIFSv1  = 2,
+        CIFSv2  = 3
+    };
+
+    Protocol protocol{Protocol::Unknown};
+    bool     reply{false}; // RPC reply or SMB response
+    uint32_t program{0};   // RPC program of call
+    uint32_t version{0};   // RPC version of program of call
+    uint32_t procedure{0}; // RPC procedure of call or SMB command code
+    uint64_t id{0};        // RPC xid or SMB message id
+};
+
 struct FilteredData
 {
     using Direction = NST::utils::Session::Direction;
 
 public:
     NetworkSession* session{nullptr}; // pointer to immutable session in Filtration
-    struct timeval  timestamp;        // timestamp of last collected packet
+    int64_t         timestamp{0};     // timestamp of last collected packet in nanoseconds since Epoch
     Direction       direction;        // direction of data transmission
 
     uint32_t dlen{0};     // length of filtered data
+    uint32_t msg_len{0};  // length of whole message, filtered data may be truncated
     uint8_t* data{cache}; // pointer to data in memory. {Readonly. Always points to proper memory buffer}
 
+    MessageDescriptor descriptor; // description of message header at data[0] filled by filtration
+
 private:
     const static int CACHE_SIZE{4000};
 
@@ -53,6 +78,8 @@ private:
     uint8_t* memory{nullptr};
     uint32_t memsize{0};
 
+    mutable struct timeval legacy; // timestamp converted by legacy_timestamp()
+
 public:
     // disable copying
     FilteredData(const FilteredData&) = delete;
@@ -107,6 +134,14 @@ public:
         }
     }
 
+    // Timestamp in microseconds for Procedure::ctimestamp and rtimestamp of old plugins, valid while data is alive
+    inline const struct timeval* legacy_timestamp() const
+    {
+        legacy.tv_sec  = timestamp / 1000000000;
+        legacy.tv_usec = (timestamp % 1000000000) / 1000;
+        return &legacy;
+    }
+
     // Reset data. Release free memory if allocated
     void reset()
     {
@@ -117,11 +152,15 @@ public:
         }
         memsize = 0;
         dlen    = 0;
+        msg_len = 0;
         data    = cache;
+
+        descriptor = MessageDescriptor{};
     }
 };
 
-using FilteredDataQueue = Queue<FilteredData>;
+using FilteredDataQueue  = Queue<FilteredData>;
+using FilteredDataQueues = std::vector<std::unique_ptr<FilteredDataQueue>>; // a queue per parser thread
 
 } // namespace utils
 } // namespace NST
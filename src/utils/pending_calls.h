@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Flat open-addressing table of requests waiting for responses
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef PENDING_CALLS_H
+#define PENDING_CALLS_H
+//------------------------------------------------------------------------------
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <utility>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace utils
+{
+/*! Table of requests (RPC calls, SMB requests) waiting for their responses.
+ * Entries are kept in one array with linear probing and removed by backward
+ * shifting, so insertion and lookup don't allocate memory after the table
+ * has grown to the working set of a session.
+ * Ptr is a movable owning pointer, an empty Ptr marks a free slot.
+ */
+template <typename Ptr>
+class PendingCalls
+{
+    struct Slot
+    {
+        std::uint64_t key;
+        std::time_t   stamp; // timestamp of request, kept here to sweep without touching data
+        Ptr           data;
+    };
+
+public:
+    explicit PendingCalls(std::size_t capacity = 64)
+    {
+        std::size_t size{8};
+        while(size < capacity) size <<= 1;
+        resize(size);
+    }
+    PendingCalls(const PendingCalls&) = delete;
+    PendingCalls& operator=(const PendingCalls&) = delete;
+
+    /*! Saves request
+     * \param key - RPC xid or SMB message id
+     * \param stamp - time of request in seconds
+     * \param data - request
+     * \return True, if a previous request with the same key was replaced
+     */
+    bool insert(const std::uint64_t key, const std::time_t stamp, Ptr&& data)
+    {
+        assert(data);
+        if((count + 1) * 2 > slots.size()) // keep load factor at most 1/2
+        {
+            grow();
+        }
+
+        Slot& s = slots[find(key)];
+        const bool replaced{bool(s.data)};
+        if(!replaced)
+        {
+            ++count;
+        }
+        s.key   = key;
+        s.stamp = stamp;
+        s.data  = std::move(data); // old request is destroyed here
+        return replaced;
+    }
+
+    /*! Takes out request matched with a response
+     * \param key - RPC xid or SMB message id
+     * \return Request or empty Ptr if it is not found
+     */
+    Ptr extract(const std::uint64_t key)
+    {
+        const std::size_t i = find(key);
+        if(!slots[i].data)
+        {
+            return Ptr{};
+        }
+        Ptr data{std::move(slots[i].data)};
+        erase(i);
+        return data;
+    }
+
+    /*! Removes requests which are older than deadline and releases their memory
+     * \param deadline - time of oldest request that still may get a response
+     * \return Amount of removed requests
+     */
+    std::size_t expire(const std::time_t deadline)
+    {
+        const std::size_t mask = slots.size() - 1;
+
+        // start after a free slot, so none of clusters wraps around the end of scan
+        std::size_t start{0};
+        while(slots[start].data) ++start;
+
+        std::size_t expired{0};
+        for(std::size_t n = 1; n < slots.size(); ++n)
+        {
+            const std::size_t i = (start + n) & mask;
+            // backward shift may move next entry into i, so check it again
+            while(slots[i].data && slots[i].stamp < deadline)
+            {
+                slots[i].data = Ptr{};
+                erase(i);
+                ++expired;
+            }
+        }
+        return expired;
+    }
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return slots.size(); }
+private:
+    std::size_t home(const std::uint64_t key) const
+    {
+        // Fibonacci hashing spreads sequential xids over the table
+        return (key * 11400714819323198485ull) >> shift;
+    }
+
+    //! Returns slot of the key or free slot where the key should be placed
+    std::size_t find(const std::uint64_t key) const
+    {
+        const std::size_t mask = slots.size() - 1;
+        std::size_t       i    = home(key);
+        while(slots[i].data && slots[i].key != key)
+        {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    //! Frees slot i and moves following entries of its cluster closer to their home slots
+    void erase(std::size_t i)
+    {
+        const std::size_t mask = slots.size() - 1;
+        for(std::size_t j = (i + 1) & mask; slots[j].data; j = (j + 1) & mask)
+        {
+            const std::size_t k = home(slots[j].key);
+            if(((j - k) & mask) >= ((j - i) & mask)) // i lies between k and j
+            {
+                slots[i].key   = slots[j].key;
+                slots[i].stamp = slots[j].stamp;
+                slots[i].data  = std::move(slots[j].data);
+                i              = j;
+            }
+        }
+        slots[i].data = Ptr{};
+        --count;
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old{std::move(slots)};
+        resize(old.size() * 2);
+        for(Slot& s : old)
+        {
+            if(s.data)
+            {
+                Slot& n = slots[find(s.key)];
+                n.key   = s.key;
+                n.stamp = s.stamp;
+                n.data  = std::move(s.data);
+            }
+        }
+    }
+
+    void resize(const std::size_t size)
+    {
+        assert((size & (size - 1)) == 0);
+        slots = std::vector<Slot>(size);
+        shift = 64;
+        for(std::size_t s = size; s > 1; s >>= 1) --shift;
+    }
+
+    std::vector<Slot> slots;
+    std::size_t       count{0};
+    unsigned          shift{64};
+};
+
+} // namespace utils
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // PENDING_CALLS_H
+//------------------------------------------------------------------------------
@@ -19,6 +19,7 @@
     along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
 */
 //------------------------------------------------------------------------------
+#include <atomic>
 #include <sstream>
 
 #include <arpa/inet.h> // for inet_ntop(), ntohs()
@@ -38,6 +39,9 @@ std::ostream& operator<<(std::ostream& out, const ApplicationSession& session);
 ApplicationSession::ApplicationSession(const NetworkSession& s, Direction from_client)
     : utils::Session(s)
 {
+    static std::atomic<uint32_t> next_id{0}; // sessions are created by several parser threads
+    id = next_id.fetch_add(1, std::memory_order_relaxed);
+
     if(s.direction != from_client)
     {
         //TODO: implement correct swap_src_dst()
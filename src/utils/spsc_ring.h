@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Bounded lock-free ring for one producer and one consumer threads
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <cstddef>
+#include <memory>
+//------------------------------------------------------------------------------
+namespace NST
+{
+namespace utils
+{
+/*! Ring of preallocated elements passed from producer thread to consumer thread.
+ * Elements are filled in place: producer gets free slot(), fills it and push()es,
+ * consumer reads front() and pop()s it, so the slot can be reused.
+ */
+template <typename T>
+class SPSCRing
+{
+public:
+    explicit SPSCRing(std::size_t size)
+    {
+        std::size_t n{2};
+        while(n < size) n <<= 1;
+        items.reset(new T[n]);
+        mask = n - 1;
+    }
+    SPSCRing(const SPSCRing&) = delete;
+    SPSCRing& operator=(const SPSCRing&) = delete;
+
+    //! Returns free slot for producer or nullptr if the ring is full
+    inline T* slot()
+    {
+        const std::size_t t{tail.value.load(std::memory_order_relaxed)};
+        if(t - head.value.load(std::memory_order_acquire) > mask)
+        {
+            return nullptr;
+        }
+        return &items[t & mask];
+    }
+
+    //! Passes the filled slot to consumer
+    inline void push()
+    {
+        tail.value.store(tail.value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    //! Returns the oldest element for consumer or nullptr if the ring is empty
+    inline T* front()
+    {
+        const std::size_t h{head.value.load(std::memory_order_relaxed)};
+        if(h == tail.value.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &items[h & mask];
+    }
+
+    //! Returns the slot of consumed element to producer
+    inline void pop()
+    {
+        head.value.store(head.value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    inline std::size_t capacity() const { return mask + 1; }
+private:
+    //! Position in the ring, increased infinitely and padded to avoid false sharing
+    struct Position
+    {
+        std::atomic<std::size_t> value{0};
+        char                     padding[64 - sizeof(std::atomic<std::size_t>)];
+    };
+
+    std::unique_ptr<T[]> items;
+    std::size_t          mask;
+
+    Position head; // written by consumer
+    Position tail; // written by producer
+};
+
+} // namespace utils
+} // namespace NST
+//------------------------------------------------------------------------------
+#endif // SPSC_RING_H
+//------------------------------------------------------------------------------
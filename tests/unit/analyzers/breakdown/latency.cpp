@@ -73,11 +73,21 @@ TEST_F(LatencyTest, max_min)
 
     EXPECT_EQ(2U, latency.get_count());
 
-    EXPECT_EQ(t2.tv_sec, latency.get_min().tv_sec);
-    EXPECT_EQ(t2.tv_usec, latency.get_min().tv_usec);
+    EXPECT_EQ(to_nsec(t2), latency.get_min());
+    EXPECT_EQ(to_nsec(t1), latency.get_max());
+}
+
+TEST_F(LatencyTest, nanoseconds)
+{
+    Latencies latency;
+
+    latency.add(uint64_t{1500});
+    latency.add(uint64_t{999});
 
-    EXPECT_EQ(t1.tv_sec, latency.get_max().tv_sec);
-    EXPECT_EQ(t1.tv_usec, latency.get_max().tv_usec);
+    EXPECT_EQ(999U, latency.get_min());
+    EXPECT_EQ(1500U, latency.get_max());
+    EXPECT_NEAR(0.0000012495, latency.get_avg(), 1e-12);
+    EXPECT_NEAR(2.000000003, to_sec(uint64_t{2000000003}), 1e-12);
 }
 
 TEST_F(LatencyTest, avg)
@@ -95,6 +105,49 @@ TEST_F(LatencyTest, avg)
     EXPECT_NEAR(6.0, latency.get_avg(), 0.0001);
 }
 
+TEST_F(LatencyTest, percentiles)
+{
+    Latencies latency;
+
+    EXPECT_EQ(0U, latency.get_percentile(99));
+
+    timeval t{0, 0};
+    for(int i = 1; i <= 1000; ++i)
+    {
+        t.tv_usec = i;
+        latency.add(t);
+    }
+
+    // upper bounds of buckets are within 1/32 of values
+    EXPECT_GE(latency.get_percentile(50), 500000U);
+    EXPECT_LE(latency.get_percentile(50), 500000U * 33 / 32);
+    EXPECT_GE(latency.get_percentile(99.9), 999000U);
+    EXPECT_EQ(1000000U, latency.get_percentile(100)); // doesn't exceed maximum
+}
+
+TEST_F(LatencyTest, merge)
+{
+    Latencies a;
+    Latencies b;
+    Latencies all;
+
+    a.add(t1);
+    all.add(t1);
+    b.add(t2);
+    all.add(t2);
+    b.add(t2);
+    all.add(t2);
+
+    a.merge(b);
+
+    EXPECT_EQ(3U, a.get_count());
+    EXPECT_NEAR(all.get_avg(), a.get_avg(), 0.0001);
+    EXPECT_NEAR(all.get_st_dev(), a.get_st_dev(), 0.0001);
+    EXPECT_EQ(to_nsec(t2), a.get_min());
+    EXPECT_EQ(to_nsec(t1), a.get_max());
+    EXPECT_EQ(all.get_percentile(50), a.get_percentile(50));
+}
+
 TEST_F(LatencyTest, convert_timeval_to_sec)
 {
     /* This test checks to_sec() function and rounding its result to smaller
@@ -19,13 +19,20 @@
     along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
 */
 //------------------------------------------------------------------------------
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <system_error>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "nfsv3commands.h"
+#include "representer.h"
+#include "sessionsfile.h"
 #include "statistics.h"
 //------------------------------------------------------------------------------
 using namespace NST::breakdown;
@@ -63,18 +70,15 @@ class Proc
 {
 public:
     Proc()
-        : session(&_session)
-        , rtimestamp(&_rtimestamp)
-        , ctimestamp(&_ctimestamp)
+        : _session()
+        , session(&_session)
     {
     }
 
     Session        _session;
-    timeval        _rtimestamp;
-    timeval        _ctimestamp;
     const Session* session;
-    const timeval* rtimestamp;
-    const timeval* ctimestamp;
+    int64_t        call_time{0};
+    int64_t        reply_time{0};
 };
 }
 //------------------------------------------------------------------------------
@@ -130,4 +134,157 @@ TEST_F(StatisticTest, statistics_per_session)
         each_procedure_mock.mock_function();
     });
 }
+
+TEST_F(StatisticTest, sessions_by_id)
+{
+    Statistics stats(count);
+    Proc       proc;
+
+    const uint32_t sessions{1000};
+    for(uint32_t id = 0; id < sessions; ++id)
+    {
+        proc._session.id = sessions - id;
+        proc.reply_time  = id;
+        stats.account(&proc, 0);
+        stats.account(&proc, 1);
+    }
+
+    uint32_t expected{sessions}; // in order of appearance
+    stats.for_each_session([&](const Session& session) {
+        EXPECT_EQ(expected--, session.id);
+        stats.for_each_procedure_in_session(session, [&](const BreakdownCounter& breakdown, size_t procedure) {
+            EXPECT_EQ(procedure < 2 ? 1U : 0U, breakdown[procedure].get_count());
+        });
+    });
+    EXPECT_EQ(0U, expected);
+}
+
+TEST_F(StatisticTest, rollups)
+{
+    Statistics stats(count, Dimensions{}.set());
+    Proc       proc;
+
+    // 2 sessions of one client with 2 servers and 1 session of other client
+    const in_addr_t clients[] = {1, 1, 2};
+    const in_addr_t servers[] = {3, 4, 3};
+    for(uint32_t id = 0; id < 3; ++id)
+    {
+        proc._session.id                               = id + 1;
+        proc._session.ip.v4.addr[Session::Source]      = clients[id];
+        proc._session.ip.v4.addr[Session::Destination] = servers[id];
+        stats.account(&proc, 0);
+        stats.account(&proc, 1);
+    }
+
+    const uint64_t expected[dimensions_count][2] = {{4, 2}, {4, 2}};
+    for(size_t d = 0; d < dimensions_count; ++d)
+    {
+        size_t hosts{0};
+        stats.for_each_host(static_cast<Dimension>(d), [&](const Host& host) {
+            stats.for_each_procedure_in_host(static_cast<Dimension>(d), host, [&](const BreakdownCounter& breakdown, size_t) {
+                EXPECT_EQ(expected[d][hosts], breakdown.get_total_count());
+            });
+            ++hosts;
+        });
+        EXPECT_EQ(2U, hosts);
+    }
+
+    Statistics disabled(count);
+    disabled.account(&proc, 0);
+    disabled.for_each_host(Dimension::Client, [&](const Host&) {
+        ADD_FAILURE() << "rollup is disabled";
+    });
+}
+
+TEST_F(StatisticTest, recent_windows)
+{
+    Statistics stats(count);
+    Proc       proc;
+
+    const int64_t second{1000000000};
+    proc.call_time  = 100 * second;
+    proc.reply_time = proc.call_time + 1000;
+    stats.account(&proc, 0);
+
+    // 20 seconds later, the first operation is out of 1s and 10s windows
+    proc.call_time  = 120 * second;
+    proc.reply_time = proc.call_time + 3000;
+    stats.account(&proc, 0);
+    stats.account(&proc, 1);
+
+    uint64_t expected[windows_count] = {1, 1, 2, 2};
+    for(size_t window = 0; window < windows_count; ++window)
+    {
+        stats.for_each_procedure_in_window(window, [&](const WindowCounter& total, const Histogram& histogram, size_t procedure) {
+            EXPECT_EQ(procedure == 0 ? expected[window] : procedure == 1 ? 1U : 0U, total.count);
+            EXPECT_EQ(total.count, histogram.get_count());
+            if(total.count)
+            {
+                EXPECT_EQ(3000U, total.max);
+            }
+        });
+        size_t sessions{0};
+        stats.for_each_session_in_window(window, [&](const Session&, const WindowCounter& total) {
+            EXPECT_EQ(expected[window] + 1, total.count);
+            ++sessions;
+        });
+        EXPECT_EQ(1U, sessions);
+    }
+
+    // late operation of replaced slice is accounted in longer windows only
+    proc.call_time  = 100 * second;
+    proc.reply_time = proc.call_time + 1000;
+    stats.account(&proc, 2);
+    stats.for_each_procedure_in_window(0, [&](const WindowCounter& total, const Histogram&, size_t procedure) {
+        EXPECT_EQ(procedure < 2 ? 1U : 0U, total.count);
+    });
+    stats.for_each_procedure_in_window(3, [&](const WindowCounter& total, const Histogram&, size_t procedure) {
+        EXPECT_EQ(procedure == 0 ? 2U : procedure < 3 ? 1U : 0U, total.count);
+    });
+}
 //------------------------------------------------------------------------------
+
+TEST_F(StatisticTest, sessions_file)
+{
+    const char* path{"breakdown_sessions_test.csv"};
+    Statistics  stats(NFSv3Commands().commands_count());
+    Proc        proc;
+
+    const uint32_t sessions{1000}; // enough to be formatted by several threads
+    for(uint32_t id = 1; id <= sessions; ++id)
+    {
+        proc._session.id = id;
+        proc.reply_time  = id;
+        stats.account(&proc, 6); // READ
+    }
+
+    {
+        SessionsFile      file{path};
+        std::stringstream out;
+        Representer       representer(out, new NFSv3Commands(), 12, &file);
+        representer.flush_statistics(stats);
+        file.close();
+    }
+
+    std::ifstream input{path};
+    std::string   line;
+    ASSERT_TRUE(std::getline(input, line));
+    EXPECT_EQ(std::string{SessionsFile::header}, line + '\n');
+
+    size_t rows{0};
+    while(std::getline(input, line))
+    {
+        const size_t procedure{rows++ % NFSv3Commands().commands_count()};
+        const char*  expected{procedure == 6 ? ",NFS v3,6,READ,1,100.00," : ",0,0.00,"};
+        EXPECT_NE(std::string::npos, line.find(expected)) << line;
+    }
+    EXPECT_EQ(sessions * NFSv3Commands().commands_count(), rows);
+    std::remove(path);
+}
+
+TEST_F(StatisticTest, sessions_file_error)
+{
+    SessionsFile file{"/dev/full"};
+    file.append("rows are kept in buffer until close\n");
+    EXPECT_THROW(file.close(), std::system_error);
+}
@@ -38,6 +38,7 @@ using namespace NST::utils;
 using ::testing::Return;
 using ::testing::AtLeast;
 using ::testing::_;
+using ::testing::Invoke;
 //------------------------------------------------------------------------------
 
 namespace
@@ -45,6 +46,11 @@ namespace
 class PluginMock : public IAnalyzer
 {
 public:
+    // IHeaderEvents interface
+    MOCK_METHOD1(headerSMBv2, void(const HeaderEvent*));
+    MOCK_METHOD2(headers, void(const HeaderEvent*, std::size_t));
+    MOCK_METHOD2(records, void(const OpRecord*, std::size_t));
+
     // ISMBv2 interface
     MOCK_METHOD3(readSMBv2, void(const SMBv2::ReadCommand*, const NST::API::SMBv2::ReadRequest*, const NST::API::SMBv2::ReadResponse*));
 
@@ -52,12 +58,22 @@ public:
     void flush_statistics() {}
 };
 
-PluginMock* pluginMock; // pointer to mock
+PluginMock*          pluginMock; // pointer to mock
+AnalyzerSubscription handled;    // commands handled by mock
 }
 //------------------------------------------------------------------------------
 Analyzers::Analyzers(const controller::Parameters& /*params*/)
 {
-    this->modules.push_back(pluginMock);
+    this->modules.emplace_back(pluginMock, nullptr, handled);
+    this->_subscription = handled;
+    if(handled.batches)
+    {
+        this->batch.reset(new HeaderBatch);
+    }
+    if(handled.records)
+    {
+        this->records.reset(new RecordBatch);
+    }
 }
 //------------------------------------------------------------------------------
 Parameters::Parameters(int /*argc*/, char** /*argv*/)
@@ -206,4 +222,221 @@ TEST(Parser, CIFSAsyncParser)
 
     delete pluginMock;
 }
+
+TEST(Parser, CIFSUnsubscribedCommand)
+{
+    pluginMock = new PluginMock;
+    handled    = AnalyzerSubscription{false}.subscribe(NST::API::SMBv2::SMBv2Commands::WRITE);
+
+    NST::controller::Parameters params(0, nullptr);
+    Analyzers                   analyzers(params);
+
+    NST::utils::FilteredDataQueue queue(1, 1);
+    NST::utils::FilteredData*     data = queue.allocate();
+    NetworkSession                s;
+    data->session = &s;
+    queue.push(data);
+    NST::utils::FilteredDataQueue::List list(queue);
+    NST::utils::FilteredDataQueue::Ptr  el = list.get_current();
+
+    CIFSv2::MessageHeader header;
+    header.head_code = NST::API::SMBv2::pc_to_net<uint32_t>(0x424d53fe); // Protocol's marker
+    header.cmd_code  = NST::API::SMBv2::SMBv2Commands::READ;
+    header.flags     = static_cast<uint32_t>(CIFSv2::Flags::ASYNC_COMMAND);
+
+    el->data = reinterpret_cast<uint8_t*>(&header);
+    el->dlen = sizeof(header);
+
+    CIFSParser parser(analyzers);
+
+    // Set conditions
+    EXPECT_CALL(*pluginMock, readSMBv2(_, _, _))
+        .Times(0);
+
+    // Do
+    parser.parse_data(el);
+
+    delete pluginMock;
+    handled = AnalyzerSubscription{};
+}
+
+TEST(Parser, CIFSHeaderEvent)
+{
+    pluginMock      = new PluginMock;
+    handled         = AnalyzerSubscription{false};
+    handled.headers = true;
+
+    NST::controller::Parameters params(0, nullptr);
+    Analyzers                   analyzers(params);
+
+    NST::utils::FilteredDataQueue queue(1, 1);
+    NST::utils::FilteredData*     data = queue.allocate();
+    NetworkSession                s;
+    data->session = &s;
+    queue.push(data);
+    NST::utils::FilteredDataQueue::List list(queue);
+    NST::utils::FilteredDataQueue::Ptr  el = list.get_current();
+
+    CIFSv2::MessageHeader header;
+    header.head_code = NST::API::SMBv2::pc_to_net<uint32_t>(0x424d53fe); // Protocol's marker
+    header.cmd_code  = NST::API::SMBv2::SMBv2Commands::READ;
+    header.flags     = static_cast<uint32_t>(CIFSv2::Flags::ASYNC_COMMAND);
+    header.messageId = 42;
+
+    el->data = reinterpret_cast<uint8_t*>(&header);
+    el->dlen = sizeof(header);
+
+    CIFSParser parser(analyzers);
+
+    // Set conditions
+    EXPECT_CALL(*pluginMock, headerSMBv2(::testing::AllOf(
+                                 ::testing::Field(&HeaderEvent::protocol, Protocol::SMBv2),
+                                 ::testing::Field(&HeaderEvent::procedure, 8U), // READ
+                                 ::testing::Field(&HeaderEvent::id, 42U),
+                                 ::testing::Field(&HeaderEvent::reply_size, 0U))))
+        .Times(1);
+    EXPECT_CALL(*pluginMock, readSMBv2(_, _, _))
+        .Times(0);
+
+    // Do
+    parser.parse_data(el);
+
+    delete pluginMock;
+    handled = AnalyzerSubscription{};
+}
+
+TEST(Parser, CIFSDescribedMessage)
+{
+    pluginMock = new PluginMock;
+
+    NST::controller::Parameters params(0, nullptr);
+    Analyzers                   analyzers(params);
+
+    NST::utils::FilteredDataQueue queue(1, 1);
+    NST::utils::FilteredData*     data = queue.allocate();
+    NetworkSession                s;
+    data->session = &s;
+    queue.push(data);
+    NST::utils::FilteredDataQueue::List list(queue);
+    NST::utils::FilteredDataQueue::Ptr  el = list.get_current();
+
+    CIFSv2::MessageHeader header;
+    header.head_code = 0; // marker isn't checked again, header is validated by filtration
+    header.cmd_code  = NST::API::SMBv2::SMBv2Commands::READ;
+    header.flags     = static_cast<uint32_t>(CIFSv2::Flags::ASYNC_COMMAND);
+
+    el->data                = reinterpret_cast<uint8_t*>(&header);
+    el->dlen                = sizeof(header);
+    el->descriptor.protocol = NST::utils::MessageDescriptor::Protocol::CIFSv2;
+
+    CIFSParser parser(analyzers);
+
+    // Set conditions
+    EXPECT_CALL(*pluginMock, readSMBv2(_, _, _))
+        .Times(1);
+
+    // Do
+    EXPECT_TRUE(parser.parse_data(el));
+
+    delete pluginMock;
+}
+
+TEST(Parser, CIFSHeaderBatch)
+{
+    pluginMock      = new PluginMock;
+    handled         = AnalyzerSubscription{false};
+    handled.headers = true;
+    handled.batches = true;
+
+    NST::controller::Parameters params(0, nullptr);
+    Analyzers                   analyzers(params);
+
+    NST::utils::FilteredDataQueue queue(1, 1);
+    NST::utils::FilteredData*     data = queue.allocate();
+    NetworkSession                s;
+    data->session = &s;
+    queue.push(data);
+    NST::utils::FilteredDataQueue::List list(queue);
+    NST::utils::FilteredDataQueue::Ptr  el = list.get_current();
+
+    CIFSv2::MessageHeader header;
+    header.head_code = NST::API::SMBv2::pc_to_net<uint32_t>(0x424d53fe); // Protocol's marker
+    header.cmd_code  = NST::API::SMBv2::SMBv2Commands::READ;
+    header.flags     = static_cast<uint32_t>(CIFSv2::Flags::ASYNC_COMMAND);
+
+    el->data = reinterpret_cast<uint8_t*>(&header);
+    el->dlen = sizeof(header);
+
+    CIFSParser parser(analyzers);
+
+    // Set conditions
+    EXPECT_CALL(*pluginMock, headerSMBv2(_))
+        .Times(0);
+    EXPECT_CALL(*pluginMock, headers(_, 1U))
+        .Times(1);
+
+    // Do
+    parser.parse_data(el);
+    analyzers.deliver_batch();
+    analyzers.deliver_batch(); // empty batch isn't passed
+
+    delete pluginMock;
+    handled = AnalyzerSubscription{};
+}
+
+TEST(Parser, CIFSReadRecord)
+{
+    pluginMock      = new PluginMock;
+    handled         = AnalyzerSubscription{false};
+    handled.records = true;
+
+    NST::controller::Parameters params(0, nullptr);
+    Analyzers                   analyzers(params);
+
+    NST::utils::FilteredDataQueue queue(1, 1);
+    NST::utils::FilteredData*     data = queue.allocate();
+    NetworkSession                s;
+    data->session = &s;
+    queue.push(data);
+    NST::utils::FilteredDataQueue::List list(queue);
+    NST::utils::FilteredDataQueue::Ptr  el = list.get_current();
+
+    uint8_t message[sizeof(CIFSv2::MessageHeader) + sizeof(NST::API::SMBv2::ReadRequest)] = {};
+    auto    header = reinterpret_cast<CIFSv2::MessageHeader*>(message);
+    auto    read   = reinterpret_cast<NST::API::SMBv2::ReadRequest*>(message + sizeof(CIFSv2::MessageHeader));
+    header->head_code      = NST::API::SMBv2::pc_to_net<uint32_t>(0x424d53fe); // Protocol's marker
+    header->cmd_code       = NST::API::SMBv2::SMBv2Commands::READ;
+    header->flags          = static_cast<uint32_t>(CIFSv2::Flags::ASYNC_COMMAND);
+    header->messageId      = 42;
+    read->length           = 4096;
+    read->offset           = 65536;
+    read->persistentFileId = 7;
+
+    el->data = message;
+    el->dlen = sizeof(message);
+
+    CIFSParser parser(analyzers);
+
+    // Set conditions
+    EXPECT_CALL(*pluginMock, headerSMBv2(_))
+        .Times(0);
+    EXPECT_CALL(*pluginMock, records(_, 1U))
+        .WillOnce(Invoke([](const OpRecord* r, std::size_t) {
+            EXPECT_EQ(OP_RECORD_VERSION, r->version);
+            EXPECT_EQ(sizeof(OpRecord), r->size);
+            EXPECT_EQ(Protocol::SMBv2, r->protocol);
+            EXPECT_EQ(AnalyzerSubscription::index(NST::API::SMBv2::SMBv2Commands::READ), r->procedure);
+            EXPECT_EQ(42U, r->id);
+            EXPECT_EQ(65536U, r->offset);
+            EXPECT_EQ(4096U, r->count);
+            EXPECT_NE(0U, r->fh);
+        }));
+
+    // Do
+    parser.parse_data(el);
+    analyzers.deliver_batch();
+
+    delete pluginMock;
+    handled = AnalyzerSubscription{};
+}
 //------------------------------------------------------------------------------
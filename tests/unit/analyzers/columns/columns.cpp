@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for columnar export
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "columns_writer.h"
+//------------------------------------------------------------------------------
+using namespace columns;
+using NST::API::OpRecord;
+using NST::API::Protocol;
+//------------------------------------------------------------------------------
+namespace
+{
+const char* const directory{"nst_unit_test_columns"};
+
+std::string read_file(const std::string& path)
+{
+    std::ifstream file{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+OpRecord record(uint64_t time, uint64_t session, uint32_t procedure)
+{
+    OpRecord r{};
+    r.protocol   = Protocol::NFSv3;
+    r.procedure  = procedure;
+    r.session    = session;
+    r.call_time  = time;
+    r.reply_time = time + 100;
+    return r;
+}
+}
+//------------------------------------------------------------------------------
+TEST(Columns, blocksAndIndexes)
+{
+    const uint64_t times[] = {1000000, 1000500, 999000, 2000000, 3000000};
+    {
+        ColumnsWriter writer{directory, 2, Z_BEST_SPEED};
+        for(uint64_t t : times)
+        {
+            writer.append(record(t, t < 2000000 ? 77 : 88, 6 /*READ*/));
+        }
+        EXPECT_EQ(5U, writer.rows());
+    } // the last block is written by destructor
+
+    const std::string index{read_file(std::string{directory} + "/call_time.idx")};
+    ASSERT_EQ(3 * sizeof(BlockIndex), index.size());
+    auto blocks = reinterpret_cast<const BlockIndex*>(index.data());
+    EXPECT_EQ(2U, blocks[0].rows);
+    EXPECT_EQ(1000000U, blocks[0].min);
+    EXPECT_EQ(1000500U, blocks[0].max);
+    EXPECT_EQ(999000U, blocks[1].min);
+    EXPECT_EQ(1U, blocks[2].rows);
+
+    // the second block is decoded without the first one
+    const std::string data{read_file(std::string{directory} + "/call_time.col")};
+    ASSERT_EQ(blocks[2].offset + blocks[2].size, data.size());
+    std::vector<uint8_t> raw(blocks[1].raw);
+    uLongf               size{blocks[1].raw};
+    ASSERT_EQ(Z_OK, uncompress(raw.data(), &size, reinterpret_cast<const Bytef*>(data.data() + blocks[1].offset), blocks[1].size));
+
+    const uint8_t* it{raw.data()};
+    uint64_t       time{0};
+    for(int i = 2; i < 4; ++i)
+    {
+        uint64_t delta;
+        it = get_varint(it, raw.data() + raw.size(), delta);
+        ASSERT_NE(nullptr, it);
+        time += unzigzag(delta);
+        EXPECT_EQ(times[i], time);
+    }
+
+    const std::string sessions{read_file(std::string{directory} + "/sessions.dict")};
+    EXPECT_EQ(2 * sizeof(uint64_t), sessions.size());
+    EXPECT_EQ("0 0 6 READ\n", read_file(std::string{directory} + "/procedures.dict"));
+    EXPECT_NE(std::string::npos, read_file(std::string{directory} + "/columns.meta").find("rows 5\n"));
+}
+
+TEST(Columns, checkpoints)
+{
+    ColumnsWriter writer{directory, 1, Z_BEST_SPEED};
+    const std::string meta{std::string{directory} + "/columns.meta"};
+    EXPECT_NE(std::string::npos, read_file(meta).find("rows 0\n"));
+
+    for(uint32_t i = 0; i < ColumnsWriter::checkpoint_blocks - 1; ++i)
+    {
+        writer.append(record(1000 + i, i, 6 /*READ*/));
+    }
+    EXPECT_NE(std::string::npos, read_file(meta).find("blocks 0\n")); // blocks aren't visible yet
+
+    std::ifstream previous{meta}; // reader opened meta before checkpoint
+    writer.append(record(2000, 0, 7 /*WRITE*/));
+    EXPECT_NE(std::string::npos, read_file(meta).find("blocks 16\n"));
+    const std::string seen{std::istreambuf_iterator<char>{previous}, std::istreambuf_iterator<char>{}};
+    EXPECT_NE(std::string::npos, seen.find("blocks 0\nblock_rows ")); // meta is replaced rather than rewritten
+    EXPECT_FALSE(std::ifstream{meta + ".tmp"}.good());
+    EXPECT_EQ(16 * sizeof(BlockIndex), read_file(std::string{directory} + "/call_time.idx").size());
+    EXPECT_EQ(15 * sizeof(uint64_t), read_file(std::string{directory} + "/sessions.dict").size());
+    EXPECT_EQ("0 0 6 READ\n1 0 7 WRITE\n", read_file(std::string{directory} + "/procedures.dict"));
+}
+
+TEST(Columns, varints)
+{
+    std::string out;
+    const int64_t values[] = {0, 1, -1, 300, -70000, INT64_MAX, INT64_MIN};
+    for(int64_t v : values)
+    {
+        put_varint(out, zigzag(v));
+    }
+
+    auto           begin = reinterpret_cast<const uint8_t*>(out.data());
+    const uint8_t* end   = begin + out.size();
+    for(int64_t v : values)
+    {
+        uint64_t value;
+        begin = get_varint(begin, end, value);
+        ASSERT_NE(nullptr, begin);
+        EXPECT_EQ(v, unzigzag(value));
+    }
+    EXPECT_EQ(end, begin);
+
+    uint64_t value;
+    EXPECT_EQ(nullptr, get_varint(end - 1, end - 1, value)); // truncated
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for queries over exported operation columns
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "columns_reader.h"
+#include "columns_writer.h"
+#include "query.h"
+//------------------------------------------------------------------------------
+using namespace columns;
+using NST::API::OpRecord;
+using NST::API::Protocol;
+//------------------------------------------------------------------------------
+namespace
+{
+const char* const directory{"nst_unit_test_query"};
+
+// 100 rows in blocks of 10, session and procedure are changed each 50 rows
+void write_export()
+{
+    ColumnsWriter writer{directory, 10, Z_BEST_SPEED};
+    for(uint64_t i = 0; i < 100; ++i)
+    {
+        OpRecord r{};
+        r.protocol   = Protocol::NFSv3;
+        r.procedure  = i < 50 ? 6 /*READ*/ : 7 /*WRITE*/;
+        r.status     = i % 10 == 9 ? 2 : 0;
+        r.session    = i < 50 ? 77 : 88;
+        r.call_time  = 1000 * (i + 1);
+        r.reply_time = r.call_time + i + 1;
+        r.call_size  = 100;
+        r.reply_size = 10;
+        writer.append(r);
+    }
+}
+}
+//------------------------------------------------------------------------------
+TEST(Query, decodeBlocks)
+{
+    write_export();
+    const ColumnsReader reader{directory};
+    ASSERT_EQ(10U, reader.blocks());
+    EXPECT_EQ(100U, reader.rows());
+    ASSERT_EQ(2U, reader.sessions().size());
+    EXPECT_EQ(77U, reader.sessions()[0]);
+    ASSERT_EQ(2U, reader.procedures().size());
+    EXPECT_EQ("WRITE", reader.procedures()[1].name);
+
+    std::vector<uint64_t> values;
+    std::vector<uint8_t>  buffer;
+    reader.decode(Column::CallTime, 3, values, buffer);
+    ASSERT_EQ(10U, values.size());
+    EXPECT_EQ(31000U, values[0]);
+    EXPECT_EQ(40000U, values[9]);
+    reader.decode(Column::Latency, 3, values, buffer);
+    EXPECT_EQ(31U, values[0]);
+}
+
+TEST(Query, filtersAndGroups)
+{
+    write_export();
+    const ColumnsReader reader{directory};
+
+    Query all;
+    all.threads   = 3;
+    Result result = run(reader, all);
+    ASSERT_EQ(1U, result.groups.size());
+    EXPECT_EQ(100U, result.groups[0].count);
+    EXPECT_EQ(100U * 110, result.groups[0].bytes);
+    EXPECT_EQ(50U, result.groups[0].latency.percentile(50));
+    EXPECT_EQ(100U, result.groups[0].latency.max());
+    EXPECT_EQ(0U, result.skipped);
+
+    Query range;
+    range.time.min = 15000;
+    range.time.max = 24000;
+    result = run(reader, range);
+    EXPECT_EQ(10U, result.groups[0].count);
+    EXPECT_EQ(8U, result.skipped); // only blocks 1 and 2 are decoded
+
+    Query errors;
+    errors.status.min = 1;
+    errors.group      = Group::Procedure;
+    result = run(reader, errors);
+    ASSERT_EQ(2U, result.groups.size());
+    EXPECT_EQ(5U, result.groups[0].count);
+    EXPECT_EQ(5U, result.groups[1].count);
+
+    Query session;
+    session.sessions = {0, 1, 0}; // session 88
+    session.group    = Group::Session;
+    result = run(reader, session);
+    EXPECT_EQ(0U, result.groups[0].count);
+    EXPECT_EQ(50U, result.groups[1].count);
+    EXPECT_EQ(5U, result.skipped);
+}
+
+TEST(Query, latencyHistogram)
+{
+    LatencyHistogram histogram;
+    for(uint64_t v = 1; v <= 1000000; ++v)
+    {
+        histogram.add(v);
+    }
+    EXPECT_EQ(1000000U, histogram.max());
+    const uint64_t p99{histogram.percentile(99)};
+    EXPECT_LE(p99, 990000U);
+    EXPECT_GE(p99, 990000U * 0.97);
+    EXPECT_EQ(LatencyHistogram::lower_bound(LatencyHistogram::bucket(12345)),
+              12345U & ~uint64_t{(1U << (13 - LatencyHistogram::sub_bits)) - 1});
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for JSON service of JSON analyzer
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "json_analyzer.h"
+//------------------------------------------------------------------------------
+using NST::API::HeaderEvent;
+using NST::API::OpRecord;
+using NST::API::Protocol;
+using NST::API::Session;
+//------------------------------------------------------------------------------
+namespace
+{
+constexpr int port{18989};
+
+//! Sends HTTP/1.0 request, so the service closes connection after response
+std::string request(const std::string& target)
+{
+    const int   s = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family      = AF_INET;
+    address.sin_port        = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    std::string response;
+    if(connect(s, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0)
+    {
+        const std::string message{"GET " + target + " HTTP/1.0\r\n\r\n"};
+        send(s, message.data(), message.size(), 0);
+        char    buffer[4096];
+        ssize_t received;
+        while((received = recv(s, buffer, sizeof(buffer), 0)) > 0)
+        {
+            response.append(buffer, received);
+        }
+    }
+    close(s);
+    return response;
+}
+
+//! Returns body of response
+std::string body(const std::string& response)
+{
+    const std::size_t end = response.find("\r\n\r\n");
+    return end == std::string::npos ? std::string{} : response.substr(end + 4);
+}
+
+//! Returns generation of JSON
+uint64_t generation(const std::string& json)
+{
+    const std::size_t position = json.find("\"generation\":");
+    return position == std::string::npos ? 0 : std::stoull(json.substr(position + 13));
+}
+
+HeaderEvent event(const Session& session, Protocol protocol, uint32_t procedure, int64_t latency)
+{
+    HeaderEvent e{};
+    e.session    = &session;
+    e.protocol   = protocol;
+    e.procedure  = procedure;
+    e.call_time  = 1000000000;
+    e.reply_time = e.call_time + latency;
+    e.call_size  = 100;
+    e.reply_size = 1000;
+    return e;
+}
+}
+//------------------------------------------------------------------------------
+TEST(JsonService, metrics)
+{
+    JsonAnalyzer analyzer{1, port, "127.0.0.1", 500, 15, 5000, 16, 10, 4, 10, 60, 10, 1000};
+
+    Session session{};
+    session.type          = Session::TCP;
+    session.ip_type       = Session::v4;
+    session.ip.v4.addr[0] = inet_addr("10.0.0.1");
+    session.ip.v4.addr[1] = inet_addr("10.0.0.2");
+
+    const HeaderEvent events[] = {
+        event(session, Protocol::NFSv3, ProcEnumNFS3::READ, 50000),
+        event(session, Protocol::NFSv3, ProcEnumNFS3::READ, 2000000),
+        event(session, Protocol::NFSv3, ProcEnumNFS3::READ, 20000000000),
+        event(session, Protocol::NFSv41, ProcEnumNFS41::COMPOUND, 1000),
+        event(session, Protocol::SMBv2, 0, 1000)};
+    analyzer.headers(events, sizeof(events) / sizeof(events[0]));
+
+    // Metrics are published with interval, so they are requested until they are refreshed
+    std::string response;
+    for(int attempt = 0; attempt < 100 && response.find("procedure=\"read\"") == std::string::npos; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        response = request("/metrics");
+    }
+    const std::string labels{"{protocol=\"nfs_v3\",procedure=\"read\",client=\"10.0.0.1\",server=\"10.0.0.2\""};
+
+    EXPECT_EQ(0U, response.find("HTTP/1.1 200 OK\r\nContent-Type: application/openmetrics-text; version=1.0.0"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_requests_total" + labels + "} 3\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_request_bytes_total" + labels + "} 300\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_response_bytes_total" + labels + "} 3000\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_latency_seconds_bucket" + labels + ",le=\"0.0001\"} 1\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_latency_seconds_bucket" + labels + ",le=\"0.001\"} 1\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_latency_seconds_bucket" + labels + ",le=\"0.0025\"} 2\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_latency_seconds_bucket" + labels + ",le=\"10.0\"} 2\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_latency_seconds_bucket" + labels + ",le=\"+Inf\"} 3\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_latency_seconds_count" + labels + "} 3\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_latency_seconds_sum" + labels + "} 20.002050000\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_requests_total{protocol=\"nfs_v41\",procedure=\"compound\",client=\"10.0.0.1\",server=\"10.0.0.2\"} 1\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_operations_total{protocol=\"nfs_v40\",operation=\"read\"} 0\n"));
+    EXPECT_EQ(std::string::npos, response.find("unknown"));
+    EXPECT_EQ(response.size() - 6, response.rfind("# EOF\n"));
+
+    // Reconnected client is accounted to the same series, totals keep growing between scrapes
+    Session reconnected = session;
+    reconnected.id      = session.id + 1;
+
+    const HeaderEvent more[] = {event(reconnected, Protocol::NFSv3, ProcEnumNFS3::READ, 50000)};
+    analyzer.headers(more, 1);
+    for(int attempt = 0; attempt < 100 && response.find("\nnfstrace_requests_total" + labels + "} 4\n") == std::string::npos; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        response = request("/metrics");
+    }
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_requests_total" + labels + "} 4\n"));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_latency_seconds_bucket" + labels + ",le=\"0.0001\"} 2\n"));
+    EXPECT_EQ(response.find("nfstrace_requests_total" + labels), response.rfind("nfstrace_requests_total" + labels));
+
+    // JSON is still served by other targets
+    response = request("/");
+    EXPECT_EQ(0U, response.find("HTTP/1.1 200 OK\r\nContent-Type: application/json"));
+    EXPECT_NE(std::string::npos, response.find("\r\n\r\n{\"nfs_v3\":{\"null\":0,"));
+}
+
+TEST(JsonService, metricsOfOtherHosts)
+{
+    JsonAnalyzer analyzer{1, port, "127.0.0.1", 500, 15, 5000, 16, 10, 4, 10, 60, 10, 1};
+
+    Session first{};
+    first.type          = Session::TCP;
+    first.ip_type       = Session::v4;
+    first.ip.v4.addr[0] = inet_addr("10.0.0.1");
+    first.ip.v4.addr[1] = inet_addr("10.0.0.2");
+    Session second       = first;
+    second.id            = first.id + 1;
+    second.ip.v4.addr[0] = inet_addr("10.0.0.3");
+    Session third       = second;
+    third.id            = first.id + 2;
+    third.ip.v4.addr[0] = inet_addr("10.0.0.4");
+
+    const HeaderEvent events[] = {
+        event(first, Protocol::NFSv3, ProcEnumNFS3::READ, 1000),
+        event(second, Protocol::NFSv3, ProcEnumNFS3::READ, 1000),
+        event(third, Protocol::NFSv3, ProcEnumNFS3::READ, 1000)};
+    analyzer.headers(events, sizeof(events) / sizeof(events[0]));
+
+    // Pairs of hosts over the limit share labels of one series
+    const std::string other{"\nnfstrace_requests_total{protocol=\"nfs_v3\",procedure=\"read\",client=\"other\",server=\"other\"} 2\n"};
+    std::string       response;
+    for(int attempt = 0; attempt < 100 && response.find(other) == std::string::npos; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        response = request("/metrics");
+    }
+    EXPECT_NE(std::string::npos, response.find(other));
+    EXPECT_NE(std::string::npos, response.find("\nnfstrace_requests_total{protocol=\"nfs_v3\",procedure=\"read\",client=\"10.0.0.1\",server=\"10.0.0.2\"} 1\n"));
+    EXPECT_EQ(std::string::npos, response.find("10.0.0.3"));
+}
+
+TEST(JsonService, deltas)
+{
+    JsonAnalyzer analyzer{1, port, "127.0.0.1", 500, 15, 5000, 16, 20, 100, 10, 60, 1000, 1000};
+
+    const std::string full  = body(request("/"));
+    const std::string since = std::to_string(generation(full));
+    ASSERT_NE(0U, generation(full));
+    EXPECT_EQ(std::string::npos, full.find("\"since\":"));
+
+    // Nothing is changed since the generation
+    std::string delta = body(request("/?since=" + since));
+    EXPECT_EQ(0U, delta.find("{\"generation\":"));
+    EXPECT_EQ(delta.size() - since.size() - 10, delta.rfind(",\"since\":" + since + "}"));
+
+    analyzer.getattr3(nullptr, nullptr, nullptr);
+    analyzer.getattr3(nullptr, nullptr, nullptr);
+    for(int attempt = 0; attempt < 100 && delta.find("getattr") == std::string::npos; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        delta = body(request("/?since=" + since));
+    }
+    EXPECT_EQ(0U, delta.find("{\"nfs_v3\":{\"getattr\":2},\"generation\":"));
+    EXPECT_LT(generation(full), generation(delta));
+    EXPECT_NE(std::string::npos, delta.find(",\"since\":" + since + "}"));
+
+    // Unknown generations get full JSON
+    EXPECT_EQ(0U, body(request("/?since=0")).find("{\"nfs_v3\":{\"null\":0,\"getattr\":2,"));
+    EXPECT_EQ(std::string::npos, body(request("/?since=" + std::to_string(generation(delta) + 1000))).find("\"since\":"));
+
+    EXPECT_EQ(0U, request("/?since=first").find("HTTP/1.1 400 Bad Request"));
+}
+
+TEST(JsonService, top)
+{
+    JsonAnalyzer analyzer{1, port, "127.0.0.1", 500, 15, 5000, 16, 10, 4, 2, 0, 1000, 1000};
+
+    Session first{};
+    first.ip_type       = Session::v4;
+    first.ip.v4.addr[0] = inet_addr("10.0.0.1");
+    Session second{};
+    second.ip_type       = Session::v4;
+    second.ip.v4.addr[0] = inet_addr("10.0.0.3");
+
+    const HeaderEvent events[] = {
+        event(first, Protocol::NFSv3, ProcEnumNFS3::READ, 1000),
+        event(second, Protocol::NFSv3, ProcEnumNFS3::READ, 1000),
+        event(second, Protocol::NFSv3, ProcEnumNFS3::WRITE, 1000)};
+    analyzer.headers(events, sizeof(events) / sizeof(events[0]));
+
+    OpRecord records[3]{};
+    records[0].fh = 0xab;
+    records[1].fh = 0xab;
+    analyzer.records(records, 3); // the last one has no file handle
+
+    std::string response;
+    for(int attempt = 0; attempt < 100 && response.find("10.0.0.3") == std::string::npos; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        response = request("/top");
+    }
+    EXPECT_EQ(0U, response.find("HTTP/1.1 200 OK\r\nContent-Type: application/json"));
+    EXPECT_EQ("{\"clients\":[{\"address\":\"10.0.0.3\",\"operations\":2,\"error\":0},"
+              "{\"address\":\"10.0.0.1\",\"operations\":1,\"error\":0}],"
+              "\"files\":[{\"fh\":\"00000000000000ab\",\"operations\":2,\"error\":0}]}",
+              body(response));
+}
+
+TEST(JsonService, halfClosedConnection)
+{
+    JsonAnalyzer analyzer{1, port, "127.0.0.1", 500, 15, 5000, 16, 10, 4, 2, 0, 1000, 1000};
+
+    std::string response;
+    for(int attempt = 0; attempt < 100 && response.empty(); ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+        const int   s = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family      = AF_INET;
+        address.sin_port        = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if(connect(s, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0)
+        {
+            // keep-alive requests are sent at once, then client shuts down sending like `nc -N`,
+            // requests are corked, so they are received together with end of stream
+            const std::string message{"GET / HTTP/1.1\r\n\r\nGET /top HTTP/1.1\r\n\r\n"};
+            const int         cork{1};
+            setsockopt(s, IPPROTO_TCP, TCP_CORK, &cork, sizeof(cork));
+            send(s, message.data(), message.size(), 0);
+            shutdown(s, SHUT_WR);
+            char    buffer[4096];
+            ssize_t received;
+            while((received = recv(s, buffer, sizeof(buffer), 0)) > 0)
+            {
+                response.append(buffer, received);
+            }
+        }
+        close(s);
+    }
+    const std::size_t second{response.find("HTTP/1.1 200 OK", 1)};
+    EXPECT_EQ(0U, response.find("HTTP/1.1 200 OK"));
+    ASSERT_NE(std::string::npos, second);
+    EXPECT_NE(std::string::npos, response.find("{\"clients\":[]", second));
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Tests of reading requirements of plugins of different API versions
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <gtest/gtest.h>
+
+#include "analysis/plugin.h"
+//------------------------------------------------------------------------------
+using NST::analysis::Plugin;
+//------------------------------------------------------------------------------
+namespace
+{
+const AnalyzerRequirements* requirements()
+{
+    static const AnalyzerRequirements r{false, AnalyzerSubscription{}, AnalyzerThreading::PerThread, AnalyzerOverflow::Block};
+    return &r;
+}
+} // unnamed namespace
+
+TEST(Plugin, requirementsOfLaterReleases)
+{
+    // Plugin built against 0.5.0 is loaded by current and any later release
+    const AnalyzerRequirements* r = Plugin::requirements_of(requirements, NST_PLUGIN_API_VERSION_0_5);
+    ASSERT_NE(nullptr, r);
+    EXPECT_EQ(AnalyzerThreading::PerThread, r->threading);
+    EXPECT_EQ(AnalyzerOverflow::Block, r->overflow);
+
+    EXPECT_EQ(requirements(), Plugin::requirements_of(requirements, NST_PLUGIN_API_VERSION));
+    EXPECT_EQ(requirements(), Plugin::requirements_of(requirements, NST_PLUGIN_API_VERSION + 100));
+}
+
+TEST(Plugin, requirementsOfOldReleases)
+{
+    EXPECT_EQ(nullptr, Plugin::requirements_of(requirements, NST_PLUGIN_API_VERSION_0_4));
+    EXPECT_EQ(nullptr, Plugin::requirements_of(requirements, NST_PLUGIN_API_VERSION_0_5 - 1));
+    EXPECT_EQ(nullptr, Plugin::requirements_of(nullptr, NST_PLUGIN_API_VERSION_0_5));
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for RingExporter and OpRingReader
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <chrono>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "analysis/ring_exporter.h"
+#include "api/op_ring.h"
+//------------------------------------------------------------------------------
+using namespace NST::analysis;
+using NST::API::OpRingReader;
+using NST::API::OP_RING_READERS;
+//------------------------------------------------------------------------------
+namespace
+{
+const char* const path{"nst_unit_test_ring"};
+
+void publish(RingExporter& exporter, uint64_t first, std::size_t count)
+{
+    OpRecord batch[16] = {};
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        batch[i].id = first + i;
+    }
+    exporter.records(batch, count);
+}
+}
+//------------------------------------------------------------------------------
+TEST(RingExporter, readerGetsRecordsPublishedAfterAttach)
+{
+    RingExporter exporter{path, 16};
+    publish(exporter, 1, 8); // nobody reads them
+
+    OpRingReader reader{path};
+    OpRecord     records[16];
+    EXPECT_EQ(0U, reader.read(records, 16));
+
+    publish(exporter, 100, 10);
+    ASSERT_EQ(4U, reader.read(records, 4)); // part of available records
+    ASSERT_EQ(6U, reader.read(records + 4, 16));
+    for(uint64_t i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(100 + i, records[i].id);
+    }
+    EXPECT_EQ(0U, reader.lost());
+}
+
+TEST(RingExporter, slowReaderLosesOverwrittenRecords)
+{
+    RingExporter exporter{path, 4};
+    OpRingReader reader{path};
+
+    publish(exporter, 1, 10);
+    OpRecord records[16];
+    ASSERT_EQ(4U, reader.read(records, 16));
+    EXPECT_EQ(7U, records[0].id);
+    EXPECT_EQ(10U, records[3].id);
+    EXPECT_EQ(6U, reader.lost());
+}
+
+TEST(RingExporter, readerRequiresRing)
+{
+    EXPECT_THROW(OpRingReader{"nst_unit_test_absent_ring"}, std::system_error);
+    {
+        RingExporter exporter{path, 4};
+    }
+    EXPECT_THROW(OpRingReader{path}, std::system_error); // the ring is removed by exporter
+}
+
+TEST(RingExporter, killedReaderIsDetachedByTimeout)
+{
+    RingExporter exporter{path, 16, 100};
+    const pid_t  child{fork()};
+    ASSERT_NE(-1, child);
+    if(child == 0)
+    {
+        OpRingReader reader{path};
+        _exit(0); // the reader is not destroyed
+    }
+    int status{0};
+    ASSERT_EQ(child, waitpid(child, &status, 0));
+    EXPECT_EQ(1U, exporter.attached());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{150});
+    EXPECT_EQ(0U, exporter.attached());
+
+    OpRingReader reader{path}; // the slot of killed reader is reused
+    EXPECT_EQ(1U, exporter.attached());
+}
+
+TEST(RingExporter, limitedAmountOfReaders)
+{
+    RingExporter exporter{path, 4};
+
+    std::vector<std::unique_ptr<OpRingReader>> readers;
+    for(uint32_t i = 0; i < OP_RING_READERS; ++i)
+    {
+        readers.emplace_back(new OpRingReader{path});
+    }
+    EXPECT_EQ(std::size_t{OP_RING_READERS}, exporter.attached());
+    EXPECT_THROW(OpRingReader{path}, std::system_error);
+
+    readers.pop_back();
+    EXPECT_EQ(std::size_t{OP_RING_READERS} - 1, exporter.attached());
+    EXPECT_NO_THROW(OpRingReader{path});
+}
+//------------------------------------------------------------------------------
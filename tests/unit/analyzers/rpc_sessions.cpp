@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for expiration of RPC calls of sessions
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "analysis/rpc_sessions.h"
+//------------------------------------------------------------------------------
+using namespace NST::analysis;
+using NST::protocols::rpc::MsgType;
+using NST::utils::FilteredDataQueue;
+using NST::utils::NetworkSession;
+//------------------------------------------------------------------------------
+namespace
+{
+constexpr std::int64_t second{1000000000};
+}
+//------------------------------------------------------------------------------
+TEST(Sessions, sweepExpiresCallsOfIdleSessions)
+{
+    FilteredDataQueue queue{4, 1};
+    NetworkSession    idle_network;
+    NetworkSession    active_network;
+
+    Sessions<Session> sessions;
+    Session*          idle{sessions.get_session(&idle_network, NST::utils::Session::Source, MsgType::CALL)};
+    Session*          active{sessions.get_session(&active_network, NST::utils::Session::Source, MsgType::CALL)};
+    ASSERT_NE(nullptr, idle);
+    ASSERT_NE(nullptr, active);
+
+    queue.push(queue.allocate());
+    queue.push(queue.allocate());
+    FilteredDataQueue::List list{queue};
+    FilteredDataQueue::Ptr  old_call{list.get_current()};
+    FilteredDataQueue::Ptr  new_call{list.get_current()};
+
+    old_call->timestamp = 10 * second;
+    sessions.sweep(old_call->timestamp);
+    idle->save_call_data(1, std::move(old_call));
+
+    new_call->timestamp = 100 * second;
+    sessions.sweep(new_call->timestamp);
+    active->save_call_data(2, std::move(new_call));
+
+    // the idle session gets no messages, its call is expired by messages of others
+    sessions.sweep(125 * second);
+    sessions.sweep(135 * second);
+    EXPECT_EQ(1U, idle->unmatched_calls());
+    EXPECT_FALSE(idle->get_call_data(1));
+    EXPECT_TRUE(bool(active->get_call_data(2)));
+    EXPECT_EQ(0U, active->unmatched_calls());
+}
+//------------------------------------------------------------------------------
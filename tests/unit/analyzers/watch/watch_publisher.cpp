@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for shared memory segment of watch plugin
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <api/watch_segment.h>
+
+#include "watch_publisher.h"
+//------------------------------------------------------------------------------
+using NST::API::WatchSegmentReader;
+//------------------------------------------------------------------------------
+namespace
+{
+const char* const path{"nst_unit_test_watch_segment"};
+
+class TestProtocol : public AbstractProtocol
+{
+public:
+    TestProtocol(const char* name, std::size_t amount)
+        : AbstractProtocol{name, amount}
+    {
+    }
+    const char* printProcedure(std::size_t i) override
+    {
+        static const char* const names[] = {"NULL", "COMPOUND", "ACCESS"};
+        return i < 3 ? names[i] : nullptr;
+    }
+    std::size_t getGroups() override { return 2; }
+    std::size_t getGroupBegin(std::size_t i) override { return i == 1 ? 0 : i == 2 ? 2 : getAmount(); }
+};
+}
+//------------------------------------------------------------------------------
+TEST(WatchPublisher, viewerReadsDescriptorsAndCounters)
+{
+    TestProtocol                   v4{"NFS v4", 3};
+    AbstractProtocol               v3{"NFS v3", 2};
+    std::vector<AbstractProtocol*> protocols{&v4, &v3};
+
+    auto source = [&v4](AbstractProtocol* p, std::vector<uint64_t>& values) {
+        values = p == &v4 ? std::vector<uint64_t>{1, 2, 3} : std::vector<uint64_t>{40, 50};
+    };
+    std::unique_ptr<WatchPublisher> publisher{new WatchPublisher{path, 10, protocols, source}};
+
+    const WatchSegmentReader reader{path};
+    ASSERT_EQ(2U, reader.protocols());
+    EXPECT_STREQ("NFS v4", reader.protocol(0).name);
+    EXPECT_EQ(0U, reader.protocol(0).first);
+    EXPECT_EQ(3U, reader.protocol(0).amount);
+    EXPECT_EQ(2U, reader.protocol(0).groups);
+    EXPECT_EQ(0U, reader.protocol(0).group_begins[0]);
+    EXPECT_EQ(2U, reader.protocol(0).group_begins[1]);
+    EXPECT_STREQ("NFS v3", reader.protocol(1).name);
+    EXPECT_EQ(3U, reader.protocol(1).first);
+    EXPECT_EQ(1U, reader.protocol(1).groups);
+    EXPECT_STREQ("ACCESS", reader.counter_name(2));
+    EXPECT_STREQ("", reader.counter_name(3)); // AbstractProtocol has no names
+    EXPECT_EQ(10U, reader.refresh_ms());
+
+    std::vector<uint64_t> values;
+    bool                  stale{false};
+    while(reader.read(values, stale) == 0) // nothing is published yet
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    EXPECT_EQ((std::vector<uint64_t>{1, 2, 3, 40, 50}), values);
+    EXPECT_FALSE(stale);
+    EXPECT_TRUE(reader.running());
+
+    publisher.reset(); // the file is removed, the viewer keeps its mapping
+    EXPECT_FALSE(reader.running());
+    EXPECT_THROW(WatchSegmentReader{path}, std::system_error);
+}
+//------------------------------------------------------------------------------
+TEST(WatchPublisher, viewerDoesNotWaitForDeadWriter)
+{
+    // segment of a writer killed in the middle of publishing
+    const int fd{open(path, O_RDWR | O_CREAT | O_TRUNC, 0600)};
+    ASSERT_LE(0, fd);
+    ASSERT_EQ(0, ftruncate(fd, NST::API::watch_segment_size(0, 1)));
+    void* map{mmap(nullptr, NST::API::watch_segment_size(0, 1), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)};
+    close(fd);
+    ASSERT_NE(MAP_FAILED, map);
+    auto* header     = static_cast<NST::API::WatchSegmentHeader*>(map);
+    header->version  = NST::API::WATCH_SEGMENT_VERSION;
+    header->counters = 1;
+    header->sequence = 1;
+    header->running  = 1;
+    header->magic    = NST::API::WATCH_SEGMENT_MAGIC;
+
+    const WatchSegmentReader reader{path};
+    std::vector<uint64_t>    values;
+    bool                     stale{false};
+    const auto               start = std::chrono::steady_clock::now();
+    reader.read(values, stale);
+    EXPECT_TRUE(stale);
+    EXPECT_EQ(1U, values.size());
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{NST::API::WATCH_SEGMENT_PUBLISH_MS});
+
+    header->running = 0; // the writer has stopped, it isn't awaited
+    reader.read(values, stale);
+    EXPECT_TRUE(stale);
+
+    munmap(map, NST::API::watch_segment_size(0, 1));
+    unlink(path);
+}
+//------------------------------------------------------------------------------
@@ -81,6 +81,14 @@ public:
             }
         }
 
+        void set_msg_len(const uint32_t /*len*/)
+        {
+        }
+
+        void set_descriptor(const NST::utils::MessageDescriptor& /*descriptor*/)
+        {
+        }
+
         operator bool()
         {
             return true;
@@ -167,7 +175,7 @@ TEST(Filtration, filtratorsResets)
 TEST(Filtration, pushRPCheader)
 {
     // Prepare data
-    struct pcap_pkthdr header;
+    struct pcap_pkthdr header{};
     header.caplen = header.len = 16;
     const uint8_t packet[]     = {0x80, 0x00, 0x00, 0x84,
                               0xec, 0x8a, 0x42, 0xcb,
@@ -197,7 +205,7 @@ TEST(Filtration, pushRPCheader)
 TEST(Filtration, pushCIFSheader)
 {
     // Prepare data
-    struct pcap_pkthdr header;
+    struct pcap_pkthdr header{};
     header.caplen = header.len = 16;
     const uint8_t packet[]     = {0x00, 0x00, 0x00, 0x68,
                               0xfe, 0x53, 0x4d, 0x42,
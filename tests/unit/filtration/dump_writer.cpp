@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for DumpWriter
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "filtration/pcap/dump_writer.h"
+//------------------------------------------------------------------------------
+using NST::filtration::pcap::DumpWriter;
+//------------------------------------------------------------------------------
+namespace
+{
+class DumpWriterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char path[] = "/tmp/nst_dump_writer_XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(path));
+        directory = path;
+        base      = directory + "/dump.pcap";
+    }
+    void TearDown() override
+    {
+        for(const char* suffix : {"", "-1", "-2", "-3", "-1.tmp", "-2.tmp", "-3.tmp"})
+        {
+            unlink((base + suffix).c_str());
+        }
+        rmdir(directory.c_str());
+    }
+
+    //! Dumps packet of given length filled by its number
+    static void dump(DumpWriter& writer, uint32_t number, uint32_t length)
+    {
+        std::vector<u_char> packet(length, static_cast<u_char>(number));
+        pcap_pkthdr         header{};
+        header.ts.tv_sec  = number;
+        header.ts.tv_usec = 500;
+        header.caplen     = length;
+        header.len        = length + 4;
+        writer.dump(&header, packet.data());
+    }
+
+    static std::vector<uint8_t> read(const std::string& path)
+    {
+        std::ifstream file{path, std::ios::binary};
+        return std::vector<uint8_t>{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    //! Checks records of packets dumped by dump() from offset, returns amount of them
+    static std::size_t records(const std::vector<uint8_t>& file, std::size_t offset, uint32_t first)
+    {
+        std::size_t amount{0};
+        while(offset + sizeof(DumpWriter::Record) <= file.size())
+        {
+            DumpWriter::Record record;
+            std::memcpy(&record, &file[offset], sizeof(record));
+            offset += sizeof(record);
+            EXPECT_EQ(first + amount, record.ts_sec);
+            EXPECT_EQ(500U, record.ts_frac);
+            EXPECT_EQ(record.caplen + 4, record.len);
+            EXPECT_LE(offset + record.caplen, file.size());
+            EXPECT_EQ(static_cast<uint8_t>(record.ts_sec), file[offset]);
+            EXPECT_EQ(static_cast<uint8_t>(record.ts_sec), file[offset + record.caplen - 1]);
+            offset += record.caplen;
+            ++amount;
+        }
+        EXPECT_EQ(file.size(), offset);
+        return amount;
+    }
+
+    std::string directory;
+    std::string base;
+};
+} // unnamed namespace
+
+TEST_F(DumpWriterTest, pcapFile)
+{
+    {
+        DumpWriter writer{base, 1, 65535, true, false, nullptr};
+        dump(writer, 1, 60);
+        dump(writer, 2, 1514);
+    }
+    const std::vector<uint8_t> file = read(base);
+    ASSERT_EQ(24 + 2 * sizeof(DumpWriter::Record) + 60 + 1514, file.size());
+
+    uint32_t header[6];
+    std::memcpy(header, file.data(), sizeof(header));
+    EXPECT_EQ(0xa1b23c4dU, header[0]); // nanoseconds
+    EXPECT_EQ(0x00040002U, header[1]); // version 2.4
+    EXPECT_EQ(65535U, header[4]);
+    EXPECT_EQ(1U, header[5]);
+    EXPECT_EQ(2U, records(file, 24, 1));
+}
+
+TEST_F(DumpWriterTest, packetsSpanChunks)
+{
+    const uint32_t amount{3 * DumpWriter::chunk_size / 65535};
+    {
+        DumpWriter writer{base, 1, 65535, false, false, nullptr};
+        for(uint32_t i = 0; i < amount; ++i)
+        {
+            dump(writer, i, 65535 - i % 7);
+        }
+    }
+    const std::vector<uint8_t> file = read(base);
+    EXPECT_LT(2 * DumpWriter::chunk_size, file.size());
+    EXPECT_EQ(amount, records(file, 24, 0));
+}
+
+TEST_F(DumpWriterTest, rotation)
+{
+    std::vector<std::string> closed;
+    {
+        DumpWriter writer{base, 1, 65535, false, true, [&closed](const std::string& path) { closed.push_back(path); }};
+        dump(writer, 1, 100);
+        writer.rotate();
+        dump(writer, 2, 200);
+        dump(writer, 3, 300);
+        writer.rotate();
+        dump(writer, 4, 400);
+    }
+    EXPECT_EQ((std::vector<std::string>{base, base + "-1", base + "-2"}), closed);
+
+    EXPECT_EQ(1U, records(read(base), 24, 1));
+    EXPECT_EQ(2U, records(read(base + "-1"), 0, 2)); // next parts have no pcap header
+    EXPECT_EQ(1U, records(read(base + "-2"), 0, 4));
+    EXPECT_NE(0, access((base + "-3").c_str(), F_OK)); // opened in advance and removed
+    EXPECT_NE(0, access((base + "-3.tmp").c_str(), F_OK));
+}
+
+TEST_F(DumpWriterTest, rotationKeepsNotReachedFiles)
+{
+    {
+        std::ofstream previous{base + "-1"};
+        previous << "previous capture";
+    }
+    {
+        DumpWriter writer{base, 1, 65535, false, true, nullptr};
+        dump(writer, 1, 100);
+    }
+    EXPECT_EQ(1U, records(read(base), 24, 1));
+    const std::vector<uint8_t> previous = read(base + "-1");
+    EXPECT_EQ("previous capture", std::string(previous.begin(), previous.end()));
+    EXPECT_NE(0, access((base + "-1.tmp").c_str(), F_OK));
+}
+//------------------------------------------------------------------------------
@@ -73,6 +73,14 @@ public:
             }
         }
 
+        void set_msg_len(const uint32_t /*len*/)
+        {
+        }
+
+        void set_descriptor(const NST::utils::MessageDescriptor& /*descriptor*/)
+        {
+        }
+
         operator bool()
         {
             return true;
@@ -114,7 +122,7 @@ public:
 TEST(Filtration, pushCIFSbyTCPStream)
 {
     // Prepare data
-    struct pcap_pkthdr header;
+    struct pcap_pkthdr header{};
     header.caplen = header.len = 132;
     const uint8_t packet[]     = {0x00, 0x00, 0x00, 0x80,
                               0xfe, 0x53, 0x4d, 0x42,
@@ -172,7 +180,7 @@ TEST(Filtration, pushCIFSbyTCPStream)
 TEST(Filtration, pushCIFSbyTCPStreamPartByPart)
 {
     // Prepare data
-    struct pcap_pkthdr header1;
+    struct pcap_pkthdr header1{};
     header1.caplen = header1.len = 3;
     const uint8_t packet[]       = {0x00, 0x00, 0x00, 0x80,
                               0xfe, 0x53, 0x4d, 0x42,
@@ -217,7 +225,7 @@ TEST(Filtration, pushCIFSbyTCPStreamPartByPart)
                               0x00, 0x00, 0x00, 0x00};
     PacketInfo info1(&header1, packet, 0);
 
-    struct pcap_pkthdr header2;
+    struct pcap_pkthdr header2{};
     header2.caplen = header2.len = sizeof(packet) - header1.len;
     PacketInfo info2(&header2, packet + header1.len, 0);
     Writer     mock;
@@ -236,7 +244,7 @@ TEST(Filtration, pushCIFSbyTCPStreamPartByPart)
 TEST(Filtration, pushRPCbyTCPStream)
 {
     // Prepare data
-    struct pcap_pkthdr header;
+    struct pcap_pkthdr header{};
     header.caplen = header.len = 132;
     const uint8_t packet[]     = {0x80, 0x00, 0x00, 0x80,
                               0xec, 0x8a, 0x42, 0xcb,
@@ -294,7 +302,7 @@ TEST(Filtration, pushRPCbyTCPStream)
 TEST(Filtration, pushRPCbyTCPStreamPartByPart)
 {
     // Prepare data
-    struct pcap_pkthdr header1;
+    struct pcap_pkthdr header1{};
     header1.caplen = header1.len = 3;
     const uint8_t packet[]       = {0x80, 0x00, 0x00, 0x80,
                               0xec, 0x8a, 0x42, 0xcb,
@@ -339,7 +347,7 @@ TEST(Filtration, pushRPCbyTCPStreamPartByPart)
                               0x00, 0x00, 0x00, 0x00};
     PacketInfo info1(&header1, packet, 0);
 
-    struct pcap_pkthdr header2;
+    struct pcap_pkthdr header2{};
     header2.caplen = header2.len = sizeof(packet) - header1.len;
     PacketInfo info2(&header2, packet + header1.len, 0);
     Writer     mock;
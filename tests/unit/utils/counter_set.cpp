@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for CounterSet
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <api/counter_set.h>
+//------------------------------------------------------------------------------
+using namespace NST::API;
+//------------------------------------------------------------------------------
+TEST(CounterSet, sumOfWriters)
+{
+    CounterSet            set{3};
+    std::vector<uint64_t> values;
+    set.snapshot(values);
+    EXPECT_EQ(std::vector<uint64_t>(3, 0), values);
+
+    std::vector<std::thread> writers;
+    for(int t = 0; t < 4; ++t)
+    {
+        writers.emplace_back([&set]() {
+            for(int i = 0; i < 1000; ++i)
+            {
+                set.add(0);
+                set.add(2, 3);
+            }
+        });
+    }
+    for(auto& w : writers)
+    {
+        w.join();
+    }
+
+    set.snapshot(values);
+    EXPECT_EQ((std::vector<uint64_t>{4000, 0, 12000}), values);
+}
+
+TEST(CounterSet, sharedSlotOfExtraWriters)
+{
+    CounterSet set{1};
+    for(std::size_t t = 0; t < CounterSet::MaxWriters + 8; ++t)
+    {
+        std::thread([&set]() { set.add(0); }).join();
+    }
+
+    std::vector<uint64_t> values;
+    set.snapshot(values);
+    EXPECT_EQ(uint64_t{CounterSet::MaxWriters + 8}, values[0]);
+}
+
+TEST(CounterSet, batchesAreNotTorn)
+{
+    CounterSet        set{20}; // the last counter is in the next cache line of slot
+    std::atomic<bool> done{false};
+    const uint64_t    n{200000};
+
+    std::vector<std::thread> writers;
+    for(int t = 0; t < 2; ++t)
+    {
+        writers.emplace_back([&set, n]() {
+            for(uint64_t i = 0; i < n; ++i)
+            {
+                CounterSet::Batch batch{set};
+                batch.add(0);
+                batch.add(19);
+            }
+        });
+    }
+    std::thread reader([&set, &done]() {
+        std::vector<uint64_t> values;
+        while(!done.load())
+        {
+            set.snapshot(values);
+            ASSERT_EQ(values[0], values[19]);
+        }
+    });
+    for(auto& w : writers)
+    {
+        w.join();
+    }
+    done = true;
+    reader.join();
+
+    std::vector<uint64_t> values;
+    set.snapshot(values);
+    EXPECT_EQ(2 * n, values[0]);
+    EXPECT_EQ(2 * n, values[19]);
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for PendingCalls
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <utils/pending_calls.h>
+//------------------------------------------------------------------------------
+using namespace NST::utils;
+using Ptr   = std::unique_ptr<std::uint64_t>;
+using Calls = PendingCalls<Ptr>;
+//------------------------------------------------------------------------------
+TEST(PendingCalls, insertAndExtract)
+{
+    Calls calls{8};
+
+    const std::uint64_t n{1000};
+    for(std::uint64_t xid = 0; xid < n; ++xid)
+    {
+        EXPECT_FALSE(calls.insert(xid * 7, 0, Ptr{new std::uint64_t{xid}}));
+    }
+    ASSERT_EQ(n, calls.size());
+    ASSERT_GE(calls.capacity(), n * 2);
+
+    EXPECT_TRUE(calls.insert(7, 0, Ptr{new std::uint64_t{42}})); // replace
+    ASSERT_EQ(n, calls.size());
+
+    EXPECT_FALSE(calls.extract(1)); // unknown xid
+    for(std::uint64_t xid = 0; xid < n; xid += 2) // remove half, it shifts clusters
+    {
+        Ptr p{calls.extract(xid * 7)};
+        ASSERT_TRUE(bool(p));
+        EXPECT_EQ(xid, *p);
+    }
+    for(std::uint64_t xid = 1; xid < n; xid += 2)
+    {
+        Ptr p{calls.extract(xid * 7)};
+        ASSERT_TRUE(bool(p));
+        EXPECT_EQ(xid == 1 ? 42 : xid, *p);
+    }
+    EXPECT_EQ(0, calls.size());
+    EXPECT_FALSE(calls.extract(7)); // already extracted
+}
+
+TEST(PendingCalls, expire)
+{
+    Calls calls;
+
+    const std::uint64_t n{500};
+    for(std::uint64_t xid = 0; xid < n; ++xid)
+    {
+        calls.insert(xid, xid % 10, Ptr{new std::uint64_t{xid}});
+    }
+
+    EXPECT_EQ(0, calls.expire(0));
+    EXPECT_EQ(n / 2, calls.expire(5)); // stamps 0..4
+    EXPECT_EQ(n / 2, calls.size());
+
+    for(std::uint64_t xid = 0; xid < n; ++xid)
+    {
+        Ptr p{calls.extract(xid)};
+        EXPECT_EQ(xid % 10 >= 5, bool(p));
+    }
+    EXPECT_EQ(0, calls.size());
+}
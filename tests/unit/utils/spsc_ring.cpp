@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for SPSCRing
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <utils/spsc_ring.h>
+//------------------------------------------------------------------------------
+using namespace NST::utils;
+//------------------------------------------------------------------------------
+TEST(SPSCRing, fullAndEmpty)
+{
+    SPSCRing<int> ring{3};
+    ASSERT_EQ(4U, ring.capacity());
+    EXPECT_EQ(nullptr, ring.front());
+
+    for(int i = 0; i < 4; ++i)
+    {
+        int* slot = ring.slot();
+        ASSERT_NE(nullptr, slot);
+        *slot = i;
+        ring.push();
+    }
+    EXPECT_EQ(nullptr, ring.slot()); // full
+
+    for(int i = 0; i < 4; ++i)
+    {
+        int* e = ring.front();
+        ASSERT_NE(nullptr, e);
+        EXPECT_EQ(i, *e);
+        ring.pop();
+    }
+    EXPECT_EQ(nullptr, ring.front());
+}
+
+TEST(SPSCRing, producerAndConsumer)
+{
+    SPSCRing<std::uint64_t> ring{16};
+    const std::uint64_t     n{100000};
+
+    std::thread producer([&ring, n]() {
+        for(std::uint64_t i = 0; i < n; ++i)
+        {
+            std::uint64_t* slot;
+            while((slot = ring.slot()) == nullptr)
+            {
+                std::this_thread::yield();
+            }
+            *slot = i;
+            ring.push();
+        }
+    });
+
+    std::uint64_t expected{0};
+    while(expected < n)
+    {
+        if(std::uint64_t* e = ring.front())
+        {
+            ASSERT_EQ(expected, *e); // elements are received in order
+            ring.pop();
+            ++expected;
+        }
+    }
+    producer.join();
+    EXPECT_EQ(nullptr, ring.front());
+}
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Unit tests for TopKeys
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <api/top_keys.h>
+//------------------------------------------------------------------------------
+using namespace NST::API;
+//------------------------------------------------------------------------------
+namespace
+{
+constexpr uint64_t second{1000000000};
+}
+
+TEST(TopKeys, heavyHittersAmongManyKeys)
+{
+    TopKeys<uint64_t> top{64, 0};
+    uint64_t          rare{1000};
+    for(int round = 0; round < 2000; ++round)
+    {
+        for(uint64_t key = 0; key < 10; ++key)
+        {
+            top.add(key, 0);
+        }
+        for(int i = 0; i < 40; ++i)
+        {
+            top.add(rare++, 0); // every rare key is seen once
+        }
+    }
+    EXPECT_EQ(64U, top.size());
+
+    std::vector<TopKeys<uint64_t>::Entry> entries;
+    top.top(10, entries);
+    ASSERT_EQ(10U, entries.size());
+    std::vector<uint64_t> keys;
+    for(const auto& e : entries)
+    {
+        keys.push_back(e.key);
+        EXPECT_LE(2000.0, e.count);
+        EXPECT_GE(2000.0, e.count - e.error);
+    }
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ((std::vector<uint64_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), keys);
+}
+
+TEST(TopKeys, decayByHalfLife)
+{
+    TopKeys<int> top{8, second};
+    for(int i = 0; i < 100; ++i)
+    {
+        top.add(1, 0);
+        top.add(2, 2 * second);
+    }
+
+    std::vector<TopKeys<int>::Entry> entries;
+    top.top(8, entries);
+    ASSERT_EQ(2U, entries.size());
+    EXPECT_EQ(2, entries[0].key);
+    EXPECT_DOUBLE_EQ(100.0, entries[0].count);
+    EXPECT_EQ(1, entries[1].key);
+    EXPECT_DOUBLE_EQ(25.0, entries[1].count);
+    EXPECT_DOUBLE_EQ(0.0, entries[1].error);
+}
+
+TEST(TopKeys, rescaleOfLongRun)
+{
+    TopKeys<int> top{8, second};
+    top.add(1, 0, 1000.0);
+    for(uint64_t t = 0; t <= 100; ++t) // scale of weights exceeds 2^32 several times
+    {
+        top.add(2, t * second);
+    }
+
+    std::vector<TopKeys<int>::Entry> entries;
+    top.top(1, entries);
+    ASSERT_EQ(1U, entries.size());
+    EXPECT_EQ(2, entries[0].key);
+    EXPECT_NEAR(2.0, entries[0].count, 1e-9); // sum of 1 + 1/2 + 1/4 + ...
+    EXPECT_TRUE(std::isfinite(entries[0].count));
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Load generator of persistent clients of JSON analyzer
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+/*
+ * Clients keep their connections open and send the next request as soon as
+ * the response to the previous one is received, so the result is bounded by
+ * the service rather than by connection setup. Numbers of JSON analyzer are
+ * measured against a running nfstrace, e.g.:
+ *
+ * $ (bzcat traces/2sessions-tcp-wsize32k-tcp-wsize512k.pcap.bz2; sleep 9) |
+ *       nfstrace -m stat -I - -a analyzers/libjson.so#port=8888 &
+ * $ sleep 2; nfstrace-json-load 8888 100 4
+ */
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+//------------------------------------------------------------------------------
+using Clock = std::chrono::steady_clock;
+//------------------------------------------------------------------------------
+namespace
+{
+//! Client with its received but not parsed responses
+struct Client
+{
+    int         socket{-1};
+    std::string input;
+};
+
+int connectTo(uint16_t port)
+{
+    const int s{socket(AF_INET, SOCK_STREAM, 0)};
+    if(s < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "socket()"};
+    }
+    sockaddr_in address{};
+    address.sin_family      = AF_INET;
+    address.sin_port        = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(connect(s, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        const int error{errno};
+        close(s);
+        throw std::system_error{error, std::system_category(), "connect()"};
+    }
+    const int noDelay{1};
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return s;
+}
+
+//! Removes complete responses from input, returns amount of them
+std::size_t parseResponses(std::string& input)
+{
+    static const std::string contentLength{"Content-Length: "};
+
+    std::size_t responses{0};
+    for(;;)
+    {
+        const std::size_t headers{input.find("\r\n\r\n")};
+        if(headers == std::string::npos)
+        {
+            return responses;
+        }
+        const std::size_t field{input.find(contentLength)};
+        if(field == std::string::npos || field > headers)
+        {
+            throw std::runtime_error{"Response without Content-Length"};
+        }
+        const std::size_t length{std::strtoul(input.c_str() + field + contentLength.size(), nullptr, 10)};
+        if(input.size() < headers + 4 + length)
+        {
+            return responses;
+        }
+        input.erase(0, headers + 4 + length);
+        ++responses;
+    }
+}
+} // unnamed namespace
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    if(argc < 2 || argc > 5)
+    {
+        std::cerr << "Usage: nfstrace-json-load PORT [CLIENTS] [SECONDS] [TARGET]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const uint16_t    port{static_cast<uint16_t>(std::strtoul(argv[1], nullptr, 10))};
+    const std::size_t amount{argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100};
+    const double      seconds{argc > 3 ? std::strtod(argv[3], nullptr) : 4.0};
+    const std::string request{std::string{"GET "} + (argc > 4 ? argv[4] : "/") + " HTTP/1.1\r\nHost: localhost\r\n\r\n"};
+
+    try
+    {
+        const int poll{epoll_create1(0)};
+        if(poll < 0)
+        {
+            throw std::system_error{errno, std::system_category(), "epoll_create1()"};
+        }
+        std::vector<Client> clients(amount);
+        for(std::size_t i = 0; i < amount; ++i)
+        {
+            clients[i].socket = connectTo(port);
+            epoll_event event{};
+            event.events   = EPOLLIN;
+            event.data.u64 = i;
+            epoll_ctl(poll, EPOLL_CTL_ADD, clients[i].socket, &event);
+            send(clients[i].socket, request.data(), request.size(), 0);
+        }
+
+        uint64_t                      responses{0};
+        uint64_t                      errors{0};
+        char                          buffer[64 * 1024];
+        const Clock::time_point       start{Clock::now()};
+        std::chrono::duration<double> elapsed{0};
+        while(elapsed.count() < seconds)
+        {
+            epoll_event events[128];
+            const int   ready{epoll_wait(poll, events, 128, 100)};
+            for(int i = 0; i < ready; ++i)
+            {
+                Client&       client = clients[events[i].data.u64];
+                const ssize_t received{recv(client.socket, buffer, sizeof(buffer), 0)};
+                if(received <= 0) // the service has closed connection
+                {
+                    ++errors;
+                    epoll_ctl(poll, EPOLL_CTL_DEL, client.socket, nullptr);
+                    continue;
+                }
+                client.input.append(buffer, received);
+                for(std::size_t n = parseResponses(client.input); n != 0; --n)
+                {
+                    ++responses;
+                    send(client.socket, request.data(), request.size(), 0);
+                }
+            }
+            elapsed = Clock::now() - start;
+        }
+
+        for(const Client& client : clients)
+        {
+            close(client.socket);
+        }
+        close(poll);
+        std::cout << "clients: " << amount
+                  << " requests: " << responses
+                  << " errors: " << errors
+                  << " requests/s: " << static_cast<uint64_t>(responses / elapsed.count()) << std::endl;
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << "nfstrace-json-load: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+//------------------------------------------------------------------------------
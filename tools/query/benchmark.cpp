@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Benchmark of queries over synthetic export of operation columns
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <sys/stat.h>
+#include <zlib.h>
+
+#include <api/plugin_api.h>
+
+#include "columns_reader.h"
+#include "columns_writer.h"
+#include "query.h"
+//------------------------------------------------------------------------------
+using namespace columns;
+using NST::API::OpRecord;
+using Clock = std::chrono::steady_clock;
+//------------------------------------------------------------------------------
+namespace
+{
+//! xorshift64*, it is cheap enough to generate billions of rows
+class Random
+{
+public:
+    uint64_t next()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+
+private:
+    uint64_t state{88172645463325252ULL};
+};
+
+void generate(const std::string& directory, uint64_t rows)
+{
+    // typical NFSv3 workload: mostly READ, WRITE and GETATTR
+    static const uint32_t procedures[] = {
+        ProcEnumNFS3::READ, ProcEnumNFS3::READ, ProcEnumNFS3::READ, ProcEnumNFS3::WRITE,
+        ProcEnumNFS3::WRITE, ProcEnumNFS3::GETATTR, ProcEnumNFS3::GETATTR, ProcEnumNFS3::LOOKUP,
+        ProcEnumNFS3::ACCESS, ProcEnumNFS3::COMMIT, ProcEnumNFS3::READDIRPLUS, ProcEnumNFS3::CREATE,
+        ProcEnumNFS3::REMOVE, ProcEnumNFS3::SETATTR, ProcEnumNFS3::FSSTAT, ProcEnumNFS3::NFS_NULL};
+    const unsigned sessions{1024};
+
+    ColumnsWriter writer{directory, 65536, Z_BEST_SPEED};
+    Random        random;
+    OpRecord      record{};
+    record.version   = NST::API::OP_RECORD_VERSION;
+    record.size      = sizeof(record);
+    record.protocol  = Protocol::NFSv3;
+    record.call_time = 1500000000ULL * 1000000000ULL;
+
+    for(uint64_t i = 0; i < rows; ++i)
+    {
+        const uint64_t r{random.next()};
+        record.call_time += 1000 + (r & 0x3ff); // about million calls per second
+        const uint64_t l{random.next()}; // latency doesn't depend on other fields
+        record.reply_time = record.call_time + 50000 + (l & 0xffff) + ((l >> 60) == 0 ? (l >> 16) & 0xffffff : 0);
+        record.session    = 0x9e3779b97f4a7c15ULL * ((r >> 16) % sessions + 1);
+        record.procedure  = procedures[(r >> 32) & 0xf];
+        record.status     = ((r >> 36) & 0xff) == 0 ? 2 /*NFS3ERR_NOENT*/ : 0;
+        record.id         = i;
+        record.fh         = 0xc2b2ae3d27d4eb4fULL * ((r >> 40) & 0xfff);
+        record.count      = record.procedure == ProcEnumNFS3::READ || record.procedure == ProcEnumNFS3::WRITE ? 65536 : 0;
+        record.offset     = record.count ? ((r >> 20) & 0xffff) * 65536 : 0;
+        record.call_size  = 128 + (record.procedure == ProcEnumNFS3::WRITE ? record.count : 0);
+        record.reply_size = 112 + (record.procedure == ProcEnumNFS3::READ ? record.count : 0);
+        writer.append(record);
+
+        if((i + 1) % 100000000 == 0)
+        {
+            std::cerr << "generated " << (i + 1) << " rows" << std::endl;
+        }
+    }
+}
+
+void measure(const char* title, const ColumnsReader& reader, const Query& query)
+{
+    const auto   start = Clock::now();
+    const Result result{run(reader, query)};
+    const double seconds{std::chrono::duration<double>(Clock::now() - start).count()};
+
+    uint64_t selected{0};
+    for(const Aggregate& a : result.groups)
+    {
+        selected += a.count;
+    }
+    std::cout << title << " threads: " << query.threads
+              << " selected: " << selected
+              << " skipped blocks: " << result.skipped << '/' << result.blocks
+              << " time: " << seconds << " s"
+              << " rate: " << reader.rows() / seconds / 1e6 << " Mrows/s" << std::endl;
+}
+
+} // namespace
+
+/*! Usage: nfstrace-query-benchmark DIRECTORY [ROWS]
+ * Export of ROWS (2 billions by default) synthetic operations is generated
+ * if DIRECTORY has no export yet, then queries are measured over it.
+ */
+int main(int argc, char** argv)
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: nfstrace-query-benchmark DIRECTORY [ROWS]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string directory{argv[1]};
+    const uint64_t    rows{argc == 3 ? std::strtoull(argv[2], nullptr, 10) : 2000000000ULL};
+
+    try
+    {
+        struct stat st;
+        if(stat((directory + "/columns.meta").c_str(), &st) != 0)
+        {
+            const auto start = Clock::now();
+            generate(directory, rows);
+            std::cout << "generation of " << rows << " rows: "
+                      << std::chrono::duration<double>(Clock::now() - start).count() << " s" << std::endl;
+        }
+
+        const ColumnsReader reader{directory};
+        const unsigned      all{std::max(1U, std::thread::hardware_concurrency())};
+        const uint64_t      begin{reader.index(Column::CallTime, 0).min};
+        const uint64_t      end{reader.index(Column::CallTime, reader.blocks() - 1).max};
+
+        for(unsigned threads : {1U, all})
+        {
+            Query query;
+            query.threads = threads;
+            measure("count of all rows:", reader, query);
+
+            Query range{query};
+            range.time.min = begin + (end - begin) / 2;
+            range.time.max = range.time.min + (end - begin) / 10;
+            measure("10% of time range:", reader, range);
+
+            Query errors{query};
+            errors.status.min = 1;
+            errors.group      = Group::Procedure;
+            measure("errors by procedure:", reader, errors);
+
+            Query reads{query};
+            reads.procedures.resize(reader.procedures().size() + 1, 0);
+            for(std::size_t i = 0; i < reader.procedures().size(); ++i)
+            {
+                reads.procedures[i] = reader.procedures()[i].name == "READ";
+            }
+            reads.group = Group::Session;
+            measure("READ by session:", reader, reads);
+        }
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << "nfstrace-query-benchmark: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+//------------------------------------------------------------------------------
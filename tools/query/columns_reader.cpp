@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Reader of columnar export of operation records
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "columns_reader.h"
+//------------------------------------------------------------------------------
+namespace columns
+{
+ColumnsReader::ColumnsReader(const std::string& d)
+    : directory{d}
+{
+    for(int& fd : files)
+    {
+        fd = -1;
+    }
+
+    std::ifstream meta{directory + "/columns.meta"};
+    if(!meta)
+    {
+        throw std::runtime_error{"Columns aren't found in: " + directory};
+    }
+    std::string key;
+    uint64_t    value;
+    while(meta >> key >> value)
+    {
+        if(key == "version" && value != version)
+        {
+            throw std::runtime_error{"Unsupported version of columns: " + std::to_string(value)};
+        }
+        if(key == "blocks") block_count = value;
+        if(key == "rows") row_count = value;
+    }
+
+    for(unsigned i = 0; i < Column::count; ++i)
+    {
+        const std::string path{directory + '/' + name(Column(i))};
+        files[i] = open((path + ".col").c_str(), O_RDONLY);
+        if(files[i] < 0)
+        {
+            throw std::system_error{errno, std::system_category(), {"Error in opening column: " + path}};
+        }
+
+        // index may have blocks written after meta, they are ignored
+        std::ifstream index{path + ".idx", std::ios::binary};
+        indexes[i].resize(block_count);
+        if(!index.read(reinterpret_cast<char*>(indexes[i].data()), block_count * sizeof(BlockIndex)))
+        {
+            throw std::runtime_error{"Index of column is truncated: " + path};
+        }
+    }
+
+    std::ifstream dict{directory + "/sessions.dict", std::ios::binary};
+    uint64_t      hash;
+    while(dict.read(reinterpret_cast<char*>(&hash), sizeof(hash)))
+    {
+        session_hashes.push_back(hash);
+    }
+
+    std::ifstream names{directory + "/procedures.dict"};
+    std::size_t   index;
+    Procedure     p;
+    while(names >> index >> p.protocol >> p.procedure && std::getline(names >> std::ws, p.name))
+    {
+        procedure_names.push_back(p);
+    }
+}
+
+ColumnsReader::~ColumnsReader()
+{
+    for(int fd : files)
+    {
+        if(fd >= 0) close(fd);
+    }
+}
+
+void ColumnsReader::decode(Column column, uint32_t block, std::vector<uint64_t>& values, std::vector<uint8_t>& buffer) const
+{
+    const BlockIndex& index = indexes[column][block];
+
+    buffer.resize(std::size_t{index.size} + index.raw);
+    uint8_t* const compressed{buffer.data()};
+    uint8_t* const raw{buffer.data() + index.size};
+    if(pread(files[column], compressed, index.size, index.offset) != ssize_t(index.size))
+    {
+        throw std::runtime_error{std::string{"Error in reading block of column: "} + name(column)};
+    }
+    uLongf size{index.raw};
+    if(uncompress(raw, &size, compressed, index.size) != Z_OK || size != index.raw)
+    {
+        throw std::runtime_error{std::string{"Corrupted block of column: "} + name(column)};
+    }
+
+    values.resize(index.rows);
+    const uint8_t*       it{raw};
+    const uint8_t* const end{raw + index.raw};
+    if(column == Column::FileHandle)
+    {
+        if(index.raw != index.rows * sizeof(uint64_t))
+        {
+            throw std::runtime_error{"Corrupted block of column: fh"};
+        }
+        for(uint64_t& v : values)
+        {
+            v = 0;
+            for(unsigned i = 0; i < sizeof(v); ++i)
+            {
+                v |= uint64_t{*it++} << (i * 8);
+            }
+        }
+        return;
+    }
+
+    for(uint64_t& v : values)
+    {
+        if(!(it = get_varint(it, end, v)))
+        {
+            throw std::runtime_error{std::string{"Corrupted block of column: "} + name(column)};
+        }
+    }
+    if(column == Column::CallTime)
+    {
+        uint64_t time{0};
+        for(uint64_t& v : values)
+        {
+            time += unzigzag(v);
+            v = time;
+        }
+    }
+}
+
+} // namespace columns
+//------------------------------------------------------------------------------
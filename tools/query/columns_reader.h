@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Reader of columnar export of operation records
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef COLUMNS_READER_H
+#define COLUMNS_READER_H
+//------------------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "columns_format.h"
+//------------------------------------------------------------------------------
+namespace columns
+{
+/*! Opens export written by libcolumns.so and decodes its blocks.
+ * Blocks are read by pread(), so several threads may decode them concurrently.
+ */
+class ColumnsReader
+{
+public:
+    //! Entry of procedures.dict
+    struct Procedure
+    {
+        unsigned    protocol;
+        uint32_t    procedure;
+        std::string name;
+    };
+
+    explicit ColumnsReader(const std::string& directory);
+    ~ColumnsReader();
+    ColumnsReader(const ColumnsReader&) = delete;
+    ColumnsReader& operator=(const ColumnsReader&) = delete;
+
+    uint32_t blocks() const { return block_count; }
+    uint64_t rows() const { return row_count; }
+
+    const BlockIndex& index(Column column, uint32_t block) const { return indexes[column][block]; }
+
+    /*! Decodes values of column in block
+     * \param values - decoded values, call times are absolute
+     * \param buffer - temporary storage for compressed and encoded data
+     */
+    void decode(Column column, uint32_t block, std::vector<uint64_t>& values, std::vector<uint8_t>& buffer) const;
+
+    const std::vector<uint64_t>&  sessions() const { return session_hashes; }
+    const std::vector<Procedure>& procedures() const { return procedure_names; }
+private:
+    const std::string       directory;
+    uint32_t                block_count{0};
+    uint64_t                row_count{0};
+    int                     files[Column::count];
+    std::vector<BlockIndex> indexes[Column::count];
+    std::vector<uint64_t>   session_hashes;
+    std::vector<Procedure>  procedure_names;
+};
+
+} // namespace columns
+//------------------------------------------------------------------------------
+#endif // COLUMNS_READER_H
+//------------------------------------------------------------------------------
@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Command line tool for queries over exported operation columns
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <getopt.h>
+
+#include <api/header_event.h>
+
+#include "columns_reader.h"
+#include "query.h"
+//------------------------------------------------------------------------------
+using namespace columns;
+//------------------------------------------------------------------------------
+static const char* usage =
+    "Usage: nfstrace-query [OPTIONS] DIRECTORY\n"
+    "Filters and aggregates operations exported by libcolumns.so\n"
+    "  --from=SECONDS         skip calls before the time since Epoch, fraction is allowed\n"
+    "  --to=SECONDS           skip calls after the time since Epoch, fraction is allowed\n"
+    "  --session=HASH         select session by its hexadecimal hash, may be repeated\n"
+    "  --procedure=NAME       select procedure or command by its name, may be repeated\n"
+    "  --status=N             select replies with the status\n"
+    "  --group=session|procedure\n"
+    "                         aggregate groups separately\n"
+    "  --threads=N            amount of threads, all CPUs by default\n"
+    "  --help                 print this help\n";
+
+static const char* protocol_name(unsigned protocol)
+{
+    switch(static_cast<NST::API::Protocol>(protocol))
+    {
+    case NST::API::Protocol::NFSv3:
+        return "NFSv3";
+    case NST::API::Protocol::NFSv40:
+        return "NFSv4.0";
+    case NST::API::Protocol::NFSv41:
+        return "NFSv4.1";
+    case NST::API::Protocol::SMBv1:
+        return "SMBv1";
+    case NST::API::Protocol::SMBv2:
+        return "SMBv2";
+    }
+    return "UNKNOWN";
+}
+
+static uint64_t to_nanoseconds(const char* seconds)
+{
+    char*        end;
+    const double value{std::strtod(seconds, &end)};
+    if(*end || value < 0)
+    {
+        throw std::invalid_argument{std::string{"Invalid time: "} + seconds};
+    }
+    return uint64_t(value * 1e9);
+}
+
+static uint64_t to_number(const char* value, int base = 10)
+{
+    char*                    end;
+    const unsigned long long number{std::strtoull(value, &end, base)};
+    if(*end || !*value)
+    {
+        throw std::invalid_argument{std::string{"Invalid number: "} + value};
+    }
+    return number;
+}
+
+static void select_session(Query& query, const ColumnsReader& reader, const char* value)
+{
+    const uint64_t hash{to_number(value, 16)};
+    const auto&    sessions = reader.sessions();
+    query.sessions.resize(sessions.size() + 1, 0); // last item is never selected, so the set isn't empty
+    for(std::size_t i = 0; i < sessions.size(); ++i)
+    {
+        if(sessions[i] == hash)
+        {
+            query.sessions[i] = 1;
+        }
+    }
+}
+
+static void select_procedure(Query& query, const ColumnsReader& reader, const char* value)
+{
+    const auto& procedures = reader.procedures();
+    query.procedures.resize(procedures.size() + 1, 0);
+    for(std::size_t i = 0; i < procedures.size(); ++i)
+    {
+        if(strcasecmp(procedures[i].name.c_str(), value) == 0)
+        {
+            query.procedures[i] = 1;
+        }
+    }
+}
+
+static void print(const ColumnsReader& reader, const Query& query, const Result& result)
+{
+    std::cout << std::left << std::setw(24) << "group" << std::right
+              << std::setw(14) << "count" << std::setw(18) << "bytes"
+              << std::setw(12) << "p50(us)" << std::setw(12) << "p90(us)"
+              << std::setw(12) << "p99(us)" << std::setw(12) << "p99.9(us)"
+              << std::setw(12) << "max(us)" << '\n';
+
+    std::cout << std::fixed << std::setprecision(1);
+    for(std::size_t i = 0; i < result.groups.size(); ++i)
+    {
+        const Aggregate& a = result.groups[i];
+        if(a.count == 0 && query.group != Group::None)
+        {
+            continue;
+        }
+        std::cout << std::left << std::setw(24);
+        switch(query.group)
+        {
+        case Group::None:
+            std::cout << "all";
+            break;
+        case Group::Session:
+            std::cout << std::hex << reader.sessions()[i] << std::dec;
+            break;
+        case Group::Procedure:
+            std::cout << std::string{protocol_name(reader.procedures()[i].protocol)} + ' ' + reader.procedures()[i].name;
+            break;
+        }
+        std::cout << std::right << std::setw(14) << a.count << std::setw(18) << a.bytes;
+        for(double p : {50.0, 90.0, 99.0, 99.9})
+        {
+            std::cout << std::setw(12) << a.latency.percentile(p) / 1e3;
+        }
+        std::cout << std::setw(12) << a.latency.max() / 1e3 << '\n';
+    }
+    std::cerr << "blocks: " << result.blocks << ", skipped by index: " << result.skipped << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    enum : int
+    {
+        From = 1,
+        To,
+        Session,
+        Procedure,
+        Status,
+        GroupBy,
+        Threads,
+        Help
+    };
+    static const option options[] = {
+        {"from", required_argument, nullptr, From},
+        {"to", required_argument, nullptr, To},
+        {"session", required_argument, nullptr, Session},
+        {"procedure", required_argument, nullptr, Procedure},
+        {"status", required_argument, nullptr, Status},
+        {"group", required_argument, nullptr, GroupBy},
+        {"threads", required_argument, nullptr, Threads},
+        {"help", no_argument, nullptr, Help},
+        {nullptr, 0, nullptr, 0}};
+
+    try
+    {
+        // selections refer to dictionaries, so they are applied after the export is opened
+        std::vector<std::pair<int, const char*>> selections;
+
+        Query query;
+        query.threads = std::thread::hardware_concurrency();
+        for(int opt; (opt = getopt_long(argc, argv, "", options, nullptr)) != -1;)
+        {
+            switch(opt)
+            {
+            case From:
+                query.time.min = to_nanoseconds(optarg);
+                break;
+            case To:
+                query.time.max = to_nanoseconds(optarg);
+                break;
+            case Session:
+            case Procedure:
+                selections.emplace_back(opt, optarg);
+                break;
+            case Status:
+                query.status.min = query.status.max = to_number(optarg);
+                break;
+            case GroupBy:
+                if(std::strcmp(optarg, "session") == 0)
+                    query.group = Group::Session;
+                else if(std::strcmp(optarg, "procedure") == 0)
+                    query.group = Group::Procedure;
+                else
+                    throw std::invalid_argument{std::string{"Invalid group: "} + optarg};
+                break;
+            case Threads:
+                query.threads = to_number(optarg);
+                break;
+            case Help:
+                std::cout << usage;
+                return EXIT_SUCCESS;
+            default:
+                std::cerr << usage;
+                return EXIT_FAILURE;
+            }
+        }
+        if(optind + 1 != argc)
+        {
+            std::cerr << usage;
+            return EXIT_FAILURE;
+        }
+
+        const ColumnsReader reader{argv[optind]};
+        for(const auto& s : selections)
+        {
+            if(s.first == Session)
+                select_session(query, reader, s.second);
+            else
+                select_procedure(query, reader, s.second);
+        }
+        print(reader, query, run(reader, query));
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << "nfstrace-query: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,289 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Filtering and aggregation over exported operation columns
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "query.h"
+//------------------------------------------------------------------------------
+namespace columns
+{
+namespace
+{
+// predicates set mask of selected rows, they are written without branches
+inline void select_range(uint8_t* __restrict mask, const uint64_t* __restrict values, std::size_t size, const Range& range)
+{
+    const uint64_t min{range.min};
+    const uint64_t max{range.max};
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        mask[i] &= uint8_t(values[i] >= min) & uint8_t(values[i] <= max);
+    }
+}
+
+inline void select_set(uint8_t* __restrict mask, const uint64_t* __restrict values, std::size_t size, const std::vector<uint8_t>& set)
+{
+    const uint8_t* selected{set.data()};
+    const uint64_t limit{set.size()};
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        const uint64_t v{values[i] < limit ? values[i] : 0};
+        mask[i] &= uint8_t(values[i] < limit) & selected[v];
+    }
+}
+
+//! Checks that set has selected item in range of block
+inline bool overlaps(const std::vector<uint8_t>& set, const BlockIndex& index)
+{
+    if(index.min >= set.size()) return false;
+    const auto end = set.begin() + std::min<uint64_t>(index.max + 1, set.size());
+    return std::find(set.begin() + index.min, end, 1) != end;
+}
+
+class Worker
+{
+public:
+    Worker(const ColumnsReader& r, const Query& q, std::size_t groups)
+        : reader(r)
+        , query(q)
+        , aggregates(groups)
+    {
+    }
+
+    //! Evaluates query for block, returns false if it was skipped
+    bool process(uint32_t block)
+    {
+        if(!matches(block))
+        {
+            return false;
+        }
+
+        const uint32_t rows{reader.index(Column::CallTime, block).rows};
+        mask.assign(rows, 1);
+        if(!query.time.all())
+        {
+            select_range(mask.data(), decode(Column::CallTime, block), rows, query.time);
+        }
+        if(!query.status.all())
+        {
+            select_range(mask.data(), decode(Column::Status, block), rows, query.status);
+        }
+        if(!query.sessions.empty())
+        {
+            select_set(mask.data(), decode(Column::Session, block), rows, query.sessions);
+        }
+        if(!query.procedures.empty())
+        {
+            select_set(mask.data(), decode(Column::Procedure, block), rows, query.procedures);
+        }
+        if(std::find(mask.begin(), mask.end(), 1) == mask.end())
+        {
+            return true;
+        }
+
+        const uint64_t* keys{nullptr};
+        switch(query.group)
+        {
+        case Group::None:
+            break;
+        case Group::Session:
+            keys = decode(Column::Session, block);
+            break;
+        case Group::Procedure:
+            keys = decode(Column::Procedure, block);
+            break;
+        }
+        const uint64_t* latency{decode(Column::Latency, block)};
+        const uint64_t* call{decode(Column::CallSize, block)};
+        const uint64_t* reply{decode(Column::ReplySize, block)};
+
+        for(uint32_t i = 0; i < rows; ++i)
+        {
+            if(mask[i])
+            {
+                Aggregate& a = aggregates[keys ? keys[i] : 0];
+                ++a.count;
+                a.bytes += call[i] + reply[i];
+                a.latency.add(latency[i]);
+            }
+        }
+        return true;
+    }
+
+    std::vector<Aggregate>& result() { return aggregates; }
+private:
+    //! Checks min and max of block against predicates
+    bool matches(uint32_t block) const
+    {
+        return (query.time.all() || query.time.overlaps(reader.index(Column::CallTime, block))) &&
+               (query.status.all() || query.status.overlaps(reader.index(Column::Status, block))) &&
+               (query.sessions.empty() || overlaps(query.sessions, reader.index(Column::Session, block))) &&
+               (query.procedures.empty() || overlaps(query.procedures, reader.index(Column::Procedure, block)));
+    }
+
+    //! Decodes column of block once
+    const uint64_t* decode(Column column, uint32_t block)
+    {
+        if(decoded[column] != block + 1)
+        {
+            if(((column == Column::Session && query.group == Group::Session) ||
+                (column == Column::Procedure && query.group == Group::Procedure)) &&
+               reader.index(column, block).max >= aggregates.size())
+            {
+                throw std::runtime_error{std::string{"Index of dictionary is out of range in column: "} + name(column)};
+            }
+            reader.decode(column, block, values[column], buffer);
+            decoded[column] = block + 1;
+        }
+        return values[column].data();
+    }
+
+    const ColumnsReader&   reader;
+    const Query&           query;
+    std::vector<Aggregate> aggregates;
+
+    std::vector<uint8_t>  mask;
+    std::vector<uint64_t> values[Column::count];
+    uint64_t              decoded[Column::count]{}; // block + 1 of decoded values
+    std::vector<uint8_t>  buffer;
+};
+
+} // namespace
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    if(other.counts.empty())
+    {
+        return;
+    }
+    counts.resize(buckets, 0);
+    for(unsigned i = 0; i < buckets; ++i)
+    {
+        counts[i] += other.counts[i];
+    }
+    maximum = std::max(maximum, other.maximum);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const
+{
+    uint64_t total{0};
+    for(uint64_t c : counts)
+    {
+        total += c;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, std::min<uint64_t>(total, total * p / 100.0 + 0.5));
+    uint64_t       passed{0};
+    for(unsigned i = 0; i < counts.size(); ++i)
+    {
+        passed += counts[i];
+        if(passed >= rank)
+        {
+            return std::min(lower_bound(i), maximum);
+        }
+    }
+    return maximum;
+}
+
+void Aggregate::merge(const Aggregate& other)
+{
+    count += other.count;
+    bytes += other.bytes;
+    latency.merge(other.latency);
+}
+
+Result run(const ColumnsReader& reader, const Query& query)
+{
+    std::size_t groups{1};
+    switch(query.group)
+    {
+    case Group::None:
+        break;
+    case Group::Session:
+        groups = std::max<std::size_t>(1, reader.sessions().size());
+        break;
+    case Group::Procedure:
+        groups = std::max<std::size_t>(1, reader.procedures().size());
+        break;
+    }
+
+    const unsigned           threads{std::max(1U, std::min(query.threads, reader.blocks()))};
+    std::atomic<uint32_t>    next{0};
+    std::atomic<uint32_t>    skipped{0};
+    std::vector<Worker>      workers(threads, Worker{reader, query, groups});
+    std::exception_ptr       error;
+    std::atomic_flag         failed = ATOMIC_FLAG_INIT;
+    std::vector<std::thread> pool;
+
+    auto work = [&](Worker& worker) {
+        try
+        {
+            for(uint32_t block; (block = next++) < reader.blocks();)
+            {
+                if(!worker.process(block))
+                {
+                    ++skipped;
+                }
+            }
+        }
+        catch(...)
+        {
+            if(!failed.test_and_set())
+            {
+                error = std::current_exception();
+            }
+            next = reader.blocks(); // stop others
+        }
+    };
+
+    for(unsigned i = 1; i < threads; ++i)
+    {
+        pool.emplace_back(work, std::ref(workers[i]));
+    }
+    work(workers[0]);
+    for(auto& t : pool)
+    {
+        t.join();
+    }
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    Result result;
+    result.groups.swap(workers[0].result());
+    for(unsigned i = 1; i < threads; ++i)
+    {
+        for(std::size_t g = 0; g < groups; ++g)
+        {
+            result.groups[g].merge(workers[i].result()[g]);
+        }
+    }
+    result.blocks  = reader.blocks();
+    result.skipped = skipped;
+    return result;
+}
+
+} // namespace columns
+//------------------------------------------------------------------------------
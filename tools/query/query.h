@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Filtering and aggregation over exported operation columns
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+#ifndef QUERY_H
+#define QUERY_H
+//------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+#include "columns_reader.h"
+//------------------------------------------------------------------------------
+namespace columns
+{
+/*! Log-linear histogram of latencies in nanoseconds.
+ * Values below 32 are exact, others are split to 32 buckets per power of 2,
+ * so relative error of percentiles is below 3%.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned sub_bits{5};
+    static constexpr unsigned buckets{(64 - sub_bits + 1) << sub_bits};
+
+    inline void add(uint64_t value)
+    {
+        if(counts.empty()) // most groups are empty if rows are grouped by sessions
+        {
+            counts.resize(buckets, 0);
+        }
+        ++counts[bucket(value)];
+        if(value > maximum) maximum = value;
+    }
+
+    void merge(const LatencyHistogram& other);
+
+    //! Lower bound of bucket containing percentile (0 < p <= 100)
+    uint64_t percentile(double p) const;
+    uint64_t max() const { return maximum; }
+
+    static inline unsigned bucket(uint64_t value)
+    {
+        if(value < (1U << sub_bits))
+        {
+            return value;
+        }
+        const unsigned exponent = 63 - __builtin_clzll(value); // >= sub_bits
+        const unsigned shift    = exponent - sub_bits;
+        return ((shift + 1) << sub_bits) + ((value >> shift) & ((1U << sub_bits) - 1));
+    }
+
+    static inline uint64_t lower_bound(unsigned bucket)
+    {
+        if(bucket < (1U << sub_bits))
+        {
+            return bucket;
+        }
+        const unsigned shift = (bucket >> sub_bits) - 1;
+        return (uint64_t{(1U << sub_bits) | (bucket & ((1U << sub_bits) - 1))}) << shift;
+    }
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t              maximum{0};
+};
+
+//! Inclusive range of values, rows outside of it are filtered out
+struct Range
+{
+    uint64_t min{0};
+    uint64_t max{UINT64_MAX};
+
+    bool all() const { return min == 0 && max == UINT64_MAX; }
+    bool overlaps(const BlockIndex& index) const { return index.min <= max && min <= index.max; }
+};
+
+enum class Group
+{
+    None,
+    Session,  //!< Groups are indexes in sessions.dict
+    Procedure //!< Groups are indexes in procedures.dict
+};
+
+struct Query
+{
+    Range                time;       //!< Call time in nanoseconds since Epoch
+    Range                status;     //!< Status of reply
+    std::vector<uint8_t> sessions;   //!< Selected indexes of sessions.dict, empty if all of them
+    std::vector<uint8_t> procedures; //!< Selected indexes of procedures.dict, empty if all of them
+    Group                group{Group::None};
+    unsigned             threads{1};
+};
+
+//! Aggregates of selected rows of one group
+struct Aggregate
+{
+    uint64_t         count{0};
+    uint64_t         bytes{0}; //!< Sum of sizes of calls and replies
+    LatencyHistogram latency;
+
+    void merge(const Aggregate& other);
+};
+
+struct Result
+{
+    std::vector<Aggregate> groups; //!< Indexed by group, single item if Group::None
+    uint32_t               blocks{0};
+    uint32_t               skipped{0}; //!< Blocks skipped by their min and max
+};
+
+/*! Runs query over all blocks of export.
+ * Blocks are distributed among threads of query, each of them decodes only
+ * columns which are used by the query and evaluates predicates for whole
+ * block by loops without branches, which are vectorized by compiler.
+ */
+Result run(const ColumnsReader& reader, const Query& query);
+
+} // namespace columns
+//------------------------------------------------------------------------------
+#endif // QUERY_H
+//------------------------------------------------------------------------------
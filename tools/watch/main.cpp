@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Viewer of counters published by libwatch.so into shared memory
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+#include <signal.h>
+
+#include <api/watch_segment.h>
+
+#include "segment_protocol.h"
+#include "user_gui.h"
+//------------------------------------------------------------------------------
+using NST::API::WatchSegmentReader;
+//------------------------------------------------------------------------------
+static const char* usage =
+    "Usage: nfstrace-watch [OPTIONS] SEGMENT\n"
+    "Shows counters published by nfstrace -a libwatch.so#segment=SEGMENT\n"
+    "  --refresh=MS           timeout of screen update, interval of publishing by default\n"
+    "  --help                 print this help\n";
+
+static unsigned long to_number(const char* value)
+{
+    char*               end;
+    const unsigned long number{std::strtoul(value, &end, 10)};
+    if(*end || number == 0)
+    {
+        throw std::invalid_argument{std::string{"Invalid number: "} + value};
+    }
+    return number;
+}
+
+int main(int argc, char** argv)
+{
+    enum : int
+    {
+        Refresh = 1,
+        Help
+    };
+    static const option options[] = {
+        {"refresh", required_argument, nullptr, Refresh},
+        {"help", no_argument, nullptr, Help},
+        {nullptr, 0, nullptr, 0}};
+
+    try
+    {
+        unsigned long refreshMs{0};
+        for(int opt; (opt = getopt_long(argc, argv, "", options, nullptr)) != -1;)
+        {
+            switch(opt)
+            {
+            case Refresh:
+                refreshMs = to_number(optarg);
+                break;
+            case Help:
+                std::cout << usage;
+                return EXIT_SUCCESS;
+            default:
+                std::cerr << usage;
+                return EXIT_FAILURE;
+            }
+        }
+        if(optind + 1 != argc)
+        {
+            std::cerr << usage;
+            return EXIT_FAILURE;
+        }
+
+        const WatchSegmentReader reader{argv[optind]};
+
+        std::vector<std::unique_ptr<SegmentProtocol>> segmentProtocols;
+        std::vector<AbstractProtocol*>                protocols;
+        for(std::size_t i = 0; i < reader.protocols(); ++i)
+        {
+            segmentProtocols.emplace_back(new SegmentProtocol{reader, i});
+            protocols.push_back(segmentProtocols.back().get());
+        }
+        if(refreshMs == 0)
+        {
+            refreshMs = reader.refresh_ms();
+        }
+
+        // signals are handled by this thread, GUI thread inherits the mask
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        sigaddset(&signals, SIGWINCH);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+        bool stopped{false};
+        {
+            std::vector<uint64_t> values; // counters of all protocols, they are read by GUI thread
+            std::atomic<bool>     dead{false}; // the writer has died in the middle of publishing
+            auto                  source = [&reader, &values, &dead](AbstractProtocol* p, UserGUI::ProtocolStatistic& statistic) {
+                bool stale{false};
+                reader.read(values, stale);
+                if(stale)
+                {
+                    dead = true;
+                }
+                const auto first = values.begin() + static_cast<SegmentProtocol*>(p)->first();
+                statistic.assign(first, first + p->getAmount());
+            };
+            UserGUI gui{refreshMs * 1000, protocols, source}; // GUI timeout is in microseconds
+
+            const timespec timeout{1, 0};
+            for(;;)
+            {
+                const int signo{sigtimedwait(&signals, nullptr, &timeout)};
+                if(signo == SIGWINCH)
+                {
+                    gui.enableUpdate();
+                }
+                else if(signo == SIGINT || signo == SIGTERM)
+                {
+                    break;
+                }
+                else if(!reader.running() || dead)
+                {
+                    stopped = true;
+                    break;
+                }
+            }
+        }
+        if(stopped)
+        {
+            std::cerr << "nfstrace-watch: nfstrace has stopped publishing " << argv[optind] << std::endl;
+        }
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << "nfstrace-watch: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+//------------------------------------------------------------------------------
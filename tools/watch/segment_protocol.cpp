@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Protocol of libwatch.so described by its shared memory segment
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include "segment_protocol.h"
+//------------------------------------------------------------------------------
+SegmentProtocol::SegmentProtocol(const NST::API::WatchSegmentReader& r, std::size_t index)
+    : AbstractProtocol{r.protocol(index).name, r.protocol(index).amount}
+    , reader(r)
+    , descriptor(r.protocol(index))
+{
+}
+
+const char* SegmentProtocol::printProcedure(std::size_t i)
+{
+    if(i >= descriptor.amount)
+    {
+        return nullptr;
+    }
+    const char* name = reader.counter_name(descriptor.first + i);
+    return *name ? name : nullptr;
+}
+
+std::size_t SegmentProtocol::getGroups()
+{
+    return descriptor.groups;
+}
+
+std::size_t SegmentProtocol::getGroupBegin(std::size_t i)
+{
+    if(i >= 1 && i <= descriptor.groups)
+    {
+        return descriptor.group_begins[i - 1];
+    }
+    return descriptor.amount;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+// Author: agent
+// Description: Protocol of libwatch.so described by its shared memory segment
+// Copyright (c) 2026 agent
+//------------------------------------------------------------------------------
+/*
+    This file is part of Nfstrace.
+
+    Nfstrace is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 2 of the License.
+
+    Nfstrace is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Nfstrace.  If not, see <http://www.gnu.org/licenses/>.
+*/
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef SEGMENT_PROTOCOL_H
+#define SEGMENT_PROTOCOL_H
+//------------------------------------------------------------------------------
+#include <cstddef>
+
+#include <api/watch_segment.h>
+
+#include "protocols/abstract_protocol.h"
+//------------------------------------------------------------------------------
+//! Names and groups of counters are taken from the segment, not from nfstrace
+class SegmentProtocol : public AbstractProtocol
+{
+public:
+    SegmentProtocol(const NST::API::WatchSegmentReader& reader, std::size_t index);
+
+    const char* printProcedure(std::size_t) override;
+    std::size_t getGroups() override;
+    std::size_t getGroupBegin(std::size_t) override;
+
+    //! Index of the first counter of protocol in the segment
+    std::size_t first() const { return descriptor.first; }
+
+private:
+    const NST::API::WatchSegmentReader&   reader;
+    const NST::API::WatchSegmentProtocol& descriptor;
+};
+//------------------------------------------------------------------------------
+#endif //SEGMENT_PROTOCOL_H
+//------------------------------------------------------------------------------